@@ -1,6 +1,18 @@
 #ifndef ASW_CONFIG_H
 #define ASW_CONFIG_H
 
+/* Interrupt priorities (1 ~ 255, must be unique per CPU) */
+#define ISR_PRIORITY_I2C0_DTR           12                                              /* FIFO requests, served before the protocol end of a transfer */
+#define ISR_PRIORITY_I2C0_P             11
+#define ISR_PRIORITY_I2C0_ERR           10
+#define ISR_PRIORITY_I2C0_RETRY         9                                               /* STM0 comparator 1, I2C retry backoff */
+#define ISR_PRIORITY_SSD1306_FRAME      8                                               /* STM0 comparator 0, SSD1306 frame period */
 
+/* DMA channels (the service request priority selects the channel) */
+#define DMA_CHANNEL_I2C0_TX             1                                               /* SSD1306 frame data */
+
+/* SSD1306 panels on I2C0, first SSD1306_PANEL_LEN entries of SSD1306_PanelConfig (2: 128x32 panel with SA0 = 0 added) */
+#define SSD1306_PANEL_LEN               1
+#define SSD1306_FRAME_PERIOD_US         20000                                           /* SSD1306_Governor: 50 frames per second at most */
 
 #endif
\ No newline at end of file
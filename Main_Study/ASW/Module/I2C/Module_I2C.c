@@ -1,38 +1,1277 @@
 #include "Module_I2C.h"
+#include "IfxCpu_Irq.h"
+#include "IfxStm.h"
+#include "_Utilities/Ifx_Assert.h"
+#include "ASW/ASW_CONFIG.h"
+
+typedef struct _Module_I2C_Wait {
+    volatile boolean bDone;
+    IfxI2c_I2c_Status status;
+} Module_I2C_Wait;
+
+static Module_I2C_Bus module_i2c_bus[IFXI2C_NUM_MODULES];
+IFX_ALIGN(256) static Ifx_DMA_CH module_i2c_dmaList[IFXI2C_NUM_MODULES][MODULE_I2C_DMA_LIST_LEN];  /* DMA reads linked list entries from aligned addresses */
+
+static IfxI2c_I2c_Status _Transfer(Module_I2C_Inst *inst, Module_I2C_Transaction *trans);
+static IfxI2c_I2c_Status _Polling(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans);
+static IfxI2c_I2c_Status _PollingOnce(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans);
+static IfxI2c_I2c_Status _PollingWrite(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size);
+static IfxI2c_I2c_Status _PollingRead(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size);
+static IfxI2c_I2c_Status _SendMasterCode(Module_I2C_Inst *inst);
+static void _BeginSession(Module_I2C_Bus *bus);
+static void _EndSession(Module_I2C_Bus *bus);
+static void _SetHighSpeed(Module_I2C_Bus *bus, boolean bHighSpeed);
+static boolean _CheckRetry(Module_I2C_Inst *inst, IfxI2c_I2c_Status status, uint8 *attempt, uint8 *faults, boolean *bRecover);
+static uint32 _GetBackoffTicks(const Module_I2C_RetryPolicy *policy, uint8 attempt);
+static void _BeginRecovery(Module_I2C_Inst *inst);
+static boolean _StepRecovery(Module_I2C_Inst *inst);
+/* Take SCL / SDA from the I2C module as open drain GPIO, both released. The first step follows after a half period */
+static void _BeginRecovery(Module_I2C_Inst *inst)
+{
+    const IfxI2c_Pins *pins = &inst->bus->config->MCP_PINS;
+
+    IfxPort_setPinHigh(pins->scl->pin.port, pins->scl->pin.pinIndex);
+    IfxPort_setPinHigh(pins->sda->pin.port, pins->sda->pin.pinIndex);
+    IfxPort_setPinModeOutput(pins->scl->pin.port, pins->scl->pin.pinIndex, IfxPort_OutputMode_openDrain, IfxPort_OutputIdx_general);
+    IfxPort_setPinModeOutput(pins->sda->pin.port, pins->sda->pin.pinIndex, IfxPort_OutputMode_openDrain, IfxPort_OutputIdx_general);
+    inst->bus->recoverStep = 0;
+}
+
+/* One half period of the recovery, FALSE when the pins are back at the I2C module */
+static boolean _StepRecovery(Module_I2C_Inst *inst)
+{
+    const IfxI2c_Pins *pins = &inst->bus->config->MCP_PINS;
+    Ifx_P *sclPort = pins->scl->pin.port;
+    Ifx_P *sdaPort = pins->sda->pin.port;
+    const uint8 sclPin = pins->scl->pin.pinIndex;
+    const uint8 sdaPin = pins->sda->pin.pinIndex;
+    uint8 step = inst->bus->recoverStep++;
+
+    /* A slave in the middle of a byte releases SDA within 9 clocks: Low / high half periods while SDA is held */
+    if (step < (MODULE_I2C_RECOVERY_CLOCKS * 2) && (step & 1) == 0 && IfxPort_getPinState(sdaPort, sdaPin)) {
+        step = MODULE_I2C_RECOVERY_CLOCKS * 2;
+        inst->bus->recoverStep = step + 1;
+    }
+    if (step < (MODULE_I2C_RECOVERY_CLOCKS * 2)) {
+        if (step & 1) {
+            IfxPort_setPinHigh(sclPort, sclPin);
+        } else {
+            IfxPort_setPinLow(sclPort, sclPin);
+        }
+        return TRUE;
+    }
+
+    /* STOP: SDA rises while SCL is high */
+    switch (step - (MODULE_I2C_RECOVERY_CLOCKS * 2)) {
+    case 0:
+        IfxPort_setPinLow(sclPort, sclPin);
+        return TRUE;
+    case 1:
+        IfxPort_setPinLow(sdaPort, sdaPin);
+        return TRUE;
+    case 2:
+        IfxPort_setPinHigh(sclPort, sclPin);
+        return TRUE;
+    case 3:
+        IfxPort_setPinHigh(sdaPort, sdaPin);
+        return TRUE;
+    default:
+        break;
+    }
+
+    IfxI2c_initSclSdaPin(pins->scl, pins->sda, pins->padDriver);
+    inst->counters.recoveries++;
+    return FALSE;
+}
+
+static void _ArmBackoff(Module_I2C_Bus *bus, uint32 ticks);
+static void _WaitDone(IfxI2c_I2c_Status status, void *arg);
+static Module_I2C_Entry *_Pick(Module_I2C_Bus *bus);
+static void _StartNext(Module_I2C_Bus *bus);
+static void _PrepareWrite(Module_I2C_Bus *bus, Module_I2C_Entry *entry);
+static void _PrepareRead(Module_I2C_Bus *bus, volatile uint8 *data, Ifx_SizeT size);
+static void _Finish(Module_I2C_Bus *bus, IfxI2c_I2c_Status status);
+static void _RecordLatency(Module_I2C_Inst *inst, uint32 ticks);
+static uint32 _PackTxWord(Module_I2C_Bus *bus);
+static void _UnpackRxWord(Module_I2C_Bus *bus, uint32 packet);
+static void _StartDma(Module_I2C_Bus *bus, IfxCpu_Id cpuId, volatile uint8 *source, Ifx_SizeT size);
+static void _StopDma(Module_I2C_Bus *bus);
+
+IFX_INTERRUPT(I2c0_DtrIsr, 0, ISR_PRIORITY_I2C0_DTR);
+IFX_INTERRUPT(I2c0_ProtocolIsr, 0, ISR_PRIORITY_I2C0_P);
+IFX_INTERRUPT(I2c0_ErrorIsr, 0, ISR_PRIORITY_I2C0_ERR);
+IFX_INTERRUPT(I2c0_RetryIsr, 0, ISR_PRIORITY_I2C0_RETRY);
 
 void Init_I2C(Module_I2C_Inst *inst, const Module_I2C_Config *config)
 {
-    /* Initialize module */
-    IfxI2c_I2c_Config i2cConfig;                                    /* Create configuration structure               */
+    Module_I2C_Bus *bus = &module_i2c_bus[IfxI2c_getIndex(config->p_i2c)];
     IfxI2c_I2c_deviceConfig i2cDeviceConfig;                        /* Create device configuration                  */
-    IfxI2c_I2c_initConfig(&i2cConfig, config->p_i2c);               /* Fill structure with default values and Module
+
+    if (bus->bInit == FALSE) {
+        /* Initialize module */
+        IfxI2c_I2c_Config i2cConfig;                                /* Create configuration structure               */
+        IfxI2c_I2c_initConfig(&i2cConfig, config->p_i2c);           /* Fill structure with default values and Module
                                                                        address                                      */
 
-    i2cConfig.pins = &config->MCP_PINS;
-    i2cConfig.baudrate = config->baudrate;
-    IfxI2c_I2c_initModule(&inst->handle, &i2cConfig);               /* Initialize module */
+        i2cConfig.pins = &config->MCP_PINS;
+        i2cConfig.baudrate = config->baudrate;                      /* hsBaudrate only during I2c_runHighSpeed */
+        IfxI2c_I2c_initModule(&bus->handle, &i2cConfig);            /* Initialize module */
+
+        bus->config = config;
+        bus->cpu = IfxCpu_getCoreIndex();
+        for (int i = 0; i < Module_I2C_Priority_COUNT; i++) {
+            bus->queue[i].head = 0;
+            bus->queue[i].count = 0;
+        }
+        bus->served = 0;
+        bus->active = NULL_PTR;
+        bus->state = Module_I2C_State_IDLE;
+        bus->faults = 0;
+        bus->bRecover = FALSE;
+        bus->bAsync = FALSE;
+        bus->bHighSpeed = (config->hsBaudrate > 0) ? TRUE : FALSE;
+        bus->bDmaActive = FALSE;
+        bus->borrowed = NULL_PTR;
+        bus->dma.bEnabled = FALSE;
+        bus->latencyBase = IfxStm_getTicksFromMicroseconds(&MODULE_STM0, MODULE_I2C_LATENCY_BASE_US);
+        bus->recoverTicks = IfxStm_getTicksFromMicroseconds(&MODULE_STM0, MODULE_I2C_RECOVERY_HALF_US);
+        bus->bInit = TRUE;
+    }
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, bus->cpu == IfxCpu_getCoreIndex());     /* Queues are not locked against other cores */
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, config->retry.maxBackoffUs >= config->retry.backoffUs);
 
     /* Initialize device */
-    IfxI2c_I2c_initDeviceConfig(&i2cDeviceConfig, &inst->handle);   /* Fill structure with default values and I2C
+    IfxI2c_I2c_initDeviceConfig(&i2cDeviceConfig, &bus->handle);    /* Fill structure with default values and I2C
                                                                        Handler                                      */
 
     /* Because it is 7 bit long and bit 0 is R/W bit, the device address has to be shifted by 1 */
     i2cDeviceConfig.deviceAddress = config->addr << 1;
     IfxI2c_I2c_initDevice(&inst->dev, &i2cDeviceConfig);            /* Initialize the I2C device handle             */
+
+    inst->config = config;
+    inst->bus = bus;
+    inst->counters.naks = 0;
+    inst->counters.retries = 0;
+    inst->counters.recoveries = 0;
+    inst->counters.failures = 0;
+    I2c_resetLatency(inst);
+}
+
+void Init_I2C_Async(Module_I2C_Inst *inst)
+{
+    Module_I2C_Bus *bus = inst->bus;
+    Ifx_I2C *i2c = bus->handle.i2c;
+    const IfxSrc_Tos tos = IfxCpu_Irq_getTos(IfxCpu_getCoreIndex());
+
+    if (bus->bAsync) {
+        return;                             /* Another device on the bus did it */
+    }
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, bus->cpu == IfxCpu_getCoreIndex());
+    /* Only the I2C0 vectors and priorities exist (I2c0_*Isr): Other modules stay on the polling calls */
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, i2c == &MODULE_I2C0);
+    if (i2c != &MODULE_I2C0) {
+        return;
+    }
+    bus->tos = tos;
+
+    IfxI2c_clearAllDtrInterruptSources(i2c);
+    IfxI2c_clearAllProtocolInterruptSources(i2c);
+    IfxI2c_clearAllErrorInterruptSources(i2c);
+
+    /* Forward the FIFO requests and the collected protocol / error flags to the SRNs */
+    IfxI2c_enableDtrInterruptSource(i2c, IfxI2c_DtrInterruptSource_lastSingleRequest);
+    IfxI2c_enableDtrInterruptSource(i2c, IfxI2c_DtrInterruptSource_singleRequest);
+    IfxI2c_enableDtrInterruptSource(i2c, IfxI2c_DtrInterruptSource_lastBurstRequest);
+    IfxI2c_enableDtrInterruptSource(i2c, IfxI2c_DtrInterruptSource_burstRequest);
+    IfxI2c_enableProtocolInterruptFlag(i2c);
+    IfxI2c_enableErrorInterruptFlag(i2c);
+
+    IfxI2c_enableDtrInterrupt(i2c, tos, ISR_PRIORITY_I2C0_DTR);
+    IfxI2c_enableProtocolInterrupt((void *)i2c, tos, ISR_PRIORITY_I2C0_P);             /* iLLD takes void * here */
+    IfxI2c_enableErrorInterrupt(i2c, tos, ISR_PRIORITY_I2C0_ERR);
+
+    bus->bAsync = TRUE;
+}
+
+IfxI2c_I2c_Status I2c_write(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size)
+{
+    Module_I2C_Transaction trans = {
+        .dir = Module_I2C_Dir_WRITE,
+        .data = data,
+        .size = size
+    };
+
+    /* Retries are done by the queue or by _Polling */
+    if (inst->bus->bAsync) {
+        return _Transfer(inst, &trans);
+    }
+
+    return _Polling(inst, &trans);
+}
+
+IfxI2c_I2c_Status I2c_read(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size)
+{
+    Module_I2C_Transaction trans = {
+        .dir = Module_I2C_Dir_READ,
+        .data = data,
+        .size = size
+    };
+
+    if (inst->bus->bAsync) {
+        return _Transfer(inst, &trans);
+    }
+
+    return _Polling(inst, &trans);
 }
 
-IfxI2c_I2c_Status I2c_write(IfxI2c_I2c_Device *i2cDevice, volatile uint8 *data, Ifx_SizeT size)
+IfxI2c_I2c_Status I2c_writeRead(Module_I2C_Inst *inst, volatile uint8 *wrData, Ifx_SizeT wrSize, volatile uint8 *rdData, Ifx_SizeT rdSize)
 {
-    IfxI2c_I2c_Status ret = 0;
-    while((ret = IfxI2c_I2c_write(i2cDevice, data, size)) == IfxI2c_I2c_Status_nak);
+    Module_I2C_Transaction trans = {
+        .dir = Module_I2C_Dir_WRITE_READ,
+        .data = wrData,
+        .size = wrSize,
+        .rxData = rdData,
+        .rxSize = rdSize
+    };
 
+    if (inst->bus->bAsync) {
+        return _Transfer(inst, &trans);
+    }
+
+    return _Polling(inst, &trans);
+}
+
+IfxI2c_I2c_Status I2c_readRegs(Module_I2C_Inst *inst, uint8 reg, volatile uint8 *data, Ifx_SizeT count)
+{
+    volatile uint8 addr = reg;
+
+    return I2c_writeRead(inst, &addr, 1, data, count);
+}
+
+void I2c_recoverBus(Module_I2C_Inst *inst)
+{
+    _BeginRecovery(inst);
+    do {
+        IfxStm_waitTicks(&MODULE_STM0, inst->bus->recoverTicks);
+    } while (_StepRecovery(inst));
+}
+
+void I2c_getCounters(Module_I2C_Inst *inst, Module_I2C_Counters *counters)
+{
+    *counters = inst->counters;
+}
+
+void I2c_getLatency(Module_I2C_Inst *inst, Module_I2C_Latency *latency)
+{
+    *latency = inst->latency;
+}
+
+void I2c_resetLatency(Module_I2C_Inst *inst)
+{
+    for (int i = 0; i < MODULE_I2C_LATENCY_BINS; i++) {
+        inst->latency.bins[i] = 0;
+    }
+    inst->latency.maxTicks = 0;
+    inst->latency.maxLockTicks = 0;
+}
+
+IfxI2c_I2c_Status I2c_runHighSpeed(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans, uint8 count)
+{
+    Module_I2C_Bus *bus = inst->bus;
+    Ifx_I2C *i2c = bus->handle.i2c;
+    const boolean bRepeatedStart = inst->dev.enableRepeatedStart;
+    IfxI2c_I2c_Status status;
+    boolean bAcquired = FALSE;
+
+    if (bus->bHighSpeed == FALSE || inst->dev.addressMode != IfxI2c_AddressMode_7Bit) {
+        return IfxI2c_I2c_Status_error;
+    }
+
+    _BeginSession(bus);
+    _SetHighSpeed(bus, TRUE);
+
+    if (IfxI2c_busIsFree(i2c) == FALSE) {
+        status = IfxI2c_I2c_Status_busNotFree;
+    } else {
+        IfxI2c_clearAllProtocolInterruptSources(i2c);
+        IfxI2c_clearAllErrorInterruptSources(i2c);
+        IfxI2c_clearAllDtrInterruptSources(i2c);
+        bAcquired = TRUE;
+        status = _SendMasterCode(inst);
+    }
+
+    /* Every transaction starts with a repeated START at hsBaudrate, no bus free check / STOP in between */
+    inst->dev.enableRepeatedStart = TRUE;
+    for (int i = 0; i < count && status == IfxI2c_I2c_Status_ok; i++) {
+        if (trans[i].dir == Module_I2C_Dir_WRITE) {
+            status = _PollingWrite(inst, trans[i].data, trans[i].size);
+        } else if (trans[i].dir == Module_I2C_Dir_READ) {
+            status = _PollingRead(inst, trans[i].data, trans[i].size);
+        } else {
+            status = IfxI2c_I2c_Status_error;
+        }
+    }
+    inst->dev.enableRepeatedStart = bRepeatedStart;
+
+    /* STOP ends the high-speed mode, the next transaction starts in F/S mode again.
+     * Bus not free / arbitration lost: The bus belongs to the other master, no STOP */
+    if (bAcquired && status != IfxI2c_I2c_Status_al) {
+        IfxI2c_releaseBus(i2c);
+    }
+    if (status == IfxI2c_I2c_Status_nak) {
+        inst->counters.naks++;
+    } else if (status != IfxI2c_I2c_Status_ok) {
+        inst->counters.failures++;
+    }
+
+    _SetHighSpeed(bus, FALSE);
+    _EndSession(bus);
+    return status;
+}
+
+boolean I2c_submit(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans)
+{
+    Module_I2C_Bus *bus = inst->bus;
+    Module_I2C_Queue *queue = &bus->queue[inst->config->priority];
+    boolean ret = FALSE;
+    boolean intEnabled;
+
+    /* Interrupts off keeps the bus interrupts out, they run on this core as well */
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, bus->cpu == IfxCpu_getCoreIndex());
+    intEnabled = IfxCpu_disableInterrupts();
+    if (queue->count < MODULE_I2C_QUEUE_LEN) {
+        Module_I2C_Entry *entry = &queue->entry[(queue->head + queue->count) % MODULE_I2C_QUEUE_LEN];
+
+        entry->trans = *trans;
+        entry->inst = inst;
+        entry->submitTick = IfxStm_getLower(&MODULE_STM0);
+        entry->sent = 0;
+        entry->attempt = 0;
+        entry->cpuId = IfxCpu_getCoreId();
+        queue->count++;
+        if (bus->state == Module_I2C_State_IDLE) {
+            _StartNext(bus);
+        }
+        ret = TRUE;
+    }
+
+    IfxCpu_restoreInterrupts(intEnabled);
     return ret;
 }
 
-IfxI2c_I2c_Status I2c_read(IfxI2c_I2c_Device *i2cDevice, volatile uint8 *data, Ifx_SizeT size)
+boolean I2c_isBusBusy(Module_I2C_Inst *inst)
 {
-    IfxI2c_I2c_Status ret = 0;
-    while((ret = IfxI2c_I2c_read(i2cDevice, data, size)) == IfxI2c_I2c_Status_nak);
+    Module_I2C_Bus *bus = inst->bus;
+
+    for (int i = 0; i < Module_I2C_Priority_COUNT; i++) {
+        if (bus->queue[i].count != 0) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+void Init_I2C_Dma(Module_I2C_Inst *inst, IfxDma_ChannelId channelId)
+{
+    Module_I2C_Bus *bus = inst->bus;
+    Module_I2C_Dma *dma = &bus->dma;
+    IfxDma_Dma_ChannelConfig *cfg = &dma->config;
+    IfxDma_Dma_Config dmaConfig;
+
+    if (dma->bEnabled) {
+        return;
+    }
+
+    /* Entries are only written by the core of the bus, the DMA reads them through the global address */
+    dma->list = module_i2c_dmaList[IfxI2c_getIndex(bus->handle.i2c)];
+    dma->listAddress = IFXCPU_GLB_ADDR_DSPR(IfxCpu_getCoreId(), (uint32)(size_t)dma->list);
+
+    IfxDma_Dma_initModuleConfig(&dmaConfig, &MODULE_DMA);
+    IfxDma_Dma_initModule(&dma->dma, &dmaConfig);
+
+    /* One 32 bit move into TXD per FIFO single request */
+    IfxDma_Dma_initChannelConfig(cfg, &dma->dma);
+    cfg->channelId = channelId;
+    cfg->destinationAddress = (uint32)(size_t)&bus->handle.i2c->TXD.U;
+    cfg->destinationCircularBufferEnabled = TRUE;                   /* Destination address stays on TXD */
+    cfg->destinationAddressCircularRange = IfxDma_ChannelIncrementCircular_none;
+    cfg->moveSize = IfxDma_ChannelMoveSize_32bit;
+    cfg->blockMode = IfxDma_ChannelMove_1;
+    cfg->requestMode = IfxDma_ChannelRequestMode_oneTransferPerRequest;
+    cfg->operationMode = IfxDma_ChannelOperationMode_continuous;   /* Keep hardware requests over linked list reloads */
+    cfg->hardwareRequestEnabled = TRUE;
+
+    dma->bEnabled = TRUE;
+}
+
+void Module_I2C_DtrIsr(Module_I2C_Bus *bus)
+{
+    Ifx_I2C *i2c = bus->handle.i2c;
+    const boolean bBurst = (i2c->RIS.U & ((1 << IFX_I2C_RIS_LBREQ_INT_OFF) | (1 << IFX_I2C_RIS_BREQ_INT_OFF))) ? TRUE : FALSE;
+    uint32 words = 1;
+
+    if (bus->state == Module_I2C_State_TRANSFER) {
+        if (bus->txRemain > 0) {
+            if (bBurst) words = 1 << i2c->FIFOCFG.B.TXBS;
+            for (; words > 0 && bus->txRemain > 0; words--) {
+                IfxI2c_writeFifo(i2c, _PackTxWord(bus));
+            }
+        } else if (bus->dst != NULL_PTR) {
+            if (bBurst) words = 1 << i2c->FIFOCFG.B.RXBS;
+            for (; words > 0; words--) {
+                _UnpackRxWord(bus, i2c->RXD.U);
+            }
+        }
+    }
+
+    IfxI2c_clearAllDtrInterruptSources(i2c);
+}
+
+void Module_I2C_ProtocolIsr(Module_I2C_Bus *bus)
+{
+    Ifx_I2C *i2c = bus->handle.i2c;
+    const uint32 pirqss = i2c->PIRQSS.U;
+
+    i2c->PIRQSC.U = pirqss;
+
+    if (bus->state == Module_I2C_State_IDLE || bus->state == Module_I2C_State_BACKOFF || bus->state == Module_I2C_State_RECOVER) {
+        return;
+    }
+
+    if (pirqss & (1 << IFX_I2C_PIRQSS_AL_OFF)) {
+        bus->status = IfxI2c_I2c_Status_al;
+    } else if ((pirqss & (1 << IFX_I2C_PIRQSS_NACK_OFF)) && bus->status == IfxI2c_I2c_Status_ok) {
+        bus->status = IfxI2c_I2c_Status_nak;
+    }
+
+    if ((pirqss & (1 << IFX_I2C_PIRQSS_TX_END_OFF)) == 0) {
+        return;
+    }
+
+    if (bus->state == Module_I2C_State_TRANSFER) {
+        const Module_I2C_Transaction *trans = &bus->active->trans;
+
+        /* Write part done: Master still owns the bus, the next address byte goes out after a repeated START */
+        if (trans->dir == Module_I2C_Dir_WRITE_READ && bus->dst == NULL_PTR && bus->status == IfxI2c_I2c_Status_ok) {
+            IfxI2c_clearAllDtrInterruptSources(i2c);
+            _PrepareRead(bus, trans->rxData, trans->rxSize);
+            return;
+        }
+
+        /* Packet end: Master keeps the bus (SOPE = 0), request the STOP and finish on the next TX_END */
+        if (!bus->active->inst->dev.enableRepeatedStart && bus->status != IfxI2c_I2c_Status_al && !IfxI2c_busIsFree(i2c)) {
+            bus->state = Module_I2C_State_STOP;
+            i2c->ENDDCTRL.B.SETEND = 1;
+            return;
+        }
+    }
+
+    _Finish(bus, bus->status);
+}
+
+void Module_I2C_ErrorIsr(Module_I2C_Bus *bus)
+{
+    IfxI2c_clearAllErrorInterruptSources(bus->handle.i2c);
+
+    if (bus->state == Module_I2C_State_TRANSFER || bus->state == Module_I2C_State_STOP) {
+        bus->status = IfxI2c_I2c_Status_error;
+    }
+}
+
+void Module_I2C_RetryIsr(Module_I2C_Bus *bus)
+{
+    boolean intEnabled = IfxCpu_disableInterrupts();
+
+    IfxStm_disableComparatorInterrupt(&MODULE_STM0, IfxStm_Comparator_1);    /* ICR read-modify-write, see _ArmBackoff */
+    IfxCpu_restoreInterrupts(intEnabled);
+    IfxStm_clearCompareFlag(&MODULE_STM0, IfxStm_Comparator_1);
+
+    /* Bus recovery instead of the retry: The next compare comes after one half period of SCL */
+    if (bus->state == Module_I2C_State_BACKOFF && bus->bRecover) {
+        bus->bRecover = FALSE;
+        bus->state = Module_I2C_State_RECOVER;
+        _BeginRecovery(bus->active->inst);
+        _ArmBackoff(bus, bus->recoverTicks);
+        return;
+    }
+    if (bus->state == Module_I2C_State_RECOVER) {
+        if (_StepRecovery(bus->active->inst)) {
+            _ArmBackoff(bus, bus->recoverTicks);
+            return;
+        }
+    } else if (bus->state != Module_I2C_State_BACKOFF) {
+        return;
+    }
+
+    /* The retried entry stays at its queue head, a higher priority may go first */
+    bus->active = NULL_PTR;
+    _StartNext(bus);
+}
+
+void I2c0_DtrIsr(void)
+{
+    if (module_i2c_bus[0].bAsync) {
+        Module_I2C_DtrIsr(&module_i2c_bus[0]);
+    }
+}
+
+void I2c0_ProtocolIsr(void)
+{
+    if (module_i2c_bus[0].bAsync) {
+        Module_I2C_ProtocolIsr(&module_i2c_bus[0]);
+    }
+}
+
+void I2c0_ErrorIsr(void)
+{
+    if (module_i2c_bus[0].bAsync) {
+        Module_I2C_ErrorIsr(&module_i2c_bus[0]);
+    }
+}
+
+void I2c0_RetryIsr(void)
+{
+    if (module_i2c_bus[0].bAsync) {
+        Module_I2C_RetryIsr(&module_i2c_bus[0]);
+    }
+}
+
+/* Blocking on top of the queue: Must not be called from the I2C callbacks */
+static IfxI2c_I2c_Status _Transfer(Module_I2C_Inst *inst, Module_I2C_Transaction *trans)
+{
+    Module_I2C_Wait wait;
+    Ifx_CPU_ICR icr;
+
+    /* In an ISR (callbacks included) the I2C interrupts that end the wait can not come */
+    icr.U = __mfcr(CPU_ICR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, icr.B.CCPN == 0);
+    if (icr.B.CCPN != 0) {
+        return IfxI2c_I2c_Status_error;     /* Not nak: Callers retry on a nak */
+    }
+
+    trans->callback = _WaitDone;
+    trans->arg = &wait;
+    wait.bDone = FALSE;
+    while (I2c_submit(inst, trans) == FALSE);                       /* Queue full */
+    while (wait.bDone == FALSE);
+
+    return wait.status;
+}
+
+static IfxI2c_I2c_Status _Polling(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans)
+{
+    IfxI2c_I2c_Status ret;
+    uint8 attempt = 0;
+    uint8 faults = 0;
+    boolean bRecover = FALSE;
+
+    do {
+        if (bRecover) {
+            bRecover = FALSE;
+            I2c_recoverBus(inst);
+        }
+        if (attempt > 0) {
+            IfxStm_waitTicks(&MODULE_STM0, _GetBackoffTicks(&inst->config->retry, attempt));
+        }
+
+        ret = _PollingOnce(inst, trans);
+    } while (_CheckRetry(inst, ret, &attempt, &faults, &bRecover));
 
     return ret;
+}
+
+static IfxI2c_I2c_Status _PollingOnce(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans)
+{
+    IfxI2c_I2c_Status ret;
+    const boolean bRepeatedStart = inst->dev.enableRepeatedStart;
+
+    if (trans->dir == Module_I2C_Dir_WRITE) {
+        return _PollingWrite(inst, trans->data, trans->size);
+    } else if (trans->dir == Module_I2C_Dir_READ) {
+        return _PollingRead(inst, trans->data, trans->size);
+    }
+
+    /* Read after the write without STOP: The read must not check for a free bus either */
+    inst->dev.enableRepeatedStart = TRUE;
+    ret = _PollingWrite(inst, trans->data, trans->size);
+    if (ret == IfxI2c_I2c_Status_ok) {
+        ret = _PollingRead(inst, trans->rxData, trans->rxSize);
+    }
+    inst->dev.enableRepeatedStart = bRepeatedStart;
+
+    if (!bRepeatedStart) {
+        IfxI2c_releaseBus(inst->bus->handle.i2c);
+    }
+    return ret;
+}
+
+/* IfxI2c_I2c_write without interrupts off over the whole packet: The words are packed into bus->ring
+ * with interrupts on, only a burst into TXD and the clear of its FIFO request are locked */
+static IfxI2c_I2c_Status _PollingWrite(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size)
+{
+    const uint32 reqMask = (1 << IFX_I2C_RIS_LSREQ_INT_OFF) | (1 << IFX_I2C_RIS_SREQ_INT_OFF) |
+                           (1 << IFX_I2C_RIS_LBREQ_INT_OFF) | (1 << IFX_I2C_RIS_BREQ_INT_OFF);
+    const uint32 burstMask = (1 << IFX_I2C_RIS_LBREQ_INT_OFF) | (1 << IFX_I2C_RIS_BREQ_INT_OFF);
+    const uint32 errMask = (1 << IFX_I2C_RIS_I2C_P_INT_OFF) | (1 << IFX_I2C_RIS_I2C_ERR_INT_OFF);
+    Module_I2C_Bus *bus = inst->bus;
+    Module_I2C_TxRing *ring = &bus->ring;
+    Ifx_I2C *i2c = bus->handle.i2c;
+    IfxI2c_I2c_Status status = IfxI2c_I2c_Status_ok;
+    boolean bFirst = TRUE;                  /* FIFO is empty: The first word goes without a request */
+
+    /* Master code and the empty write stay with the iLLD */
+    if (inst->dev.speedMode == IfxI2c_Mode_HighSpeed || size == 0) {
+        return IfxI2c_I2c_write(&inst->dev, data, size);
+    }
+
+    if (IfxI2c_busIsFree(i2c) == FALSE && inst->dev.enableRepeatedStart == FALSE) {
+        bus->handle.busStatus = IfxI2c_getBusStatus(i2c);
+        bus->handle.status = IfxI2c_I2c_Status_busNotFree;
+        return IfxI2c_I2c_Status_busNotFree;
+    }
+
+    IfxI2c_clearAllProtocolInterruptSources(i2c);
+    IfxI2c_clearAllErrorInterruptSources(i2c);
+    IfxI2c_clearAllDtrInterruptSources(i2c);
+
+    bus->pre[0] = (uint8)(inst->dev.deviceAddress & 0xFE);
+    bus->preLen = 1;
+    bus->prePos = 0;
+    bus->src = data;
+    bus->txRemain = size + 1;
+    ring->head = 0;
+    ring->count = 0;
+    IfxI2c_setTransmitPacketSize(i2c, size + 1);
+
+    while (bus->txRemain > 0 || ring->count > 0) {
+        const uint32 ris = i2c->RIS.U;
+        uint32 words = 1;
+
+        if (ris & errMask) {
+            IfxI2c_clearAllProtocolInterruptSources(i2c);
+            IfxI2c_clearAllErrorInterruptSources(i2c);
+            status = IfxI2c_I2c_Status_error;
+            break;
+        }
+
+        if (bFirst == FALSE && (ris & reqMask) == 0) {
+            /* FIFO still busy: Pack the next word in the meantime */
+            if (bus->txRemain > 0 && ring->count < MODULE_I2C_TX_RING_WORDS) {
+                ring->word[(ring->head + ring->count) % MODULE_I2C_TX_RING_WORDS] = _PackTxWord(bus);
+                ring->count++;
+            }
+            continue;
+        }
+        if (ring->count == 0) {
+            ring->word[ring->head] = _PackTxWord(bus);
+            ring->count = 1;
+        }
+        if (ris & burstMask) {
+            words = 1 << i2c->FIFOCFG.B.TXBS;
+        }
+
+        /* A request raised between the burst and the clear would be lost: Only this part is locked */
+        {
+            boolean intEnabled = IfxCpu_disableInterrupts();
+            const uint32 lockStart = IfxStm_getLower(&MODULE_STM0);
+            uint32 lockTicks;
+
+            for (; words > 0 && ring->count > 0; words--) {
+                IfxI2c_writeFifo(i2c, ring->word[ring->head]);
+                ring->head = (ring->head + 1) % MODULE_I2C_TX_RING_WORDS;
+                ring->count--;
+            }
+            IfxI2c_clearAllDtrInterruptSources(i2c);
+            lockTicks = IfxStm_getLower(&MODULE_STM0) - lockStart;
+            IfxCpu_restoreInterrupts(intEnabled);
+
+            if (lockTicks > inst->latency.maxLockTicks) {
+                inst->latency.maxLockTicks = lockTicks;
+            }
+        }
+        bFirst = FALSE;
+    }
+
+    if (status == IfxI2c_I2c_Status_ok) {
+        /* Wait until all bytes are sent */
+        while (IfxI2c_getProtocolInterruptSourceStatus(i2c, IfxI2c_ProtocolInterruptSource_transmissionEnd) == FALSE);
+        IfxI2c_clearProtocolInterruptSource(i2c, IfxI2c_ProtocolInterruptSource_transmissionEnd);
+
+        if (i2c->RIS.U & errMask) {
+            IfxI2c_clearAllProtocolInterruptSources(i2c);
+            IfxI2c_clearAllErrorInterruptSources(i2c);
+            status = IfxI2c_I2c_Status_error;
+        }
+    }
+
+    if (!inst->dev.enableRepeatedStart) {
+        IfxI2c_releaseBus(i2c);
+    }
+
+    bus->handle.busStatus = IfxI2c_getBusStatus(i2c);
+    bus->handle.status = status;
+    return status;
+}
+
+/* IfxI2c_I2c_read without interrupts off over the packet (more than 32 bytes): Only the read of RXD and the clear
+ * of its FIFO request are locked, as the bursts of _PollingWrite */
+static IfxI2c_I2c_Status _PollingRead(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size)
+{
+    const uint32 reqMask = (1 << IFX_I2C_RIS_LSREQ_INT_OFF) | (1 << IFX_I2C_RIS_SREQ_INT_OFF) |
+                           (1 << IFX_I2C_RIS_LBREQ_INT_OFF) | (1 << IFX_I2C_RIS_BREQ_INT_OFF);
+    const uint32 burstMask = (1 << IFX_I2C_RIS_LBREQ_INT_OFF) | (1 << IFX_I2C_RIS_BREQ_INT_OFF);
+    Module_I2C_Bus *bus = inst->bus;
+    Ifx_I2C *i2c = bus->handle.i2c;
+    IfxI2c_I2c_Status status = IfxI2c_I2c_Status_ok;
+
+    /* Master code and the empty read stay with the iLLD */
+    if (inst->dev.speedMode == IfxI2c_Mode_HighSpeed || size == 0) {
+        return IfxI2c_I2c_read(&inst->dev, data, size);
+    }
+
+    if (IfxI2c_busIsFree(i2c) == FALSE && inst->dev.enableRepeatedStart == FALSE) {
+        bus->handle.busStatus = IfxI2c_getBusStatus(i2c);
+        bus->handle.status = IfxI2c_I2c_Status_busNotFree;
+        return IfxI2c_I2c_Status_busNotFree;
+    }
+
+    IfxI2c_clearAllProtocolInterruptSources(i2c);
+    IfxI2c_clearAllErrorInterruptSources(i2c);
+    IfxI2c_clearAllDtrInterruptSources(i2c);
+
+    bus->dst = data;
+    bus->rxLen = size;
+    bus->pos = 0;
+    IfxI2c_setReceivePacketSize(i2c, size);
+    IfxI2c_setTransmitPacketSize(i2c, 1);
+
+    /* Address byte with R/W set: The request of the empty TX FIFO is cleared with it, it is not an RX request */
+    {
+        boolean intEnabled = IfxCpu_disableInterrupts();
+
+        IfxI2c_writeFifo(i2c, (uint8)(inst->dev.deviceAddress | 0x01));
+        IfxI2c_clearAllDtrInterruptSources(i2c);
+        IfxCpu_restoreInterrupts(intEnabled);
+    }
+
+    while (bus->pos < bus->rxLen) {
+        const uint32 pirqss = i2c->PIRQSS.U;
+        const uint32 ris = i2c->RIS.U;
+        uint32 words = 1;
+
+        if (pirqss & (1 << IFX_I2C_PIRQSS_NACK_OFF)) {
+            status = IfxI2c_I2c_Status_nak;
+            break;
+        }
+        if (pirqss & (1 << IFX_I2C_PIRQSS_AL_OFF)) {
+            status = IfxI2c_I2c_Status_al;
+            break;
+        }
+        if (ris & (1 << IFX_I2C_RIS_I2C_ERR_INT_OFF)) {
+            status = IfxI2c_I2c_Status_error;
+            break;
+        }
+        if ((ris & reqMask) == 0) {
+            continue;
+        }
+        if (ris & burstMask) {
+            words = 1 << i2c->FIFOCFG.B.RXBS;
+        }
+
+        /* A request raised between the read and the clear would be lost: Only this part is locked */
+        {
+            boolean intEnabled = IfxCpu_disableInterrupts();
+            const uint32 lockStart = IfxStm_getLower(&MODULE_STM0);
+            uint32 lockTicks;
+
+            for (; words > 0 && bus->pos < bus->rxLen; words--) {
+                _UnpackRxWord(bus, i2c->RXD.U);
+            }
+            IfxI2c_clearAllDtrInterruptSources(i2c);
+            lockTicks = IfxStm_getLower(&MODULE_STM0) - lockStart;
+            IfxCpu_restoreInterrupts(intEnabled);
+
+            if (lockTicks > inst->latency.maxLockTicks) {
+                inst->latency.maxLockTicks = lockTicks;
+            }
+        }
+    }
+
+    if (status == IfxI2c_I2c_Status_ok) {
+        /* Wait until the last byte is received */
+        while (IfxI2c_getProtocolInterruptSourceStatus(i2c, IfxI2c_ProtocolInterruptSource_transmissionEnd) == FALSE);
+    }
+    IfxI2c_clearAllProtocolInterruptSources(i2c);
+    IfxI2c_clearAllErrorInterruptSources(i2c);
+    bus->dst = NULL_PTR;
+
+    if (!inst->dev.enableRepeatedStart) {
+        IfxI2c_releaseBus(i2c);
+    }
+
+    bus->handle.busStatus = IfxI2c_getBusStatus(i2c);
+    bus->handle.status = status;
+    return status;
+}
+
+/* Master code in F/S mode as a packet of its own, polled as _PollingWrite: No slave answers it (NAK), the master
+ * keeps the bus for the repeated START at hsBaudrate */
+static IfxI2c_I2c_Status _SendMasterCode(Module_I2C_Inst *inst)
+{
+    const uint32 endMask = (1 << IFX_I2C_PIRQSS_TX_END_OFF) | (1 << IFX_I2C_PIRQSS_AL_OFF);
+    Ifx_I2C *i2c = inst->bus->handle.i2c;
+    uint32 pirqss;
+
+    IfxI2c_setTransmitPacketSize(i2c, 1);
+    {
+        boolean intEnabled = IfxCpu_disableInterrupts();
+
+        IfxI2c_writeFifo(i2c, IFXI2C_HIGHSPEED_MASTER_CODE);
+        IfxI2c_clearAllDtrInterruptSources(i2c);
+        IfxCpu_restoreInterrupts(intEnabled);
+    }
+
+    while (((pirqss = i2c->PIRQSS.U) & endMask) == 0);
+    IfxI2c_clearAllProtocolInterruptSources(i2c);
+
+    if (pirqss & (1 << IFX_I2C_PIRQSS_AL_OFF)) {
+        return IfxI2c_I2c_Status_al;
+    }
+    if ((pirqss & (1 << IFX_I2C_PIRQSS_NACK_OFF)) == 0) {
+        return IfxI2c_I2c_Status_error;     /* Answered: Not a master code for this bus */
+    }
+
+    return IfxI2c_I2c_Status_ok;
+}
+
+/* Waits for the transaction on the bus, then the queues hold and the I2C interrupts do not take the FIFO requests */
+static void _BeginSession(Module_I2C_Bus *bus)
+{
+    Ifx_I2C *i2c = bus->handle.i2c;
+    boolean intEnabled;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, bus->cpu == IfxCpu_getCoreIndex());
+    intEnabled = IfxCpu_disableInterrupts();
+
+    while (bus->state != Module_I2C_State_IDLE) {
+        IfxCpu_restoreInterrupts(intEnabled);
+        intEnabled = IfxCpu_disableInterrupts();
+    }
+    bus->state = Module_I2C_State_SESSION;
+
+    if (bus->bAsync) {
+        IfxSrc_disable(IfxI2c_getDtrSrcPointer(i2c));
+        IfxSrc_disable(IfxI2c_getProtocolSrcPointer(i2c));
+        IfxSrc_disable(IfxI2c_getErrorSrcPointer(i2c));
+    }
+    IfxCpu_restoreInterrupts(intEnabled);
+}
+
+static void _EndSession(Module_I2C_Bus *bus)
+{
+    Ifx_I2C *i2c = bus->handle.i2c;
+    boolean intEnabled = IfxCpu_disableInterrupts();
+
+    bus->state = Module_I2C_State_IDLE;
+    bus->handle.busStatus = IfxI2c_getBusStatus(i2c);
+
+    if (bus->bAsync) {
+        /* Requests of the session were served by polling */
+        IfxI2c_clearAllDtrInterruptSources(i2c);
+        IfxI2c_clearAllProtocolInterruptSources(i2c);
+        IfxI2c_clearAllErrorInterruptSources(i2c);
+        IfxSrc_clearRequest(IfxI2c_getDtrSrcPointer(i2c));
+        IfxSrc_clearRequest(IfxI2c_getProtocolSrcPointer(i2c));
+        IfxSrc_clearRequest(IfxI2c_getErrorSrcPointer(i2c));
+        IfxSrc_enable(IfxI2c_getDtrSrcPointer(i2c));
+        IfxSrc_enable(IfxI2c_getProtocolSrcPointer(i2c));
+        IfxSrc_enable(IfxI2c_getErrorSrcPointer(i2c));
+
+        /* Transactions submitted during the session */
+        _StartNext(bus);
+    }
+    IfxCpu_restoreInterrupts(intEnabled);
+}
+
+/* Master code and HS divider only for a session: IfxI2c_setBaudrate puts the standard / fast part on a fixed
+ * divider in HS mode, the queues run at config->baudrate again after the STOP */
+static void _SetHighSpeed(Module_I2C_Bus *bus, boolean bHighSpeed)
+{
+    Ifx_I2C *i2c = bus->handle.i2c;
+
+    IfxI2c_stop(i2c);                       /* Configuration mode */
+    i2c->ADDRCFG.B.MCE = bHighSpeed ? 1 : 0;
+    IfxI2c_setBaudrate(i2c, bHighSpeed ? bus->config->hsBaudrate : bus->config->baudrate);
+    IfxI2c_run(i2c);
+}
+
+/* Counts the result of an attempt, TRUE if the transaction has to be tried again */
+static boolean _CheckRetry(Module_I2C_Inst *inst, IfxI2c_I2c_Status status, uint8 *attempt, uint8 *faults, boolean *bRecover)
+{
+    const Module_I2C_RetryPolicy *policy = &inst->config->retry;
+
+    if (status == IfxI2c_I2c_Status_ok) {
+        *faults = 0;
+        return FALSE;
+    }
+
+    if (status == IfxI2c_I2c_Status_nak) {
+        inst->counters.naks++;
+    } else if (status != IfxI2c_I2c_Status_al) {
+        (*faults)++;                        /* Bus not free / error: Bus may be stuck */
+    }
+
+    if (*attempt < 0xFF) (*attempt)++;
+    if (policy->maxAttempts != 0 && *attempt >= policy->maxAttempts) {
+        inst->counters.failures++;
+        return FALSE;
+    }
+
+    if (policy->recoverAfter != 0 && *faults >= policy->recoverAfter) {
+        *faults = 0;
+        *bRecover = TRUE;
+    }
+    inst->counters.retries++;
+    return TRUE;
+}
+
+static uint32 _GetBackoffTicks(const Module_I2C_RetryPolicy *policy, uint8 attempt)
+{
+    uint32 us = policy->backoffUs;
+
+    for (int i = 1; i < attempt && us < policy->maxBackoffUs; i++) {
+        us <<= 1;
+    }
+    if (us > policy->maxBackoffUs) {
+        us = policy->maxBackoffUs;
+    }
+
+    return IfxStm_getTicksFromMicroseconds(&MODULE_STM0, us);
+}
+
+static void _ArmBackoff(Module_I2C_Bus *bus, uint32 ticks)
+{
+    IfxStm_CompareConfig stmConfig;
+    boolean intEnabled;
+
+    IfxStm_initCompareConfig(&stmConfig);
+    stmConfig.comparator = IfxStm_Comparator_1;
+    stmConfig.comparatorInterrupt = IfxStm_ComparatorInterrupt_ir1;
+    stmConfig.ticks = (ticks > 0) ? ticks : 1;
+    stmConfig.triggerPriority = ISR_PRIORITY_I2C0_RETRY;
+    stmConfig.typeOfService = bus->tos;
+
+    /* CMCON / ICR are shared with comparator 0 (SSD1306 frame governor, Init_SSD1306_Governor on the same core):
+     * The read-modify-write of IfxStm_initCompare must not be split by the other setup */
+    intEnabled = IfxCpu_disableInterrupts();
+    IfxStm_initCompare(&MODULE_STM0, &stmConfig);
+    IfxCpu_restoreInterrupts(intEnabled);
+}
+
+static void _WaitDone(IfxI2c_I2c_Status status, void *arg)
+{
+    Module_I2C_Wait *wait = (Module_I2C_Wait *)arg;
+
+    wait->status = status;
+    wait->bDone = TRUE;
+}
+
+/* Highest priority first, a waiting lower priority is served after MODULE_I2C_STARVE_LIMIT higher ones */
+static Module_I2C_Entry *_Pick(Module_I2C_Bus *bus)
+{
+    int prio = -1;
+    int lower = -1;
+
+    for (int i = 0; i < Module_I2C_Priority_COUNT; i++) {
+        if (bus->queue[i].count > 0) {
+            prio = i;
+            break;
+        }
+    }
+    if (prio < 0) {
+        return NULL_PTR;
+    }
+
+    for (int i = prio + 1; i < Module_I2C_Priority_COUNT; i++) {
+        if (bus->queue[i].count > 0) {
+            lower = i;
+            break;
+        }
+    }
+
+    if (lower < 0) {
+        bus->served = 0;
+    } else if (bus->served >= MODULE_I2C_STARVE_LIMIT) {
+        bus->served = 0;
+        prio = lower;
+    } else {
+        bus->served++;
+    }
+
+    bus->activePrio = (uint8)prio;
+    return &bus->queue[prio].entry[bus->queue[prio].head];
+}
+
+static void _StartNext(Module_I2C_Bus *bus)
+{
+    Ifx_I2C *i2c = bus->handle.i2c;
+    Module_I2C_Entry *entry = _Pick(bus);
+    const Module_I2C_Transaction *trans;
+    IfxI2c_I2c_Device *dev;
+    IfxI2c_BusStatus busStatus;
+
+    if (entry == NULL_PTR) {
+        bus->active = NULL_PTR;
+        bus->state = Module_I2C_State_IDLE;
+        return;
+    }
+
+    trans = &entry->trans;
+    dev = &entry->inst->dev;
+    bus->active = entry;
+    bus->state = Module_I2C_State_TRANSFER;
+    bus->status = IfxI2c_I2c_Status_ok;
+    bus->dst = NULL_PTR;
+    bus->prePos = 0;
+    bus->txRemain = 0;
+    bus->txLen = 0;
+
+    if (dev->addressMode != IfxI2c_AddressMode_7Bit || dev->speedMode != IfxI2c_Mode_StandardAndFast ||
+        trans->size < 0 || (trans->dir != Module_I2C_Dir_WRITE && trans->size == 0) ||
+        (trans->dir == Module_I2C_Dir_WRITE_READ && trans->rxSize <= 0)) {
+        _Finish(bus, IfxI2c_I2c_Status_error);
+        return;
+    }
+
+    busStatus = IfxI2c_getBusStatus(i2c);
+    if (busStatus != IfxI2c_BusStatus_idle && busStatus != IfxI2c_BusStatus_busyMaster) {
+        _Finish(bus, IfxI2c_I2c_Status_busNotFree);
+        return;
+    }
+
+    IfxI2c_clearAllProtocolInterruptSources(i2c);
+    IfxI2c_clearAllErrorInterruptSources(i2c);
+    IfxI2c_clearAllDtrInterruptSources(i2c);
+
+    /* The first FIFO request of the packet raises the DTR interrupt */
+    if (trans->dir == Module_I2C_Dir_READ) {
+        _PrepareRead(bus, trans->data, trans->size);
+    } else {
+        _PrepareWrite(bus, entry);
+    }
+}
+
+/* Address (+ chunk header) from bus->pre, then txLen bytes from bus->src */
+static void _PrepareWrite(Module_I2C_Bus *bus, Module_I2C_Entry *entry)
+{
+    const Module_I2C_Transaction *trans = &entry->trans;
+    const Ifx_SizeT first = trans->bDma ? MODULE_I2C_DMA_HEADROOM : 0;          /* Index of the first payload byte */
+    const boolean bWrite = (trans->dir == Module_I2C_Dir_WRITE);
+    Ifx_SizeT total;
+
+    bus->pre[0] = (uint8)(entry->inst->dev.deviceAddress & 0xFE);
+    if (bWrite && trans->chunkSize > 0 && trans->size > 1) {
+        const Ifx_SizeT rest = trans->size - 1 - entry->sent;
+
+        bus->pre[1] = trans->data[first];
+        bus->preLen = 2;
+        bus->src = &trans->data[first + 1 + entry->sent];
+        bus->txLen = (rest > trans->chunkSize) ? trans->chunkSize : rest;
+    } else {
+        bus->preLen = 1;
+        bus->src = &trans->data[first];
+        bus->txLen = trans->size;
+    }
+    total = bus->preLen + bus->txLen;
+
+    /* DMA reads the prefix from the bytes in front of the payload, they are put back in _Finish.
+     * IfxI2c_setTransmitPacketSize announces all of total: Longer than the linked list it stays on the DTR interrupt */
+    if (bWrite && trans->bDma && bus->dma.bEnabled && total <= MODULE_I2C_DMA_MAX_SIZE &&
+        (((size_t)(bus->src - bus->preLen)) & 0x3) == 0) {
+        bus->borrowed = bus->src - bus->preLen;
+        for (int i = 0; i < bus->preLen; i++) {
+            bus->saved[i] = bus->borrowed[i];
+            bus->borrowed[i] = bus->pre[i];
+        }
+        _StartDma(bus, entry->cpuId, bus->borrowed, total);
+    } else {
+        bus->txRemain = total;
+    }
+    IfxI2c_setTransmitPacketSize(bus->handle.i2c, total);
+}
+
+/* Address byte with the R bit, then size bytes from RXD */
+static void _PrepareRead(Module_I2C_Bus *bus, volatile uint8 *data, Ifx_SizeT size)
+{
+    Ifx_I2C *i2c = bus->handle.i2c;
+
+    bus->pre[0] = (uint8)(bus->active->inst->dev.deviceAddress | 0x01);
+    bus->preLen = 1;
+    bus->prePos = 0;
+    bus->txRemain = 1;
+    bus->dst = data;
+    bus->rxLen = size;
+    bus->pos = 0;
+    IfxI2c_setReceivePacketSize(i2c, size);
+    IfxI2c_setTransmitPacketSize(i2c, 1);
+}
+
+static void _Finish(Module_I2C_Bus *bus, IfxI2c_I2c_Status status)
+{
+    Module_I2C_Entry *entry = bus->active;
+    Module_I2C_Inst *inst = entry->inst;
+    Module_I2C_Queue *queue = &bus->queue[bus->activePrio];
+    Module_I2C_Transaction trans;
+
+    if (bus->bDmaActive) {
+        _StopDma(bus);
+    }
+    if (bus->borrowed != NULL_PTR) {
+        for (int i = 0; i < bus->preLen; i++) {
+            bus->borrowed[i] = bus->saved[i];
+        }
+        bus->borrowed = NULL_PTR;
+    }
+
+    /* Entry stays in the queue until the STM compare of the backoff */
+    if (_CheckRetry(inst, status, &entry->attempt, &bus->faults, &bus->bRecover)) {
+        bus->state = Module_I2C_State_BACKOFF;
+        _ArmBackoff(bus, _GetBackoffTicks(&inst->config->retry, entry->attempt));
+        return;
+    }
+    entry->attempt = 0;
+
+    /* Chunk done: Higher priorities may take the bus before the next chunk */
+    if (status == IfxI2c_I2c_Status_ok && entry->trans.dir == Module_I2C_Dir_WRITE &&
+        entry->trans.chunkSize > 0 && entry->trans.size > 1) {
+        entry->sent += bus->txLen;
+        if (entry->sent < entry->trans.size - 1) {
+            _StartNext(bus);
+            return;
+        }
+    }
+
+    trans = entry->trans;
+    _RecordLatency(inst, IfxStm_getLower(&MODULE_STM0) - entry->submitTick);
+    queue->head = (queue->head + 1) % MODULE_I2C_QUEUE_LEN;
+    queue->count--;
+    bus->active = NULL_PTR;
+    bus->state = Module_I2C_State_IDLE;
+    bus->handle.busStatus = IfxI2c_getBusStatus(bus->handle.i2c);
+    bus->handle.status = status;
+
+    if (trans.callback != NULL_PTR) {
+        trans.callback(status, trans.arg);
+    }
+
+    /* The callback may already have started the next transaction through I2c_submit */
+    if (bus->state == Module_I2C_State_IDLE) {
+        _StartNext(bus);
+    }
+}
+
+static void _RecordLatency(Module_I2C_Inst *inst, uint32 ticks)
+{
+    uint32 slot = ticks / inst->bus->latencyBase;
+    int bin = 0;
+
+    while (slot > 0 && bin < MODULE_I2C_LATENCY_BINS - 1) {
+        slot >>= 1;
+        bin++;
+    }
+
+    inst->latency.bins[bin]++;
+    if (ticks > inst->latency.maxTicks) {
+        inst->latency.maxTicks = ticks;
+    }
+}
+
+static uint32 _PackTxWord(Module_I2C_Bus *bus)
+{
+    union data
+    {
+        uint32 packet;
+        uint8  packetbyte[4];
+    } txdata;
+
+    txdata.packet = 0;
+    for (int i = 0; i < 4 && bus->txRemain > 0; i++) {
+        if (bus->prePos < bus->preLen) {
+            txdata.packetbyte[i] = bus->pre[bus->prePos++];
+        } else {
+            txdata.packetbyte[i] = *bus->src++;
+        }
+        bus->txRemain--;
+    }
+
+    return txdata.packet;
+}
+
+static void _UnpackRxWord(Module_I2C_Bus *bus, uint32 packet)
+{
+    union data
+    {
+        uint32 packet;
+        uint8  packetbyte[4];
+    } rxdata;
+
+    rxdata.packet = packet;
+    for (int i = 0; i < 4 && bus->pos < bus->rxLen; i++) {
+        bus->dst[bus->pos++] = rxdata.packetbyte[i];
+    }
+}
+
+/* TXD words are fetched by the DMA from source, the CPU only sees the protocol interrupt at the end */
+static void _StartDma(Module_I2C_Bus *bus, IfxCpu_Id cpuId, volatile uint8 *source, Ifx_SizeT size)
+{
+    Module_I2C_Dma *dma = &bus->dma;
+    IfxDma_Dma_ChannelConfig cfg = dma->config;
+    Ifx_I2C *i2c = bus->handle.i2c;
+    const uint32 address = IFXCPU_GLB_ADDR_DSPR(cpuId, source);
+    uint32 words = (size + 3) / 4;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, size <= MODULE_I2C_DMA_MAX_SIZE);
+
+    /* Entry i is loaded into the channel when entry i - 1 is done, the last entry ends the list */
+    for (int i = 0; i < MODULE_I2C_DMA_LIST_LEN && words > 0; i++) {
+        cfg.sourceAddress = address + (i * MODULE_I2C_DMA_CHUNK_WORDS * 4);
+        cfg.transferCount = (words > MODULE_I2C_DMA_CHUNK_WORDS) ? MODULE_I2C_DMA_CHUNK_WORDS : words;
+        words -= cfg.transferCount;
+        if (words > 0 && (i + 1) < MODULE_I2C_DMA_LIST_LEN) {
+            cfg.shadowControl = IfxDma_ChannelShadow_linkedList;
+            cfg.shadowAddress = dma->listAddress + ((i + 1) * sizeof(Ifx_DMA_CH));
+        } else {
+            cfg.shadowControl = IfxDma_ChannelShadow_none;
+            cfg.shadowAddress = 0;
+        }
+
+        if (i == 0) {
+            IfxDma_Dma_initChannel(&dma->channel, &cfg);
+        }
+        IfxDma_Dma_initLinkedListEntry((void *)&dma->list[i], &cfg);
+    }
+
+    /* Burst requests would need 2^TXBS moves per request: DMA is served by single requests only */
+    IfxI2c_disableDtrInterruptSource(i2c, IfxI2c_DtrInterruptSource_lastBurstRequest);
+    IfxI2c_disableDtrInterruptSource(i2c, IfxI2c_DtrInterruptSource_burstRequest);
+    IfxSrc_init(IfxI2c_getDtrSrcPointer(i2c), IfxSrc_Tos_dma, dma->config.channelId);
+    bus->bDmaActive = TRUE;
+}
+
+static void _StopDma(Module_I2C_Bus *bus)
+{
+    Ifx_I2C *i2c = bus->handle.i2c;
+    Module_I2C_Dma *dma = &bus->dma;
+
+    IfxSrc_init(IfxI2c_getDtrSrcPointer(i2c), bus->tos, ISR_PRIORITY_I2C0_DTR);
+
+    /* Cut short (NAK, error): The next request would go on with the TCOUNT left over, not with the next TREL */
+    if (IfxDma_getChannelTransferCount(dma->dma.dma, dma->config.channelId) != 0) {
+        IfxDma_resetChannel(dma->dma.dma, dma->config.channelId);
+    }
+    IfxI2c_clearAllDtrInterruptSources(i2c);
+    IfxI2c_enableDtrInterruptSource(i2c, IfxI2c_DtrInterruptSource_lastBurstRequest);
+    IfxI2c_enableDtrInterruptSource(i2c, IfxI2c_DtrInterruptSource_burstRequest);
+    bus->bDmaActive = FALSE;
 }
\ No newline at end of file
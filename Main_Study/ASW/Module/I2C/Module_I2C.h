@@ -3,21 +3,253 @@
 
 #include "Ifx_Types.h"
 #include "IfxI2c_I2c.h"
+#include "IfxDma_Dma.h"
+
+#define MODULE_I2C_QUEUE_LEN            8                                               /* Pending transactions per priority */
+#define MODULE_I2C_STARVE_LIMIT         4                                               /* Higher priority transactions before a waiting lower one */
+#define MODULE_I2C_LATENCY_BINS         8
+#define MODULE_I2C_LATENCY_BASE_US      100                                             /* Upper edge of latency bin 0 */
+#define MODULE_I2C_DMA_HEADROOM         1                                               /* DMA writes: data[0] is reserved for the address byte */
+#define MODULE_I2C_DMA_CHUNK_WORDS      256                                             /* TXD words per linked list entry (1KB) */
+#define MODULE_I2C_DMA_LIST_LEN         4                                               /* Linked list entries: 4KB per DMA write */
+#define MODULE_I2C_DMA_MAX_SIZE         (MODULE_I2C_DMA_LIST_LEN * MODULE_I2C_DMA_CHUNK_WORDS * 4)     /* Longer writes are fed by the DTR interrupt */
+#define MODULE_I2C_RECOVERY_CLOCKS      9                                               /* SCL pulses to release a slave holding SDA */
+#define MODULE_I2C_RECOVERY_HALF_US     5                                               /* 100kHz SCL during the bus recovery */
+#define MODULE_I2C_TX_RING_WORDS        8                                               /* Blocking writes: TXD words packed ahead of the FIFO requests */
+
+/**
+ * @brief Retries of a transaction after NAK / arbitration lost / bus not free / error
+ * Bus recovery: SCL is toggled as GPIO until SDA is released, then a STOP is generated.
+ * Queued transactions step the recovery on the retry STM compare, one half period per interrupt.
+ */
+typedef struct _Module_I2C_RetryPolicy {
+    uint8 maxAttempts;                                   /* First try included, 0 = until ok */
+    uint32 backoffUs;                                    /* Wait before the first retry, doubled per retry */
+    uint32 maxBackoffUs;                                 /* >= backoffUs */
+    uint8 recoverAfter;                                  /* Bus not free / error in a row before the bus recovery, 0 = never */
+} Module_I2C_RetryPolicy;
+
+typedef struct _Module_I2C_Counters {
+    uint32 naks;
+    uint32 retries;
+    uint32 recoveries;
+    uint32 failures;                                     /* Given up after maxAttempts */
+} Module_I2C_Counters;
+
+typedef enum eModule_I2C_Priority {
+    Module_I2C_Priority_HIGH = 0,                        /* Sensor reads */
+    Module_I2C_Priority_NORMAL = 1,
+    Module_I2C_Priority_LOW = 2,                         /* Display streams */
+    Module_I2C_Priority_COUNT = 3
+} Module_I2C_Priority;
 
 typedef struct _Module_I2C_Config {
     Ifx_I2C *p_i2c;
-    IfxI2c_Pins MCP_PINS;
+    IfxI2c_Pins MCP_PINS;                                /* Pins / baudrate of the first device on the module are used */
     float32 baudrate;
+    float32 hsBaudrate;                                  /* SCL after the master code (I2c_runHighSpeed), 0 = no high-speed mode */
     uint16 addr;
+    Module_I2C_RetryPolicy retry;
+    Module_I2C_Priority priority;                        /* Queue of the device's transactions */
 } Module_I2C_Config;
 
-typedef struct _Module_I2C_Inst {
+typedef enum eModule_I2C_Dir {
+    Module_I2C_Dir_WRITE = 0,
+    Module_I2C_Dir_READ = 1,
+    Module_I2C_Dir_WRITE_READ = 2                        /* data (e.g. register address), repeated START, rxData */
+} Module_I2C_Dir;
+
+typedef enum eModule_I2C_State {
+    Module_I2C_State_IDLE = 0,
+    Module_I2C_State_TRANSFER = 1,                       /* Address and data are moved by the DTR interrupt */
+    Module_I2C_State_STOP = 2,                           /* STOP requested, waiting for TX_END */
+    Module_I2C_State_BACKOFF = 3,                        /* Active entry is retried on the STM compare */
+    Module_I2C_State_SESSION = 4,                        /* I2c_runHighSpeed owns the bus, the queues wait */
+    Module_I2C_State_RECOVER = 5                         /* Bus recovery of the active entry, one step per STM compare */
+} Module_I2C_State;
+
+/**
+ * @brief Called from the I2C interrupt when a transaction is finished
+ */
+typedef void (*Module_I2C_Callback)(IfxI2c_I2c_Status status, void *arg);
+
+/**
+ * @brief chunkSize (write only): data[0] is a header (e.g. SSD1306 control byte) sent in front of every
+ * chunkSize bytes of the rest. Each chunk is its own bus transaction, higher priorities are served in between.
+ * With bDma the header is data[1], chunkSize % 4 == 0 keeps the chunks on the DMA.
+ * Module_I2C_Dir_WRITE_READ keeps the bus between both parts, bDma / chunkSize are not used for it.
+ */
+typedef struct _Module_I2C_Transaction {
+    Module_I2C_Dir dir;
+    volatile uint8 *data;                                /* Must stay valid until the callback */
+    Ifx_SizeT size;
+    Module_I2C_Callback callback;                        /* NULL_PTR for fire and forget */
+    void *arg;
+    boolean bDma;                                        /* Write only: data is 4 byte aligned, payload is data[1 ~ size] */
+    Ifx_SizeT chunkSize;                                 /* 0 = one bus transaction */
+    volatile uint8 *rxData;                              /* Module_I2C_Dir_WRITE_READ: read part */
+    Ifx_SizeT rxSize;
+} Module_I2C_Transaction;
+
+typedef struct _Module_I2C_Entry {
+    Module_I2C_Transaction trans;
+    struct _Module_I2C_Inst *inst;                       /* Submitting device */
+    uint32 submitTick;                                   /* STM0 lower */
+    Ifx_SizeT sent;                                      /* Bytes of the finished chunks, header excluded */
+    uint8 attempt;                                       /* Failed attempts of the current chunk */
+    IfxCpu_Id cpuId;                                     /* Core of I2c_submit: Local DSPR addresses of trans are its */
+} Module_I2C_Entry;
+
+typedef struct _Module_I2C_Queue {
+    Module_I2C_Entry entry[MODULE_I2C_QUEUE_LEN];
+    volatile uint8 head;
+    volatile uint8 count;
+} Module_I2C_Queue;
+
+/**
+ * @brief TXD words of a blocking write, packed with interrupts enabled while the FIFO drains
+ */
+typedef struct _Module_I2C_TxRing {
+    uint32 word[MODULE_I2C_TX_RING_WORDS];
+    uint8 head;                                          /* Next word for TXD */
+    uint8 count;
+} Module_I2C_TxRing;
+
+typedef struct _Module_I2C_Dma {
+    IfxDma_Dma dma;
+    IfxDma_Dma_Channel channel;
+    IfxDma_Dma_ChannelConfig config;                     /* Settings shared by every linked list entry */
+    Ifx_DMA_CH *list;                                    /* Linked list entries of this bus */
+    uint32 listAddress;                                  /* Global address of list for the DMA */
+    boolean bEnabled;
+} Module_I2C_Dma;
+
+/**
+ * @brief State of one I2C module, shared by every device on it
+ */
+typedef struct _Module_I2C_Bus {
     IfxI2c_I2c handle;                                   /* I2C handle                                       */
-    IfxI2c_I2c_Device dev;                               /* I2C Slave device handle to Microchip 24AA02E48   */
+    const Module_I2C_Config *config;                     /* First device: pins / baudrate                    */
+    boolean bInit;
+    boolean bAsync;                                      /* Interrupts are routed to this bus                */
+    boolean bHighSpeed;                                  /* hsBaudrate set, I2c_runHighSpeed may switch to it */
+    IfxSrc_Tos tos;                                      /* CPU serving the interrupts                       */
+    IfxCpu_ResourceCpu cpu;                              /* Core of Init_I2C, the only one using the bus     */
+    Module_I2C_Queue queue[Module_I2C_Priority_COUNT];
+    uint8 served;                                        /* Higher priorities in a row while a lower waits   */
+    Module_I2C_Entry *active;                            /* Entry on the bus, NULL_PTR when idle             */
+    uint8 activePrio;
+    volatile Module_I2C_State state;
+    IfxI2c_I2c_Status status;                            /* Status of the transaction on the bus             */
+    uint8 pre[2];                                        /* Address byte with R/W bit, chunk header          */
+    uint8 preLen;
+    uint8 prePos;
+    volatile uint8 *src;                                 /* Next payload byte for TXD                        */
+    Ifx_SizeT txLen;                                     /* Payload bytes of this bus transaction            */
+    Ifx_SizeT txRemain;                                  /* Bytes still to be written to TXD, prefix included */
+    volatile uint8 *dst;                                 /* RXD bytes go here, NULL_PTR while writing        */
+    Ifx_SizeT rxLen;
+    Ifx_SizeT pos;                                       /* Bytes read from RXD                              */
+    uint8 faults;                                        /* Bus not free / error in a row                    */
+    boolean bRecover;                                    /* Bus recovery before the next attempt             */
+    uint8 recoverStep;                                   /* Next half period of the bus recovery             */
+    uint32 recoverTicks;                                 /* MODULE_I2C_RECOVERY_HALF_US in STM ticks         */
+    Module_I2C_Dma dma;                                  /* TXD feeder for bDma transactions                 */
+    boolean bDmaActive;                                  /* DTR requests are routed to the DMA channel       */
+    volatile uint8 *borrowed;                            /* Bytes in front of a DMA chunk holding the prefix */
+    uint8 saved[2];
+    Module_I2C_TxRing ring;                              /* Blocking writes before Init_I2C_Async            */
+    uint32 latencyBase;                                  /* MODULE_I2C_LATENCY_BASE_US in STM ticks          */
+} Module_I2C_Bus;
+
+/**
+ * @brief Submit to completion time: bin 0 < base, bin i < base * 2^i, last bin open
+ */
+typedef struct _Module_I2C_Latency {
+    uint32 bins[MODULE_I2C_LATENCY_BINS];
+    uint32 maxTicks;
+    uint32 maxLockTicks;                                 /* Longest interrupts-off window of a blocking transfer */
+} Module_I2C_Latency;
+
+typedef struct _Module_I2C_Inst {
+    const Module_I2C_Config *config;
+    Module_I2C_Bus *bus;
+    IfxI2c_I2c_Device dev;                               /* I2C Slave device handle                          */
+    Module_I2C_Counters counters;
+    Module_I2C_Latency latency;
 } Module_I2C_Inst;
 
+/**
+ * @brief Devices with the same p_i2c share one bus, the module is initialized by the first one
+ * The queues are only locked against the bus interrupts (interrupts off), not against another core:
+ * Every device of a bus is initialized and used by the same core, Init_I2C_Async routes the interrupts to it.
+ */
 extern void Init_I2C(Module_I2C_Inst *inst, const Module_I2C_Config *config);
-extern IfxI2c_I2c_Status I2c_write(IfxI2c_I2c_Device *i2cDevice, volatile uint8 *data, Ifx_SizeT size);
-extern IfxI2c_I2c_Status I2c_read(IfxI2c_I2c_Device *i2cDevice, volatile uint8 *data, Ifx_SizeT size);
+/**
+ * @brief Blocking transfer, retried by config->retry
+ * Without Init_I2C_Async the CPU moves TXD / RXD on the FIFO requests, interrupts are only off for one burst.
+ * After Init_I2C_Async not from an ISR or an I2C callback: IfxI2c_I2c_Status_error (asserts).
+ */
+extern IfxI2c_I2c_Status I2c_write(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size);
+extern IfxI2c_I2c_Status I2c_read(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size);
+/**
+ * @brief Write wrData, then read rdData after a repeated START: No STOP / bus free check in between
+ */
+extern IfxI2c_I2c_Status I2c_writeRead(Module_I2C_Inst *inst, volatile uint8 *wrData, Ifx_SizeT wrSize, volatile uint8 *rdData, Ifx_SizeT rdSize);
+/**
+ * @brief Burst read of count registers from reg (slave increments the register address)
+ */
+extern IfxI2c_I2c_Status I2c_readRegs(Module_I2C_Inst *inst, uint8 reg, volatile uint8 *data, Ifx_SizeT count);
+/**
+ * @brief High-speed session: Master code once, then the transactions at hsBaudrate with repeated STARTs, one STOP at the end
+ * Blocking, the transactions of the other devices wait in their queues until the STOP.
+ * Master code and HS divider are only set up for the session, the module is back at baudrate (F/S) afterwards.
+ * Only Module_I2C_Dir_WRITE / Module_I2C_Dir_READ (chunkSize / bDma / callback are not used), the first failure ends the session.
+ * Polled as the blocking transfers, interrupts are only off for one FIFO burst. No STOP if the bus was not free.
+ *
+ * @param inst Device with HS mode
+ * @param trans
+ * @param count
+ * @return IfxI2c_I2c_Status IfxI2c_I2c_Status_error if the first device of the module had no hsBaudrate
+ */
+extern IfxI2c_I2c_Status I2c_runHighSpeed(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans, uint8 count);
+/**
+ * @brief Blocking bus recovery, the queues do it from the retry interrupt instead (Module_I2C_State_RECOVER)
+ */
+extern void I2c_recoverBus(Module_I2C_Inst *inst);
+extern void I2c_getCounters(Module_I2C_Inst *inst, Module_I2C_Counters *counters);
+extern void I2c_getLatency(Module_I2C_Inst *inst, Module_I2C_Latency *latency);
+extern void I2c_resetLatency(Module_I2C_Inst *inst);
+
+/**
+ * @brief Route the module's DTR / Protocol / Error interrupts to the bus of inst (ISR priorities in ASW_CONFIG.h)
+ * Only I2C0 has vectors (I2c0_*Isr): Other modules assert and stay on the blocking calls.
+ * Retries wait on STM0 comparator 1.
+ * After this I2c_write / I2c_read of every device on the bus also go through the queues.
+ */
+extern void Init_I2C_Async(Module_I2C_Inst *inst);
+/**
+ * @brief Queue a transaction at inst->config->priority and return without waiting for the bus
+ * Highest priority first, a waiting lower priority gets the bus after MODULE_I2C_STARVE_LIMIT transactions.
+ * Only from the core of Init_I2C (see Init_I2C).
+ * 
+ * @return boolean FALSE if the queue is full
+ */
+extern boolean I2c_submit(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans);
+/**
+ * @brief TRUE while a transaction of any device on the bus of inst is queued
+ */
+extern boolean I2c_isBusBusy(Module_I2C_Inst *inst);
+/**
+ * @brief Feed TXD of bDma writes from a DMA linked list instead of the DTR interrupt (after Init_I2C_Async)
+ * The DTR service request is handed to the DMA channel (channel number = SRN priority) during those writes.
+ * Writes longer than MODULE_I2C_DMA_MAX_SIZE (address byte / header included) stay on the DTR interrupt.
+ */
+extern void Init_I2C_Dma(Module_I2C_Inst *inst, IfxDma_ChannelId channelId);
+
+extern void Module_I2C_DtrIsr(Module_I2C_Bus *bus);
+extern void Module_I2C_ProtocolIsr(Module_I2C_Bus *bus);
+extern void Module_I2C_ErrorIsr(Module_I2C_Bus *bus);
+extern void Module_I2C_RetryIsr(Module_I2C_Bus *bus);
 
 #endif
\ No newline at end of file
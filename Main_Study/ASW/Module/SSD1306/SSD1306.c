@@ -1,17 +1,23 @@
 #include "Module_I2C.h"
 #include "SSD1306.h"
+#include "IfxStm.h"
+#include "IfxCpu.h"
+#include "ASW/ASW_CONFIG.h"
 
-static void SetPageAndColumnPosition(uint8 page, uint8 column);
-static void _DafaultSoftwareInit(void);
+#include <string.h>
 
-/* 9-1 Command Table */
+IFX_INLINE void SetPageAndColumnPosition(SSD1306_Inst *panel, uint8 page, uint8 column);
+IFX_INLINE void SetWindow(SSD1306_Inst *panel, uint8 startPage, uint8 endPage, uint8 startColumn, uint8 endColumn);
+static void _DafaultSoftwareInit(SSD1306_Inst *panel);
+
+/* 9-1 Command Table: One builder per command. Inline, the constant command tables replaced most of their calls */
 /********************************/
 /*     Fundamental Command      */
 /********************************/
-static void SetContrastControl(uint8 value);
-static void EntireDisplayOn(uint8 bIgCon);
-static void SetNormalInverseDisplay(uint8 bInverse);
-static void SetDisplayOnOff(uint8 bOn);
+IFX_INLINE void SetContrastControl(SSD1306_Inst *panel, uint8 value);
+IFX_INLINE void EntireDisplayOn(SSD1306_Inst *panel, uint8 bIgCon);
+IFX_INLINE void SetNormalInverseDisplay(SSD1306_Inst *panel, uint8 bInverse);
+IFX_INLINE void SetDisplayOnOff(SSD1306_Inst *panel, uint8 bOn);
 
 /********************************/
 /*       Scrolling Command      */
@@ -24,7 +30,7 @@ static void SetDisplayOnOff(uint8 bOn);
  * @param interval Set time interval between each scroll step in terms of frame frequency
  * @param epg Define End Page Addresss
  */
-static void ContinuousHorizontalScrollSetup(uint8 bLHS, uint8 spg, uint8 interval, uint8 epg);
+IFX_INLINE void ContinuousHorizontalScrollSetup(SSD1306_Inst *panel, uint8 bLHS, uint8 spg, uint8 interval, uint8 epg);
 /**
  * @brief No Continuous Vertical Scrolling is available
  * 
@@ -34,16 +40,16 @@ static void ContinuousHorizontalScrollSetup(uint8 bLHS, uint8 spg, uint8 interva
  * @param epg Define End Page Address
  * @param vOffset Vertical Scrolling Offset
  */
-static void ContinuousVerticalAndHorizontalScrollSetup(uint8 VLHS, uint8 spg, uint8 interval, uint8 epg, uint8 vOffset);
-static void DeactivateScroll(void);
-static void ActivateScroll(void);
+IFX_INLINE void ContinuousVerticalAndHorizontalScrollSetup(SSD1306_Inst *panel, uint8 VLHS, uint8 spg, uint8 interval, uint8 epg, uint8 vOffset);
+IFX_INLINE void DeactivateScroll(SSD1306_Inst *panel);
+IFX_INLINE void ActivateScroll(SSD1306_Inst *panel);
 /**
  * @brief Set the Vertical Scroll
  * 
  * @param fixedRows Set No. of rows in top fixed area
  * @param scrollRows Set No. of rows in scroll area
  */
-static void SetVerticalScrollArea(uint8 fixedRows, uint8 scrollRows);
+IFX_INLINE void SetVerticalScrollArea(SSD1306_Inst *panel, uint8 fixedRows, uint8 scrollRows);
 
 /********************************/
 /*  Addressing Setting Command  */
@@ -54,40 +60,40 @@ static void SetVerticalScrollArea(uint8 fixedRows, uint8 scrollRows);
  * 
  * @param nibble lower nibble
  */
-static void SetLowColStartAddrPageMode(uint8 nibble);
+IFX_INLINE void SetLowColStartAddrPageMode(SSD1306_Inst *panel, uint8 nibble);
 
 /**
  * @brief Set the higher nibble of the column start address register for Page Addressing Mode
  * 
  * @param nibble higher nibble
  */
-static void SetHighColStartAddrPageMode(uint8 nibble);
-static void SetMemoryAddressingMode(uint8 mode);
-static void SetComlumnAddress(uint8 startAddr, uint8 endAddr);
-static void SetPageAddress(uint8 startAddr, uint8 endAddr);
+IFX_INLINE void SetHighColStartAddrPageMode(SSD1306_Inst *panel, uint8 nibble);
+IFX_INLINE void SetMemoryAddressingMode(SSD1306_Inst *panel, uint8 mode);
+IFX_INLINE void SetComlumnAddress(SSD1306_Inst *panel, uint8 startAddr, uint8 endAddr);
+IFX_INLINE void SetPageAddress(SSD1306_Inst *panel, uint8 startAddr, uint8 endAddr);
 /**
  * @brief Set GDDRAM Page Start Address(PAGE0 ~ PAGE7) for Page Addressing Mode
  * 
  * @param page 
  */
-static void SetPageStartForPageMode(uint8 page);
+IFX_INLINE void SetPageStartForPageMode(SSD1306_Inst *panel, uint8 page);
 
 /*************************************/
 /*  Hardware Configuration Command   */
 /* Panel resolution & layout related */
 /*************************************/
 
-static void SetDisplayStartLine(uint8 line);
-static void SetSegmentReMap(uint8 b127);
+IFX_INLINE void SetDisplayStartLine(SSD1306_Inst *panel, uint8 line);
+IFX_INLINE void SetSegmentReMap(SSD1306_Inst *panel, uint8 b127);
 /**
  * @brief Set MUX ratio to N+1 MUX
  * 
  * @param mux 
  */
-static void SetMultiplexRatio(uint8 mux);
-static void SetComOutputScanDirection(uint8 bRemap);
-static void SetDisplayOffset(uint8 com);
-static void SetComPinsHardwareConfig(uint8 config);
+IFX_INLINE void SetMultiplexRatio(SSD1306_Inst *panel, uint8 mux);
+IFX_INLINE void SetComOutputScanDirection(SSD1306_Inst *panel, uint8 bRemap);
+IFX_INLINE void SetDisplayOffset(SSD1306_Inst *panel, uint8 com);
+IFX_INLINE void SetComPinsHardwareConfig(SSD1306_Inst *panel, uint8 config);
 
 /*******************************************/
 /* Timing & Driving Scheme Setting Command */
@@ -99,10 +105,10 @@ static void SetComPinsHardwareConfig(uint8 config);
  * @param divRatio 
  * @param oscFreq 
  */
-static void SetDisplayClockRatioFreq(uint8 divRatio, uint8 oscFreq);
-static void SetPreChargePeriod(uint8 phase1, uint8 phase2);
-static void VcomhDeselectLevel(uint8 level);
-static void NOP_CMD(void);
+IFX_INLINE void SetDisplayClockRatioFreq(SSD1306_Inst *panel, uint8 divRatio, uint8 oscFreq);
+IFX_INLINE void SetPreChargePeriod(SSD1306_Inst *panel, uint8 phase1, uint8 phase2);
+IFX_INLINE void VcomhDeselectLevel(SSD1306_Inst *panel, uint8 level);
+IFX_INLINE void NOP_CMD(SSD1306_Inst *panel);
 
 /*******************************************/
 /*              Read Command               */
@@ -113,491 +119,982 @@ static void NOP_CMD(void);
  * 
  * @return uint8 1 for display OFF / 0 for display ON
  */
-static uint8 StatusRegisterRead(void);
+IFX_INLINE uint8 StatusRegisterRead(SSD1306_Inst *panel);
 
 
 /*******************************************/
 /*       Charge Pump Setting Command       */
 /*******************************************/
 
-static void ChargePumpSetting(uint8 bEnable);
+IFX_INLINE void ChargePumpSetting(SSD1306_Inst *panel, uint8 bEnable);
 
 /*******************************************/
 /*       I2C Communication Function        */
 /*******************************************/
-static void _SendData(SSD1306_Packet_T type, const uint8 *data, Ifx_SizeT size);
-static void _SendPacket(SSD1306_Packet_T type, const uint8 *packet, Ifx_SizeT size);
-static void _MakePacket(uint8 *buffer, SSD1306_Packet_T type, const uint8 *data, Ifx_SizeT size);
-
-static const Module_I2C_Config ssd1306_config = {
-    .p_i2c = &MODULE_I2C0,
-    .MCP_PINS = {
-        .scl = &IfxI2c0_SCL_P13_1_INOUT,
-        .sda = &IfxI2c0_SDA_P13_2_INOUT,
-        .padDriver = IfxPort_PadDriver_ttlSpeed1
+static void _SendData(SSD1306_Inst *panel, SSD1306_Packet_T type, const uint8 *data, Ifx_SizeT size);
+/**
+ * @brief Commands after _BeginCommandList are collected and sent as one command stream by _EndCommandList
+ */
+static void _BeginCommandList(SSD1306_Inst *panel);
+static void _EndCommandList(SSD1306_Inst *panel);
+static void _AppendCommandList(SSD1306_Inst *panel, const uint8 *cmd, Ifx_SizeT size);
+static void _SendCommandList(SSD1306_Inst *panel);
+/**
+ * @brief Single control byte with Co = 0, every following byte is data (Figure 8-7)
+ */
+static void _MakeStream(uint8 *buffer, SSD1306_Packet_T type, const uint8 *data, Ifx_SizeT size);
+/**
+ * @brief panel->txBuff is sent from the I2C interrupts, _GetTxBuff waits until the previous send is done
+ */
+static uint8 *_GetTxBuff(SSD1306_Inst *panel);
+static void _SendTxBuff(SSD1306_Inst *panel, Ifx_SizeT size);
+/**
+ * @brief PackBits decoder, stops at the end of src or when len bytes are written
+ * 
+ * @return Ifx_SizeT Bytes written to dst
+ */
+static Ifx_SizeT _UnpackBits(uint8 *dst, Ifx_SizeT len, const uint8 *src, Ifx_SizeT size);
+/**
+ * @brief Send a constant command stream (SSD1306_CMD_STREAM + command bytes) as it is, without copying it
+ */
+static void _SendCommandTable(SSD1306_Inst *panel, const uint8 *table, Ifx_SizeT size);
+/**
+ * @brief Queue packet on trans, *pBusy is cleared by callback. txTrans carries the txBuff / command tables, cmdTrans the command lists.
+ */
+static void _Submit(SSD1306_Inst *panel, Module_I2C_Transaction *trans, volatile boolean *pBusy, Module_I2C_Callback callback,
+                    const uint8 *packet, Ifx_SizeT size, boolean bDma);
+/**
+ * @brief Submit the transactions the full I2C queue refused, stops at the first one refused again
+ */
+static void _SubmitPending(SSD1306_Inst *panel);
+static Ifx_SizeT _UnpackBits(uint8 *dst, Ifx_SizeT len, const uint8 *src, Ifx_SizeT size)
+{
+    Ifx_SizeT in = 0;
+    Ifx_SizeT out = 0;
+
+    while (in < size && out < len) {
+        const sint8 header = (sint8)src[in++];
+        Ifx_SizeT count;
+
+        if (header >= 0) {                  /* header + 1 literal bytes */
+            count = header + 1;
+            if (count > size - in) count = size - in;
+            if (count > len - out) count = len - out;
+            memcpy(&dst[out], &src[in], count);
+            in += header + 1;
+        } else if (header != -128 && in < size) {   /* Next byte 1 - header times */
+            count = 1 - header;
+            if (count > len - out) count = len - out;
+            memset(&dst[out], src[in], count);
+            in++;
+        } else {
+            continue;
+        }
+        out += count;
+    }
+
+    return out;
+}
+
+static void _TxDone(IfxI2c_I2c_Status status, void *arg);
+
+static void _CmdDone(IfxI2c_I2c_Status status, void *arg);
+/**
+ * @brief Send the next changed run of frame from panel->diffPage / diffWord on (SSD1306_FlushDiff)
+ * 
+ * @return boolean FALSE if the frame is done, nothing was sent
+ */
+static boolean _DiffStep(SSD1306_Inst *panel, SSD1306_FrameBuffer *frame);
+static void _HandOver(SSD1306_Inst *panel);
+
+/* Panels on I2C0, the 128x32 one has SA0 = 0 */
+#define SSD1306_I2C0_CONFIG(sa0) {                                                      \
+    .p_i2c = &MODULE_I2C0,                                                              \
+    .MCP_PINS = {                                                                       \
+        .scl = &IfxI2c0_SCL_P13_1_INOUT,                                                \
+        .sda = &IfxI2c0_SDA_P13_2_INOUT,                                                \
+        .padDriver = IfxPort_PadDriver_ttlSpeed1                                        \
+    },                                                                                  \
+    .baudrate = SSD1306_I2C_BAUDRATE,                                                   \
+    .addr = GET_SSD1306_ADDR(sa0),                                                      \
+    .retry = {                                                                          \
+        .maxAttempts = 8,                   /* Panel absent: Give up after ~5ms instead of hanging the core */ \
+        .backoffUs = 50,                                                                \
+        .maxBackoffUs = 2000,                                                           \
+        .recoverAfter = 2                                                               \
+    },                                                                                  \
+    .priority = Module_I2C_Priority_LOW     /* Frames are long, sensors on the same bus go first */ \
+}
+
+const SSD1306_Config SSD1306_PanelConfig[SSD1306_PANEL_MAX] = {
+    {
+        .i2c = SSD1306_I2C0_CONFIG(SSD1306_ADDR_128_64),
+        .geometry = SSD1306_Geometry_128_64,
+        .dmaChannel = (IfxDma_ChannelId)DMA_CHANNEL_I2C0_TX
     },
-    .baudrate = SSD1306_I2C_BAUDRATE,
-    .addr = GET_SSD1306_ADDR(SSD1306_ADDR_128_64)
+    {
+        .i2c = SSD1306_I2C0_CONFIG(SSD1306_ADDR_128_32),
+        .geometry = SSD1306_Geometry_128_32,
+        .dmaChannel = (IfxDma_ChannelId)DMA_CHANNEL_I2C0_TX
+    }
 };
 
-static Module_I2C_Inst ssd1306_inst;
+/* Fixed command streams, built by the preprocessor and kept in flash */
+#define SSD1306_INIT_CMD(mux, comPins)                                                  \
+    SSD1306_CMD_STREAM,                                                                 \
+    SSD1306_CMD_ADDRESSING_MODE(SSD1306_ADDRESSING_HORIZONTAL), /* Window is set once per blit, not per page */ \
+    SSD1306_CMD_MUX_RATIO(mux),             /* mux+1 MUX = Rows of the panel */         \
+    SSD1306_CMD_DISPLAY_OFFSET(0x00),       /* Set Vertical shift by Com from 0*/       \
+    SSD1306_CMD_START_LINE(0x00),           /* Set display RAM display start register from 0 */ \
+    SSD1306_CMD_SEG_REMAP(1),               /* column address 127 is mapped to SEG0 (Figure 4-1) */ \
+    SSD1306_CMD_COM_SCAN(1),                /* Normal mode - Scan from COM[N-1] to COM[0]. N is the Multiplex Ratio */ \
+    SSD1306_CMD_COM_PINS(comPins),          /* 1: Alternative / 0: Sequential COM pin configuration */ \
+    SSD1306_CMD_CONTRAST(0x7F),             /* Contrast = 0x7F */                       \
+    SSD1306_CMD_ENTIRE_ON(0),               /* Resume to RAM content display. Output follows RAM content */ \
+    SSD1306_CMD_INVERSE(0),                 /* Normal display */                        \
+    SSD1306_CMD_CLOCK(0x0, 0x8),            /* divide ratio of the display clocks = 0, Oscilator Frequency = 0x8 */ \
+    SSD1306_CMD_CHARGE_PUMP(1),             /* Enable charge pump during display on */  \
+    SSD1306_CMD_DISPLAY_ON(1)               /* Display On in normal mode */
+
+static const uint8 ssd1306_initCmd[] = {
+    SSD1306_INIT_CMD(0x3F, 1)               /* 128x64 */
+};
+static const uint8 ssd1306_initCmd32[] = {
+    SSD1306_INIT_CMD(0x1F, 0)               /* 128x32 */
+};
+static const uint8 ssd1306_fullWindowCmd[] = {
+    SSD1306_CMD_STREAM,
+    SSD1306_CMD_COLUMN_ADDR(0, SSD1306_MAX_SEG - 1),
+    SSD1306_CMD_PAGE_ADDR(0, SSD1306_MAX_PAGE - 1)
+};
+static const uint8 ssd1306_powerOnCmd[] = {
+    SSD1306_CMD_STREAM,
+    SSD1306_CMD_CHARGE_PUMP(1),
+    SSD1306_CMD_DISPLAY_ON(1)
+};
+static const uint8 ssd1306_powerOffCmd[] = {
+    SSD1306_CMD_STREAM,
+    SSD1306_CMD_DISPLAY_ON(0),
+    SSD1306_CMD_CHARGE_PUMP(0)
+};
 
-static void _SetPixel(uint8 *buffer, uint8 x, uint8 y, uint8 bValue)
+void Init_SSD1306(SSD1306_Inst *panel, const SSD1306_Config *config)
 {
-    const uint8 page = y / 8;
-    const uint8 seg = x;
-    const uint8 byte = y % 8;
+    const uint32 initStart = IfxStm_getLower(&MODULE_STM0);
+
+    /* Double buffer is left as it is: The render core draws only after this returns */
+    panel->config = config;
+    panel->txBuff = &panel->txFrame[MODULE_I2C_DMA_HEADROOM];
+    panel->pageLen = (config->geometry == SSD1306_Geometry_128_64) ? SSD1306_MAX_PAGE : (SSD1306_MAX_PAGE / 2);
+    panel->cmdList.bActive = FALSE;
+    panel->bTxBusy = FALSE;
+    panel->bCmdBusy = FALSE;
+    panel->bShadowValid = FALSE;
+    panel->pendingLen = 0;
+    panel->diffPage = 0;
+    panel->diffWord = 0;
+    memset(&panel->stats, 0, sizeof(panel->stats));
+
+    /* The second panel on a bus only adds its device, interrupts and DMA are there already */
+    Init_I2C(&panel->i2c, &config->i2c);
+    Init_I2C_Async(&panel->i2c);
+    Init_I2C_Dma(&panel->i2c, config->dmaChannel);
+
+    _DafaultSoftwareInit(panel);
+    SSD1306_ClearDisplay(panel);
+    panel->stats.initTicks = IfxStm_getLower(&MODULE_STM0) - initStart;
+}
 
-    *(buffer + (SSD1306_MAX_SEG * page) + seg) |= (0x01 & bValue) << byte;
+void SSD1306_SetDisplay(SSD1306_Inst *panel, uint8 *buff, uint8 startPage, uint8 pageLen, uint8 startColumn, uint8 columnLen)
+{
+    SSD1306_Blit(panel, buff + (startPage * columnLen), columnLen, startPage, pageLen, startColumn, columnLen);
 }
 
-static void _SetDisplay(uint8 *buffer, uint8 *data)
+
+void SSD1306_ClearDisplay(SSD1306_Inst *panel)
 {
-    int x = 0;
-    int y = 0;
-    for (int i=0; i < 128 * 64 * 8; i++) {
-        _SetPixel(buffer, x, y, data[i / 8] >> i % 8);
-        x++;
-        if (x >= 128 * 8) {
-            x = 0;
-            y++;
-        }
+    uint8 *txBuff;
+
+    /* Whole GDDRAM also on a 128x32 panel: The rows below it come in with the start line */
+    _SendCommandTable(panel, ssd1306_fullWindowCmd, sizeof(ssd1306_fullWindowCmd));
+    txBuff = _GetTxBuff(panel);
+    memset(txBuff, 0, SSD1306_STREAM_BUFF_MAX);
+    txBuff[0] = (0x00 | (SSD1306_Packet_DATA << 6));
+    _SendTxBuff(panel, SSD1306_STREAM_BUFF_MAX);
+    memset(panel->shadow, 0, sizeof(panel->shadow));
+    panel->bShadowValid = TRUE;
+}
+
+void SSD1306_Blit(SSD1306_Inst *panel, const uint8 *buff, uint16 stride, uint8 startPage, uint8 pageLen, uint8 startColumn, uint8 columnLen)
+{
+    uint8 *txBuff;
+    uint8 *pDst;
+
+    if (startPage >= SSD1306_MAX_PAGE || startColumn >= SSD1306_MAX_SEG || pageLen == 0 || columnLen == 0) {
+        return;
+    }
+    if (startPage + pageLen > SSD1306_MAX_PAGE) {
+        pageLen = SSD1306_MAX_PAGE - startPage;
     }
+    if (startColumn + columnLen > SSD1306_MAX_SEG) {
+        columnLen = SSD1306_MAX_SEG - startColumn;
+    }
+
+    SetWindow(panel, startPage, startPage + pageLen - 1, startColumn, startColumn + columnLen - 1);
+
+    /* The column pointer wraps to startColumn and moves to the next page at the end of the window */
+    txBuff = _GetTxBuff(panel);
+    txBuff[0] = (0x00 | (SSD1306_Packet_DATA << 6));
+    pDst = &txBuff[1];
+    for (int i = 0; i < pageLen; i++) {
+        memcpy(pDst, buff + (i * stride), columnLen);
+        memcpy(&panel->shadow[startPage + i][startColumn], pDst, columnLen);
+        pDst += columnLen;
+    }
+    _SendTxBuff(panel, (pageLen * columnLen) + 1);
 }
 
-static void TestDisplay(void)
-{
-    uint8 x = 0;
-    uint8 y = 0;
-    uint8 value = 1;
-
-#if 1
-    uint8 data[SSD1306_MAX_PAGE * SSD1306_I2C_BUFF_MAX] = {0};
-    const uint8 Charmander[] = {
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf1, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf1, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf1, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0x80, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xfe, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xe0, 0x7f, 0xff, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0x1f, 0xff, 0xff, 0xfc, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xf8, 0xff, 0xff, 0xff, 0xfc, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xf8, 0xff, 0xff, 0xff, 0xff, 0x8f, 0xff, 0xff, 0xff, 0xff, 0xe3, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x8f, 0xff, 0xff, 0xff, 0xff, 0xe3, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xc7, 0xff, 0xff, 0xf8, 0xff, 0x8f, 0xff, 0xff, 0xff, 0xff, 0xe3, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xc7, 0xff, 0xff, 0xc7, 0xff, 0x81, 0xff, 0xff, 0xff, 0xff, 0xe3, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xc7, 0xff, 0xff, 0xc7, 0xff, 0x81, 0xff, 0xff, 0xff, 0xff, 0xe3, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xc0, 0xff, 0xff, 0xc7, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0x1f, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xc0, 0xff, 0xff, 0xf8, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x8f, 0xff, 0xff, 
-0xff, 0xff, 0xc0, 0xff, 0xff, 0xf8, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x8f, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0x1c, 0x70, 0x3f, 0xff, 
-0xff, 0xff, 0xc7, 0xff, 0xff, 0xff, 0x1c, 0x01, 0xff, 0xff, 0xff, 0xf8, 0x1f, 0xfe, 0x3f, 0xff, 
-0xff, 0xff, 0xc7, 0xff, 0xff, 0xff, 0x1c, 0x01, 0xff, 0xff, 0xff, 0xf8, 0x1f, 0xfe, 0x3f, 0xff, 
-0xff, 0xfe, 0x07, 0xff, 0xff, 0xf8, 0x1c, 0x01, 0xff, 0xff, 0xff, 0xf8, 0xff, 0xfe, 0x3f, 0xff, 
-0xff, 0xfe, 0x3f, 0xff, 0xff, 0xff, 0x00, 0x01, 0xff, 0xff, 0xff, 0xf8, 0xff, 0xfe, 0x3f, 0xff, 
-0xff, 0xfe, 0x3f, 0xff, 0xff, 0xff, 0x00, 0x01, 0xff, 0xff, 0xff, 0xf8, 0xff, 0xfe, 0x3f, 0xff, 
-0xff, 0xfe, 0x3f, 0xfc, 0x7f, 0xf8, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xe3, 0xfe, 0x07, 0xff, 
-0xff, 0xff, 0xc7, 0xff, 0xff, 0xc0, 0x00, 0x00, 0x3f, 0xff, 0xff, 0xf8, 0xff, 0xfe, 0x07, 0xff, 
-0xff, 0xff, 0xc7, 0xff, 0xff, 0xc0, 0x00, 0x00, 0x3f, 0xff, 0xff, 0xf8, 0xff, 0xfe, 0x07, 0xff, 
-0xff, 0xff, 0xc0, 0xff, 0xf0, 0x07, 0x00, 0x00, 0x38, 0x1f, 0xff, 0xf8, 0x1f, 0xfe, 0x07, 0xff, 
-0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x07, 0xff, 
-0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x07, 0xff, 
-0xff, 0x81, 0xff, 0x00, 0x00, 0x00, 0x00, 0x01, 0xf8, 0x1f, 0xff, 0xff, 0xe0, 0x00, 0x3f, 0xff, 
-0xff, 0x80, 0x00, 0x00, 0x7e, 0x00, 0xe0, 0x7f, 0xf8, 0x03, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 
-0xff, 0x80, 0x00, 0x00, 0x7e, 0x00, 0xe0, 0x7f, 0xf8, 0x03, 0xff, 0xff, 0xfc, 0x01, 0xff, 0xff, 
-0xff, 0x81, 0xff, 0xe0, 0x00, 0x3f, 0xfc, 0x7e, 0x00, 0x1f, 0xff, 0xff, 0xff, 0xfe, 0x3f, 0xff, 
-0xfc, 0x01, 0xff, 0xe0, 0x01, 0xff, 0xfc, 0x7e, 0x07, 0xff, 0xff, 0xff, 0xfc, 0x7c, 0x3f, 0xff, 
-0xfc, 0x00, 0x07, 0xe0, 0x01, 0xff, 0xfc, 0x00, 0x07, 0xff, 0xff, 0xff, 0xfc, 0x70, 0x3f, 0xff, 
-0xff, 0x80, 0x00, 0x00, 0x0f, 0xff, 0xfc, 0x00, 0x00, 0xff, 0xff, 0xff, 0x03, 0x81, 0xff, 0xff, 
-0xff, 0xfe, 0x00, 0x00, 0x0f, 0xff, 0xfc, 0x00, 0x00, 0x1f, 0xff, 0xff, 0x03, 0xf1, 0xff, 0xff, 
-0xff, 0xfe, 0x00, 0x00, 0x0f, 0xff, 0xfc, 0x01, 0xf8, 0x1f, 0xff, 0xf8, 0xff, 0xf1, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0x00, 0x0f, 0xff, 0xff, 0xff, 0xff, 0x1f, 0xfe, 0x07, 0xfc, 0x71, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0x00, 0x0f, 0xff, 0xff, 0xff, 0xff, 0x1f, 0xfe, 0x07, 0xff, 0xf1, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xfc, 0x7f, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x80, 0x3f, 0xe3, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xfc, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x1f, 0x8f, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xfc, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xe0, 0x00, 0x07, 0xff, 0x0f, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0x8f, 0xff, 0xff, 0xfe, 0x3f, 0xe0, 0x00, 0x07, 0xfc, 0x7f, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0x8f, 0xff, 0xff, 0xfe, 0x3f, 0xfc, 0x00, 0x07, 0x03, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0x3f, 0xfc, 0x0f, 0xff, 0x03, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xfc, 0x71, 0xff, 0xff, 0xf0, 0x3f, 0xfc, 0x0f, 0xff, 0x1f, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xe3, 0xf1, 0xff, 0xff, 0xf1, 0xff, 0xff, 0x81, 0xf8, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xe3, 0xf1, 0xff, 0xff, 0xf1, 0xff, 0xff, 0x81, 0xf8, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xe3, 0xfe, 0x3f, 0xff, 0xf1, 0xff, 0xfc, 0x00, 0x07, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xe3, 0xff, 0xc7, 0xff, 0xf0, 0x3f, 0xe0, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xe3, 0xff, 0xc7, 0xff, 0xf0, 0x3f, 0xe0, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xfc, 0x7e, 0x00, 0x1f, 0xf0, 0x00, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xe0, 0x00, 0x00, 0xff, 0xff, 0xc7, 0xfc, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0x1c, 0x70, 0x07, 0xff, 0xff, 0xc0, 0xff, 0x81, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0x1c, 0x70, 0x07, 0xff, 0xff, 0xc0, 0xff, 0x81, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xe0, 0x00, 0x3f, 0xff, 0xff, 0xf8, 0xe3, 0x8e, 0x3f, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 
-0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
-    };
-    _SetDisplay(data, Charmander);
-    SSD1306_SetDisplay(data, 0, SSD1306_MAX_PAGE, 0, SSD1306_MAX_SEG);
-#else
-    while (1) {
-        uint8 data[SSD1306_MAX_PAGE * SSD1306_I2C_BUFF_MAX] = {0};
-#if 0
-        _SetPixel(data, x, y, value);
-        SSD1306_SetDisplay(data, 0, SSD1306_MAX_PAGE, 0, SSD1306_MAX_SEG);
-#else
-    for (int j = 0; j < 128; j++) {
-        for (int i = 0; i < 64; i++) {
-            _SetPixel(data, j, i, value);
-            if (i%16 == 0) {
-                SSD1306_SetDisplay(data, 0, SSD1306_MAX_PAGE, 0, SSD1306_MAX_SEG);
+void SSD1306_DrawImage(SSD1306_Inst *panel, const SSD1306_Image *image, uint8 startPage, uint8 startColumn)
+{
+    const Ifx_SizeT len = image->pageLen * image->columnLen;
+    uint8 *txBuff;
+    Ifx_SizeT n;
+
+    if (len == 0 || startPage + image->pageLen > SSD1306_MAX_PAGE || startColumn + image->columnLen > SSD1306_MAX_SEG) {
+        return;
+    }
+
+    SetWindow(panel, startPage, startPage + image->pageLen - 1, startColumn, startColumn + image->columnLen - 1);
+
+    /* Decoded straight into the I2C stream, the window is filled in the same order */
+    txBuff = _GetTxBuff(panel);
+    txBuff[0] = (0x00 | (SSD1306_Packet_DATA << 6));
+    n = _UnpackBits(&txBuff[1], len, image->data, image->size);
+    memset(&txBuff[1 + n], 0, len - n);     /* Short stream: Rest is blank */
+    for (int i = 0; i < image->pageLen; i++) {
+        memcpy(&panel->shadow[startPage + i][startColumn], &txBuff[1 + (i * image->columnLen)], image->columnLen);
+    }
+    _SendTxBuff(panel, len + 1);
+}
+
+void SSD1306_ImportImage(uint8 *buff, const uint8 *image, uint8 flags)
+{
+    const uint32 inv = (flags & SSD1306_IMAGE_INVERT) ? 0xFFFFFFFF : 0;
+    const boolean bMirror = (flags & SSD1306_IMAGE_MIRROR) ? TRUE : FALSE;
+    /* LSB first and mirroring both reverse the columns of a block, together they cancel */
+    const boolean bReverse = bMirror ^ ((flags & SSD1306_IMAGE_LSB_FIRST) ? TRUE : FALSE);
+
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        const uint8 *pRow = image + (page * 8 * SSD1306_IMAGE_STRIDE);
+
+        for (int block = 0; block < SSD1306_IMAGE_STRIDE; block++) {
+            const uint8 *p = pRow + block;
+            uint8 *pDst = buff + (page * SSD1306_MAX_SEG) + ((bMirror ? (SSD1306_IMAGE_STRIDE - 1 - block) : block) * 8);
+            uint32 x;
+            uint32 y;
+            uint32 t;
+
+            /* Row 7 in the MSB of x: after the transpose byte j of x:y holds column j with row r in bit r */
+            x = ((uint32)p[7 * SSD1306_IMAGE_STRIDE] << 24) | ((uint32)p[6 * SSD1306_IMAGE_STRIDE] << 16) |
+                ((uint32)p[5 * SSD1306_IMAGE_STRIDE] << 8) | (uint32)p[4 * SSD1306_IMAGE_STRIDE];
+            y = ((uint32)p[3 * SSD1306_IMAGE_STRIDE] << 24) | ((uint32)p[2 * SSD1306_IMAGE_STRIDE] << 16) |
+                ((uint32)p[1 * SSD1306_IMAGE_STRIDE] << 8) | (uint32)p[0];
+            x ^= inv;
+            y ^= inv;
+
+            /* Hacker's Delight 7-3: swap 1x1, 2x2, then 4x4 sub-blocks */
+            t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+            t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+            t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+            t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+            t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+            y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+            x = t;
+
+            if (bReverse) {
+                pDst[7] = (uint8)(x >> 24); pDst[6] = (uint8)(x >> 16); pDst[5] = (uint8)(x >> 8); pDst[4] = (uint8)x;
+                pDst[3] = (uint8)(y >> 24); pDst[2] = (uint8)(y >> 16); pDst[1] = (uint8)(y >> 8); pDst[0] = (uint8)y;
+            } else {
+                pDst[0] = (uint8)(x >> 24); pDst[1] = (uint8)(x >> 16); pDst[2] = (uint8)(x >> 8); pDst[3] = (uint8)x;
+                pDst[4] = (uint8)(y >> 24); pDst[5] = (uint8)(y >> 16); pDst[6] = (uint8)(y >> 8); pDst[7] = (uint8)y;
             }
         }
     }
-#endif
+}
+
+void SSD1306_InitFrame(SSD1306_FrameBuffer *frame)
+{
+    memset(frame->buff, 0, sizeof(frame->buff));
+    for (int i = 0; i < SSD1306_MAX_PAGE; i++) {
+        frame->dirtyStart[i] = 0;
+        frame->dirtyEnd[i] = SSD1306_MAX_SEG;
+    }
+}
+
+void SSD1306_MarkDirty(SSD1306_FrameBuffer *frame, uint8 page, uint8 startColumn, uint8 columnLen)
+{
+    uint16 endColumn = startColumn + columnLen;
+
+    if (page >= SSD1306_MAX_PAGE || startColumn >= SSD1306_MAX_SEG || columnLen == 0) {
+        return;
+    }
+    if (endColumn > SSD1306_MAX_SEG) {
+        endColumn = SSD1306_MAX_SEG;
+    }
+
+    if (frame->dirtyStart[page] >= frame->dirtyEnd[page]) {
+        frame->dirtyStart[page] = startColumn;
+        frame->dirtyEnd[page] = (uint8)endColumn;
+    } else {
+        if (startColumn < frame->dirtyStart[page]) frame->dirtyStart[page] = startColumn;
+        if (endColumn > frame->dirtyEnd[page]) frame->dirtyEnd[page] = (uint8)endColumn;
     }
-#endif
 }
 
-void Init_SSD1306(void)
+void SSD1306_SetPixel(SSD1306_FrameBuffer *frame, uint8 x, uint8 y, uint8 bValue)
 {
-    Init_I2C(&ssd1306_inst, &ssd1306_config);
+    const uint8 page = y / 8;
+    const uint8 mask = 0x01 << (y % 8);
+    uint8 *pByte;
+    uint8 value;
 
-    _DafaultSoftwareInit();
-    SSD1306_ClearDisplay();
-    TestDisplay();
+    if (x >= SSD1306_MAX_SEG || page >= SSD1306_MAX_PAGE) {
+        return;
+    }
+
+    pByte = &frame->buff[page][x];
+    value = (bValue & 0x01) ? (*pByte | mask) : (*pByte & ~mask);
+    if (value != *pByte) {                  /* Unchanged pixels never reach the bus */
+        *pByte = value;
+        SSD1306_MarkDirty(frame, page, x, 1);
+    }
 }
 
-void SSD1306_SetDisplay(uint8 *buff, uint8 startPage, uint8 pageLen, uint8 startColumn, uint8 columnLen)
+void SSD1306_Flush(SSD1306_Inst *panel, SSD1306_FrameBuffer *frame)
 {
-    const int endPage = startPage + pageLen;
+    int i = 0;
+
+    while (i < SSD1306_MAX_PAGE) {
+        uint8 start = frame->dirtyStart[i];
+        uint8 end = frame->dirtyEnd[i];
+        int last = i;
+
+        if (start >= end) {
+            i++;
+            continue;
+        }
+
+        /* Grow the window over the next dirty page while the extra columns are cheaper than another window */
+        while ((last + 1) < SSD1306_MAX_PAGE && frame->dirtyStart[last + 1] < frame->dirtyEnd[last + 1]) {
+            const uint8 nStart = frame->dirtyStart[last + 1];
+            const uint8 nEnd = frame->dirtyEnd[last + 1];
+            const uint8 mStart = (nStart < start) ? nStart : start;
+            const uint8 mEnd = (nEnd > end) ? nEnd : end;
+            const int pages = last - i + 1;
+
+            if ((mEnd - mStart) * (pages + 1) > ((end - start) * pages) + (nEnd - nStart) + SSD1306_WINDOW_OVERHEAD) {
+                break;
+            }
+            start = mStart;
+            end = mEnd;
+            last++;
+        }
+
+        SSD1306_Blit(panel, &frame->buff[i][start], SSD1306_MAX_SEG, i, last - i + 1, start, end - start);
 
-    for (int i = startPage; i < endPage; i++) {
-        SetPageAndColumnPosition(i, startColumn);
-        _SendData(SSD1306_Packet_DATA, (buff + (i * columnLen)), columnLen);
+        for (; i <= last; i++) {
+            frame->dirtyStart[i] = SSD1306_MAX_SEG;
+            frame->dirtyEnd[i] = 0;
+        }
     }
 }
 
+void SSD1306_FlushDiff(SSD1306_Inst *panel, SSD1306_FrameBuffer *frame)
+{
+    panel->diffPage = 0;
+    panel->diffWord = 0;
+    while (_DiffStep(panel, frame));
+}
 
-void SSD1306_ClearDisplay(void)
+SSD1306_FrameBuffer *SSD1306_GetBackFrame(SSD1306_Inst *panel)
 {
-    uint8 data[SSD1306_I2C_BUFF_MAX] = {0};
+    return &panel->frames[panel->backIndex];
+}
 
-    SetPageAndColumnPosition(0, 0);
+/* frameLock held, front not FLUSHING: The back frame becomes the POSTED front */
+static void _HandOver(SSD1306_Inst *panel)
+{
+    SSD1306_FrameBuffer *front = &panel->frames[panel->backIndex];
+    SSD1306_FrameBuffer *back = &panel->frames[panel->backIndex ^ 1];
+
+    /* Next frame is drawn over this one, only what changes from now on is dirty */
+    memcpy(back->buff, front->buff, sizeof(back->buff));
     for (int i = 0; i < SSD1306_MAX_PAGE; i++) {
-        SetPageStartForPageMode(i);
-        _SendData(SSD1306_Packet_DATA, data, SSD1306_MAX_SEG);
+        back->dirtyStart[i] = SSD1306_MAX_SEG;
+        back->dirtyEnd[i] = 0;
+    }
+    panel->backIndex ^= 1;
+    __dsync();                              /* Frame data before the state */
+    panel->frontState = SSD1306_Front_POSTED;
+}
+
+void SSD1306_SwapFrame(SSD1306_Inst *panel)
+{
+    /* The flush core reads the old front until it is IDLE again: Frame rate is set by the bus */
+    while (panel->frontState != SSD1306_Front_IDLE);
+
+    IfxCpu_setSpinLock(&panel->frameLock, 0xFFFF);
+    _HandOver(panel);
+    IfxCpu_resetSpinLock(&panel->frameLock);
+}
+
+boolean SSD1306_PostFrame(SSD1306_Inst *panel)
+{
+    boolean bPosted = FALSE;
+
+    IfxCpu_setSpinLock(&panel->frameLock, 0xFFFF);
+    if (panel->frontState == SSD1306_Front_FLUSHING) {
+        panel->stats.refused++;             /* Its changes go with the next post */
+    } else {
+        if (panel->frontState == SSD1306_Front_POSTED) {
+            panel->stats.merged++;          /* Not taken yet: Replaced by this one */
+        }
+        _HandOver(panel);
+        bPosted = TRUE;
+    }
+    IfxCpu_resetSpinLock(&panel->frameLock);
+
+    return bPosted;
+}
+
+boolean SSD1306_StartFrame(SSD1306_Inst *panel)
+{
+    boolean bStarted = FALSE;
+
+    if (panel->frontState != SSD1306_Front_POSTED) {
+        return FALSE;
+    }
+
+    /* From here on the render core does not touch the front, backIndex stays until it is IDLE */
+    IfxCpu_setSpinLock(&panel->frameLock, 0xFFFF);
+    if (panel->frontState == SSD1306_Front_POSTED) {
+        panel->frontState = SSD1306_Front_FLUSHING;
+        panel->diffPage = 0;
+        panel->diffWord = 0;
+        bStarted = TRUE;
+    }
+    IfxCpu_resetSpinLock(&panel->frameLock);
+
+    return bStarted;
+}
+
+boolean SSD1306_FlushStep(SSD1306_Inst *panel)
+{
+    _SubmitPending(panel);
+
+    /* Last run still queued: Serve the other panels instead of waiting for it */
+    if (panel->frontState != SSD1306_Front_FLUSHING || panel->bTxBusy || panel->bCmdBusy) {
+        return FALSE;
+    }
+
+    if (_DiffStep(panel, &panel->frames[panel->backIndex ^ 1])) {
+        return FALSE;
     }
+
+    panel->stats.frames++;
+    panel->frontState = SSD1306_Front_IDLE;
+    return TRUE;
 }
 
-static void SetPageAndColumnPosition(uint8 page, uint8 column)
+boolean SSD1306_FlushFrame(SSD1306_Inst *panel)
 {
-    SetPageStartForPageMode(page);
-    SetLowColStartAddrPageMode(0x0F&column);
-    SetHighColStartAddrPageMode(0x0F&(column >> 4));
+    if (SSD1306_StartFrame(panel) == FALSE) {
+        return FALSE;
+    }
+
+    /* The windows are copied into the txBuff, the front is free when SSD1306_FlushDiff returns */
+    SSD1306_FlushDiff(panel, &panel->frames[panel->backIndex ^ 1]);
+    panel->stats.frames++;
+    panel->frontState = SSD1306_Front_IDLE;
+    return TRUE;
 }
 
-static void _DafaultSoftwareInit(void)
+boolean SSD1306_FlushPanels(SSD1306_Inst *panels, uint8 count)
 {
-    SetMultiplexRatio(0x3F);                /* 63+1 = 64 MUX*/
-    SetDisplayOffset(0x00);                 /* Set Vertical shift by Com from 0*/
-    SetDisplayStartLine(0x00);              /* Set display RAM display start register from 0 */
-#if 0
-    SetSegmentReMap(0);                     /* column address 0 is mapped to SEG0 */
-    SetComOutputScanDirection(0);           /* Normal mode - Scan from COM[0] to COM[N-1]. N is the Multiplex Ratio */
-    SetComPinsHardwareConfig(0);            /* Sequential COM pin configuration */
-#else   /* Figure 4-1 */
-    SetSegmentReMap(1);                     /* column address 127 is mapped to SEG0 */
-    SetComOutputScanDirection(1);           /* Normal mode - Scan from COM[N-1] to COM[0]. N is the Multiplex Ratio */
-    SetComPinsHardwareConfig(1);            /* Alternative COM pin configuration */
-#endif
-    SetContrastControl(0x7F);               /* Contrast = 0x7F */
-    EntireDisplayOn(0);                     /* Resume to RAM content display. Output follows RAM content */
-    SetNormalInverseDisplay(0);             /* Normal display */
-    SetDisplayClockRatioFreq(0x0, 0x8);     /* divide ratio of the display clocks = 0, Oscilator Frequency = 0x8 */
-    ChargePumpSetting(1);                   /* Enable charge pump during display on */
-    SetDisplayOnOff(1);                     /* Display On in normal mode */
+    boolean bDone = FALSE;
+
+    for (int i = 0; i < count; i++) {
+        SSD1306_StartFrame(&panels[i]);
+        if (SSD1306_FlushStep(&panels[i])) {
+            bDone = TRUE;
+        }
+    }
+
+    return bDone;
 }
 
-static void SetContrastControl(uint8 value)
+void SSD1306_SetPower(SSD1306_Inst *panel, uint8 bOn)
 {
-    uint8 cmd[2] = {0x81, value};
+    if (bOn) {
+        _SendCommandTable(panel, ssd1306_powerOnCmd, sizeof(ssd1306_powerOnCmd));
+    } else {
+        _SendCommandTable(panel, ssd1306_powerOffCmd, sizeof(ssd1306_powerOffCmd));
+    }
+}
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 2);
+void SSD1306_StartHorizontalScroll(SSD1306_Inst *panel, uint8 bLeft, uint8 startPage, uint8 endPage, uint8 interval)
+{
+    panel->bShadowValid = FALSE;            /* GDDRAM has to be rewritten after the scroll */
+    _BeginCommandList(panel);
+    DeactivateScroll(panel);                /* 0x2E must come before the scroll parameters are changed */
+    ContinuousHorizontalScrollSetup(panel, bLeft, startPage, interval, endPage);
+    ActivateScroll(panel);
+    _EndCommandList(panel);
 }
 
-static void EntireDisplayOn(uint8 bIgCon)
+void SSD1306_StopScroll(SSD1306_Inst *panel)
 {
-    uint8 cmd[1] = {(0xA4 | (0x01 & bIgCon))};
+    DeactivateScroll(panel);
+}
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+void SSD1306_SetStartLine(SSD1306_Inst *panel, uint8 line)
+{
+    SetDisplayStartLine(panel, line);
 }
 
-static void SetNormalInverseDisplay(uint8 bInverse)
+void SSD1306_GetStats(SSD1306_Inst *panel, SSD1306_Stats *stats)
 {
-    uint8 cmd[1] = {(0xA6 | (0x01 & bInverse))};
+    *stats = panel->stats;
+}
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+void SSD1306_ResetStats(SSD1306_Inst *panel)
+{
+    /* merged / refused are counted by SSD1306_PostFrame on the render core */
+    IfxCpu_setSpinLock(&panel->frameLock, 0xFFFF);
+    panel->stats.txBytes = 0;
+    panel->stats.txTransactions = 0;
+    panel->stats.frames = 0;
+    panel->stats.merged = 0;
+    panel->stats.refused = 0;
+    panel->stats.dropped = 0;
+    IfxCpu_resetSpinLock(&panel->frameLock);
 }
 
-static void SetDisplayOnOff(uint8 bOn)
+IFX_INLINE void SetPageAndColumnPosition(SSD1306_Inst *panel, uint8 page, uint8 column)
 {
-    uint8 cmd[1] = {(0xAE | (0x01 & bOn))};
+    SetPageStartForPageMode(panel, page);
+    SetLowColStartAddrPageMode(panel, 0x0F&column);
+    SetHighColStartAddrPageMode(panel, 0x0F&(column >> 4));
+}
+
+IFX_INLINE void SetWindow(SSD1306_Inst *panel, uint8 startPage, uint8 endPage, uint8 startColumn, uint8 endColumn)
+{
+    _BeginCommandList(panel);
+    SetComlumnAddress(panel, startColumn, endColumn);
+    SetPageAddress(panel, startPage, endPage);
+    _EndCommandList(panel);
+}
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+static void _DafaultSoftwareInit(SSD1306_Inst *panel)
+{
+    /* Constant tables, Test_CommandTable checks them against the builders */
+    if (panel->config->geometry == SSD1306_Geometry_128_64) {
+        _SendCommandTable(panel, ssd1306_initCmd, sizeof(ssd1306_initCmd));
+    } else {
+        _SendCommandTable(panel, ssd1306_initCmd32, sizeof(ssd1306_initCmd32));
+    }
 }
 
-static void ContinuousHorizontalScrollSetup(uint8 bLHS, uint8 spg, uint8 interval, uint8 epg)
+IFX_INLINE void SetContrastControl(SSD1306_Inst *panel, uint8 value)
 {
-    uint8 cmd[7] = {
-            (0x26 | (0x01 & bLHS)),
-            (0x00),
-            (0x07 & spg),
-            (0x07 & interval),
-            (0x07 & epg),
-            (0x00),
-            (0xFF)
-        };
+    const uint8 cmd[2] = {SSD1306_CMD_CONTRAST(value)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 7);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 2);
 }
 
-static void ContinuousVerticalAndHorizontalScrollSetup(uint8 VLHS, uint8 spg, uint8 interval, uint8 epg, uint8 vOffset)
+IFX_INLINE void EntireDisplayOn(SSD1306_Inst *panel, uint8 bIgCon)
 {
-    uint8 cmd[6] = {
-            (0x28 | (0x03 & VLHS)),
-            (0x00),
-            (0x07 & spg),
-            (0x07 & interval),
-            (0x07 & epg),
-            (0x3F & vOffset)
-        };
+    const uint8 cmd[1] = {SSD1306_CMD_ENTIRE_ON(bIgCon)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 6);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void DeactivateScroll(void)
+IFX_INLINE void SetNormalInverseDisplay(SSD1306_Inst *panel, uint8 bInverse)
 {
-    uint8 cmd[1] = {0x2E};
+    const uint8 cmd[1] = {SSD1306_CMD_INVERSE(bInverse)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void ActivateScroll(void)
+IFX_INLINE void SetDisplayOnOff(SSD1306_Inst *panel, uint8 bOn)
 {
-    uint8 cmd[1] = {0x2F};
+    const uint8 cmd[1] = {SSD1306_CMD_DISPLAY_ON(bOn)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void SetVerticalScrollArea(uint8 fixedRows, uint8 scrollRows)
+IFX_INLINE void ContinuousHorizontalScrollSetup(SSD1306_Inst *panel, uint8 bLHS, uint8 spg, uint8 interval, uint8 epg)
 {
-    uint8 cmd[3] = {
-            (0xA3),
-            (0x3F & fixedRows),
-            (0x7F & scrollRows)
-        };
+    const uint8 cmd[7] = {SSD1306_CMD_H_SCROLL(bLHS, spg, interval, epg)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 3);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 7);
 }
 
-static void SetLowColStartAddrPageMode(uint8 nibble)
+IFX_INLINE void ContinuousVerticalAndHorizontalScrollSetup(SSD1306_Inst *panel, uint8 VLHS, uint8 spg, uint8 interval, uint8 epg, uint8 vOffset)
 {
-    uint8 cmd[1] = {(0x00 | (0x0F & nibble))};
+    const uint8 cmd[6] = {SSD1306_CMD_VH_SCROLL(VLHS, spg, interval, epg, vOffset)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 6);
 }
 
-static void SetHighColStartAddrPageMode(uint8 nibble)
+IFX_INLINE void DeactivateScroll(SSD1306_Inst *panel)
 {
-    uint8 cmd[1] = {(0x10 | (0x0F & nibble))};
+    const uint8 cmd[1] = {SSD1306_CMD_DEACTIVATE_SCROLL};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void SetMemoryAddressingMode(uint8 mode)
+IFX_INLINE void ActivateScroll(SSD1306_Inst *panel)
 {
-    uint8 cmd[2] = {
-            (0x20),
-            (0x03 & mode)
-        };
+    const uint8 cmd[1] = {SSD1306_CMD_ACTIVATE_SCROLL};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 2);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void SetComlumnAddress(uint8 startAddr, uint8 endAddr)
+IFX_INLINE void SetVerticalScrollArea(SSD1306_Inst *panel, uint8 fixedRows, uint8 scrollRows)
 {
-    uint8 cmd[3] = {
-            (0x21),
-            (0x7F & startAddr),
-            (0x7F & endAddr)
-        };
+    const uint8 cmd[3] = {SSD1306_CMD_V_SCROLL_AREA(fixedRows, scrollRows)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 3);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 3);
 }
 
-static void SetPageAddress(uint8 startAddr, uint8 endAddr)
+IFX_INLINE void SetLowColStartAddrPageMode(SSD1306_Inst *panel, uint8 nibble)
 {
-    uint8 cmd[3] = {
-            (0x22),
-            (0x07 & startAddr),
-            (0x07 & endAddr)
-        };
+    const uint8 cmd[1] = {SSD1306_CMD_LOW_COLUMN(nibble)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 3);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void SetPageStartForPageMode(uint8 page)
+IFX_INLINE void SetHighColStartAddrPageMode(SSD1306_Inst *panel, uint8 nibble)
 {
-    uint8 cmd[1] = {(0xB0 | (0x07 & page))};
+    const uint8 cmd[1] = {SSD1306_CMD_HIGH_COLUMN(nibble)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void SetDisplayStartLine(uint8 line)
+IFX_INLINE void SetMemoryAddressingMode(SSD1306_Inst *panel, uint8 mode)
 {
-    uint8 cmd[1] = {(0x40 | (0x3F & line))};
+    const uint8 cmd[2] = {SSD1306_CMD_ADDRESSING_MODE(mode)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 2);
 }
 
-static void SetSegmentReMap(uint8 b127)
+IFX_INLINE void SetComlumnAddress(SSD1306_Inst *panel, uint8 startAddr, uint8 endAddr)
 {
-    uint8 cmd[1] = {(0xA0 | (0x01 & b127))};
+    const uint8 cmd[3] = {SSD1306_CMD_COLUMN_ADDR(startAddr, endAddr)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 3);
 }
 
-static void SetMultiplexRatio(uint8 mux)
+IFX_INLINE void SetPageAddress(SSD1306_Inst *panel, uint8 startAddr, uint8 endAddr)
 {
-    uint8 cmd[2] = {
-            (0xA8),
-            (0x3F & mux)
-        };
+    const uint8 cmd[3] = {SSD1306_CMD_PAGE_ADDR(startAddr, endAddr)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 2);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 3);
 }
 
-static void SetComOutputScanDirection(uint8 bRemap)
+IFX_INLINE void SetPageStartForPageMode(SSD1306_Inst *panel, uint8 page)
 {
-    uint8 cmd[1] = {(0xC0 | (0x08 & (bRemap << 3)))};
+    const uint8 cmd[1] = {SSD1306_CMD_PAGE_START(page)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void SetDisplayOffset(uint8 com)
+IFX_INLINE void SetDisplayStartLine(SSD1306_Inst *panel, uint8 line)
 {
-    uint8 cmd[2] = {
-            (0xD3),
-            (0x3F & com)
-        };
+    const uint8 cmd[1] = {SSD1306_CMD_START_LINE(line)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 2);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void SetComPinsHardwareConfig(uint8 config)
+IFX_INLINE void SetSegmentReMap(SSD1306_Inst *panel, uint8 b127)
 {
-    uint8 cmd[2] = {
-            (0xDA),
-            ((0x30 & (config << 4)) | (0x02))
-        };
+    const uint8 cmd[1] = {SSD1306_CMD_SEG_REMAP(b127)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 2);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void SetDisplayClockRatioFreq(uint8 divRatio, uint8 oscFreq)
+IFX_INLINE void SetMultiplexRatio(SSD1306_Inst *panel, uint8 mux)
 {
-    uint8 cmd[2] = {
-            (0xD5),
-            ((0xF0 & (oscFreq << 4)) | (0x0F & divRatio))
-        };
+    const uint8 cmd[2] = {SSD1306_CMD_MUX_RATIO(mux)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 2);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 2);
 }
 
-static void SetPreChargePeriod(uint8 phase1, uint8 phase2)
+IFX_INLINE void SetComOutputScanDirection(SSD1306_Inst *panel, uint8 bRemap)
 {
-    uint8 cmd[2] = {
-            (0xD9),
-            ((0xF0 & (phase2 << 4)) | (0x0F & phase1))
-        };
+    const uint8 cmd[1] = {SSD1306_CMD_COM_SCAN(bRemap)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 2);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
 }
 
-static void VcomhDeselectLevel(uint8 level)
+IFX_INLINE void SetDisplayOffset(SSD1306_Inst *panel, uint8 com)
 {
-    uint8 cmd[2] = {
-            (0xDB),
-            (0x70 & (level << 4))
-        };
+    const uint8 cmd[2] = {SSD1306_CMD_DISPLAY_OFFSET(com)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 2);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 2);
 }
 
-static void NOP_CMD(void)
+IFX_INLINE void SetComPinsHardwareConfig(SSD1306_Inst *panel, uint8 config)
 {
-    uint8 cmd[1] = {0xE3};
+    const uint8 cmd[2] = {SSD1306_CMD_COM_PINS(config)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 1);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 2);
 }
 
-static uint8 StatusRegisterRead(void)
+IFX_INLINE void SetDisplayClockRatioFreq(SSD1306_Inst *panel, uint8 divRatio, uint8 oscFreq)
+{
+    const uint8 cmd[2] = {SSD1306_CMD_CLOCK(divRatio, oscFreq)};
+
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 2);
+}
+
+IFX_INLINE void SetPreChargePeriod(SSD1306_Inst *panel, uint8 phase1, uint8 phase2)
+{
+    const uint8 cmd[2] = {SSD1306_CMD_PRECHARGE(phase1, phase2)};
+
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 2);
+}
+
+IFX_INLINE void VcomhDeselectLevel(SSD1306_Inst *panel, uint8 level)
+{
+    const uint8 cmd[2] = {SSD1306_CMD_VCOMH(level)};
+
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 2);
+}
+
+IFX_INLINE void NOP_CMD(SSD1306_Inst *panel)
+{
+    const uint8 cmd[1] = {SSD1306_CMD_NOP};
+
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 1);
+}
+
+IFX_INLINE uint8 StatusRegisterRead(SSD1306_Inst *panel)
 {
     uint8 data[1] = {0};
 
-    I2c_read(&ssd1306_inst.dev, data, 1);
+    I2c_read(&panel->i2c, data, 1);
     return ((0x01)&(data[0] >> 6));
 }
 
-static void ChargePumpSetting(uint8 bEnable)
+IFX_INLINE void ChargePumpSetting(SSD1306_Inst *panel, uint8 bEnable)
 {
-    uint8 cmd[2] = {
-            (0x8D),
-            ((0x10) | (0x04 & (bEnable << 2)))
-        };
+    const uint8 cmd[2] = {SSD1306_CMD_CHARGE_PUMP(bEnable)};
 
-    _SendData(SSD1306_Packet_COMMAND, cmd, 2);
+    _SendData(panel, SSD1306_Packet_COMMAND, cmd, 2);
 }
 
-static void _SendData(SSD1306_Packet_T type, const uint8 *data, Ifx_SizeT size)
+static void _SendData(SSD1306_Inst *panel, SSD1306_Packet_T type, const uint8 *data, Ifx_SizeT size)
 {
-#if 0
-    uint8 buffer[SSD1306_MAX_SEND_SIZE] = {0};
-    uint8 sendCount = (size / SSD1306_MAX_SEND_DATA);
-    uint8 extraSize = size % SSD1306_MAX_SEND_DATA;
-    /* Max Send Data: 16Byte (Control 8Byte, Data 8Byte) */
-    for (int i=0; i < sendCount; i++) {
-        _MakePacket(buffer, type, data + (SSD1306_MAX_SEND_DATA * i), SSD1306_MAX_SEND_DATA);
-        _SendPacket(type, buffer , SSD1306_MAX_SEND_SIZE); /* Control Byte + Data Byte */
+    if (type == SSD1306_Packet_COMMAND && panel->cmdList.bActive) {
+        _AppendCommandList(panel, data, size);
+        return;
+    }
+
+    /* Control Byte once + Data Bytes: Half the bytes of the Co = 1 pairs and no SSD1306_I2C_BUFF_MAX / 2 limit */
+    while (size > 0) {
+        const Ifx_SizeT len = (size > SSD1306_STREAM_MAX_DATA) ? SSD1306_STREAM_MAX_DATA : size;
+
+        _MakeStream(_GetTxBuff(panel), type, data, len);
+        _SendTxBuff(panel, len + 1);
+        data += len;
+        size -= len;
     }
-    _MakePacket(buffer, type, data + (SSD1306_MAX_SEND_DATA * sendCount), extraSize);
-    _SendPacket(type, buffer, extraSize * 2);
-#else
-    uint8 buffer[SSD1306_I2C_BUFF_MAX] = {0};
-    _MakePacket(buffer, type, data, size);
-    _SendPacket(type, buffer, size * 2);
-#endif
 }
 
-static void _SendPacket(SSD1306_Packet_T type, const uint8 *packet, Ifx_SizeT size)
+static uint8 *_GetTxBuff(SSD1306_Inst *panel)
 {
-    I2c_write(&ssd1306_inst.dev, packet, size);
+    while (panel->bTxBusy) {
+        _SubmitPending(panel);
+    }
+
+    return panel->txBuff;
+}
+
+static void _SendTxBuff(SSD1306_Inst *panel, Ifx_SizeT size)
+{
+    _Submit(panel, &panel->txTrans, &panel->bTxBusy, _TxDone, panel->txBuff, size, TRUE);
 }
 
-static void _MakePacket(uint8 *buffer, SSD1306_Packet_T type, const uint8 *data, Ifx_SizeT size)
+static void _SendCommandTable(SSD1306_Inst *panel, const uint8 *table, Ifx_SizeT size)
 {
-    const uint8 _contBit = 0x80;
-    const uint8 _cByte = (0x00 | (type << 6));
-    uint8 cByte;
+    while (panel->bTxBusy) {                /* panel->txTrans is shared with panel->txBuff */
+        _SubmitPending(panel);
+    }
 
-    cByte = _cByte | _contBit;
-    for (int i=0; i < size; i++) {
-        if (i >= size -1) cByte &= !_contBit;
+    _Submit(panel, &panel->txTrans, &panel->bTxBusy, _TxDone, table, size, FALSE);
+}
 
-        buffer[i * 2] = cByte;
-        buffer[(i * 2) + 1] = data[i];
+static void _Submit(SSD1306_Inst *panel, Module_I2C_Transaction *trans, volatile boolean *pBusy, Module_I2C_Callback callback,
+                    const uint8 *packet, Ifx_SizeT size, boolean bDma)
+{
+    trans->dir = Module_I2C_Dir_WRITE;
+    trans->data = (volatile uint8 *)(packet - (bDma ? MODULE_I2C_DMA_HEADROOM : 0));
+    trans->size = size;
+    trans->callback = callback;
+    trans->arg = panel;
+    trans->bDma = bDma;                     /* Only the txBuff has the headroom byte in front */
+    /* Only GDDRAM data can be cut anywhere, a command stream would lose its parameters */
+    trans->chunkSize = (packet[0] == (0x00 | (SSD1306_Packet_DATA << 6))) ? SSD1306_STREAM_CHUNK : 0;
+
+    /* Queue full: trans stays busy and waits behind the earlier refused ones, no blocking write in between */
+    *pBusy = TRUE;
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, panel->pendingLen < (sizeof(panel->pending) / sizeof(panel->pending[0])));
+    panel->pending[panel->pendingLen++] = trans;
+    _SubmitPending(panel);
+
+    panel->stats.txBytes += size + 1;       /* Slave address byte */
+    panel->stats.txTransactions++;
+}
+
+static void _SubmitPending(SSD1306_Inst *panel)
+{
+    while (panel->pendingLen > 0 && I2c_submit(&panel->i2c, panel->pending[0])) {
+        panel->pending[0] = panel->pending[1];
+        panel->pendingLen--;
+    }
+}
+
+static void _TxDone(IfxI2c_I2c_Status status, void *arg)
+{
+    SSD1306_Inst *panel = (SSD1306_Inst *)arg;
+
+    /* Retried by the panel's retry policy in the queue, a failed frame is dropped */
+    if (status != IfxI2c_I2c_Status_ok) {
+        panel->bShadowValid = FALSE;        /* The next SSD1306_FlushDiff sends the whole frame */
+    }
+    panel->bTxBusy = FALSE;
+}
+
+static void _CmdDone(IfxI2c_I2c_Status status, void *arg)
+{
+    SSD1306_Inst *panel = (SSD1306_Inst *)arg;
+
+    /* Lost window: The data went somewhere else in the GDDRAM */
+    if (status != IfxI2c_I2c_Status_ok) {
+        panel->bShadowValid = FALSE;
+    }
+    panel->bCmdBusy = FALSE;
+}
+
+static boolean _DiffStep(SSD1306_Inst *panel, SSD1306_FrameBuffer *frame)
+{
+    if (panel->diffPage == 0 && panel->diffWord == 0 && panel->bShadowValid == FALSE) {
+        SSD1306_Blit(panel, &frame->buff[0][0], SSD1306_MAX_SEG, 0, panel->pageLen, 0, SSD1306_MAX_SEG);
+        panel->bShadowValid = TRUE;
+        for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+            frame->dirtyStart[page] = SSD1306_MAX_SEG;
+            frame->dirtyEnd[page] = 0;
+        }
+        panel->diffPage = panel->pageLen;   /* Shadow is the frame now */
+        return TRUE;
+    }
+
+    while (panel->diffPage < panel->pageLen) {
+        const uint8 page = panel->diffPage;
+        const uint32 *pNew = (const uint32 *)&frame->buff[page][0];
+        const uint32 *pOld = (const uint32 *)&panel->shadow[page][0];
+        int runStart = -1;
+        int runEnd = 0;
+
+        /* 4 columns per compare, the changed bytes of a word give the run edges */
+        for (; panel->diffWord < (SSD1306_MAX_SEG / 4); panel->diffWord++) {
+            const int w = panel->diffWord;
+            const uint32 diff = pNew[w] ^ pOld[w];
+            int first = 0;
+            int last = 3;
+
+            if (diff == 0) {
+                continue;
+            }
+            while (((diff >> (first * 8)) & 0xFF) == 0) first++;
+            while (((diff >> (last * 8)) & 0xFF) == 0) last--;
+            first += w * 4;                 /* Little endian: column w * 4 in the low byte */
+            last += w * 4;
+
+            /* The gap costs less than a new window: Send it with the run, else word w starts the next step */
+            if (runStart >= 0 && (first - runEnd) > SSD1306_WINDOW_OVERHEAD) {
+                break;
+            }
+            if (runStart < 0) {
+                runStart = first;
+            }
+            runEnd = last + 1;
+        }
+
+        if (panel->diffWord >= (SSD1306_MAX_SEG / 4)) {
+            frame->dirtyStart[page] = SSD1306_MAX_SEG;
+            frame->dirtyEnd[page] = 0;
+            panel->diffPage++;
+            panel->diffWord = 0;
+        }
+        if (runStart >= 0) {
+            SSD1306_Blit(panel, &frame->buff[page][runStart], SSD1306_MAX_SEG, page, 1, runStart, runEnd - runStart);
+            return TRUE;
+        }
+    }
+
+    for (int page = panel->pageLen; page < SSD1306_MAX_PAGE; page++) {
+        frame->dirtyStart[page] = SSD1306_MAX_SEG;      /* Not on the panel */
+        frame->dirtyEnd[page] = 0;
+    }
+    return FALSE;
+}
+
+static void _MakeStream(uint8 *buffer, SSD1306_Packet_T type, const uint8 *data, Ifx_SizeT size)
+{
+    buffer[0] = (0x00 | (type << 6));       /* Co = 0, D/C# = type */
+    memcpy(&buffer[1], data, size);
+}
+
+static void _BeginCommandList(SSD1306_Inst *panel)
+{
+    while (panel->bCmdBusy) {               /* Last list is still read by the I2C interrupts */
+        _SubmitPending(panel);
+    }
+
+    panel->cmdList.buff[0] = (0x00 | (SSD1306_Packet_COMMAND << 6));      /* Co = 0, D/C# = 0 */
+    panel->cmdList.len = 0;
+    panel->cmdList.bActive = TRUE;
+}
+
+static void _EndCommandList(SSD1306_Inst *panel)
+{
+    _SendCommandList(panel);
+    panel->cmdList.bActive = FALSE;
+}
+
+static void _AppendCommandList(SSD1306_Inst *panel, const uint8 *cmd, Ifx_SizeT size)
+{
+    if (panel->cmdList.len + size > SSD1306_CMD_LIST_MAX) {
+        _SendCommandList(panel);            /* Never split a command over two transactions */
+        while (panel->bCmdBusy) {
+            _SubmitPending(panel);
+        }
     }
+
+    memcpy(&panel->cmdList.buff[1 + panel->cmdList.len], cmd, size);
+    panel->cmdList.len += size;
+}
+
+static void _SendCommandList(SSD1306_Inst *panel)
+{
+    if (panel->cmdList.len == 0) {
+        return;
+    }
+
+    /* Queued behind the panel's earlier transactions, the data of the window follows in the same queue */
+    _Submit(panel, &panel->cmdTrans, &panel->bCmdBusy, _CmdDone, panel->cmdList.buff, panel->cmdList.len + 1, FALSE);
+    panel->cmdList.len = 0;
 }
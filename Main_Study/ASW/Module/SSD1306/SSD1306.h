@@ -2,6 +2,8 @@
 #define SSD1306_H
 
 #include "Platform_Types.h"
+#include "IfxCpu.h"
+#include "Module_I2C.h"
 
 /**
  * @brief 
@@ -15,24 +17,274 @@
 #define SSD1306_MAX_PAGE                8
 #define SSD1306_I2C_BUFF_MAX            (SSD1306_MAX_SEG * 2)
 
-#if 0
-#define SSD1306_MAX_SEND_DATA           8
-#else
-#define SSD1306_MAX_SEND_DATA           2
-#endif
-#define SSD1306_MAX_SEND_SIZE           SSD1306_MAX_SEND_DATA * 2                       /* Max Send Data: 16Byte (Control 8Byte, Data 8Byte) */
+#define SSD1306_STREAM_MAX_DATA         (SSD1306_MAX_PAGE * SSD1306_MAX_SEG)            /* Whole GDDRAM in one transaction */
+#define SSD1306_STREAM_BUFF_MAX         (SSD1306_STREAM_MAX_DATA + 1)                   /* Control Byte(Co = 0) + Data Bytes */
+#define SSD1306_STREAM_CHUNK            (SSD1306_MAX_SEG * 2)                           /* GDDRAM bytes per bus transaction, other devices go in between */
+
+#define SSD1306_ADDRESSING_HORIZONTAL   0
+#define SSD1306_ADDRESSING_VERTICAL     1
+#define SSD1306_ADDRESSING_PAGE         2
+#define SSD1306_WINDOW_OVERHEAD         10                                              /* Column + Page Address command list (8Byte) + Data header (2Byte) */
+#define SSD1306_CMD_LIST_MAX            32                                              /* Command bytes sent as one command stream */
+
+#define SSD1306_IMAGE_STRIDE            (SSD1306_MAX_SEG / 8)                           /* Bytes per row of a row-major 1bpp image */
+#define SSD1306_IMAGE_INVERT            0x01
+#define SSD1306_IMAGE_MIRROR            0x02                                            /* Left-right */
+#define SSD1306_IMAGE_LSB_FIRST         0x04                                            /* Leftmost pixel in bit 0 (XBM), default bit 7 */
 
 #define SSD1306_ADDR_128_32             0
 #define SSD1306_ADDR_128_64             1
+#define SSD1306_PANEL_MAX               2                                               /* Entries of SSD1306_PanelConfig */
 #define GET_SSD1306_ADDR(bSA0) (uint8)( (0x3C) | (0x01 & bSA0) )                        /* 0x3C for 128 * 32, 0x3D for 128 * 64 */
 
+/* 9-1 Command Table: Command bytes, usable in constant initializers */
+#define SSD1306_CMD_STREAM                              (0x00)                          /* Control Byte(Co = 0, D/C# = 0) */
+#define SSD1306_CMD_CONTRAST(value)                     (0x81), (value)
+#define SSD1306_CMD_ENTIRE_ON(bIgCon)                   (0xA4 | (0x01 & (bIgCon)))
+#define SSD1306_CMD_INVERSE(bInverse)                   (0xA6 | (0x01 & (bInverse)))
+#define SSD1306_CMD_DISPLAY_ON(bOn)                     (0xAE | (0x01 & (bOn)))
+#define SSD1306_CMD_H_SCROLL(bLHS, spg, interval, epg)  (0x26 | (0x01 & (bLHS))), (0x00), (0x07 & (spg)), (0x07 & (interval)), \
+                                                        (0x07 & (epg)), (0x00), (0xFF)
+#define SSD1306_CMD_VH_SCROLL(VLHS, spg, interval, epg, vOffset) \
+                                                        (0x28 | (0x03 & (VLHS))), (0x00), (0x07 & (spg)), (0x07 & (interval)), \
+                                                        (0x07 & (epg)), (0x3F & (vOffset))
+#define SSD1306_CMD_DEACTIVATE_SCROLL                   (0x2E)
+#define SSD1306_CMD_ACTIVATE_SCROLL                     (0x2F)
+#define SSD1306_CMD_V_SCROLL_AREA(fixedRows, scrollRows) \
+                                                        (0xA3), (0x3F & (fixedRows)), (0x7F & (scrollRows))
+#define SSD1306_CMD_LOW_COLUMN(nibble)                  (0x00 | (0x0F & (nibble)))
+#define SSD1306_CMD_HIGH_COLUMN(nibble)                 (0x10 | (0x0F & (nibble)))
+#define SSD1306_CMD_ADDRESSING_MODE(mode)               (0x20), (0x03 & (mode))
+#define SSD1306_CMD_COLUMN_ADDR(startAddr, endAddr)     (0x21), (0x7F & (startAddr)), (0x7F & (endAddr))
+#define SSD1306_CMD_PAGE_ADDR(startAddr, endAddr)       (0x22), (0x07 & (startAddr)), (0x07 & (endAddr))
+#define SSD1306_CMD_PAGE_START(page)                    (0xB0 | (0x07 & (page)))
+#define SSD1306_CMD_START_LINE(line)                    (0x40 | (0x3F & (line)))
+#define SSD1306_CMD_SEG_REMAP(b127)                     (0xA0 | (0x01 & (b127)))
+#define SSD1306_CMD_MUX_RATIO(mux)                      (0xA8), (0x3F & (mux))
+#define SSD1306_CMD_COM_SCAN(bRemap)                    (0xC0 | (0x08 & ((bRemap) << 3)))
+#define SSD1306_CMD_DISPLAY_OFFSET(com)                 (0xD3), (0x3F & (com))
+#define SSD1306_CMD_COM_PINS(config)                    (0xDA), ((0x30 & ((config) << 4)) | (0x02))
+#define SSD1306_CMD_CLOCK(divRatio, oscFreq)            (0xD5), ((0xF0 & ((oscFreq) << 4)) | (0x0F & (divRatio)))
+#define SSD1306_CMD_PRECHARGE(phase1, phase2)           (0xD9), ((0xF0 & ((phase2) << 4)) | (0x0F & (phase1)))
+#define SSD1306_CMD_VCOMH(level)                        (0xDB), (0x70 & ((level) << 4))
+#define SSD1306_CMD_NOP                                 (0xE3)
+#define SSD1306_CMD_CHARGE_PUMP(bEnable)                (0x8D), ((0x10) | (0x04 & ((bEnable) << 2)))
+
+typedef enum eSSD1306_Geometry {
+    SSD1306_Geometry_128_32 = 0,                    /* 32 MUX, sequential COM pins, 4 pages */
+    SSD1306_Geometry_128_64 = 1                     /* 64 MUX, alternative COM pins, 8 pages */
+} SSD1306_Geometry;
+
+typedef enum eSSD1306_Front {
+    SSD1306_Front_IDLE = 0,                         /* Flushed, the render core may hand over the next frame */
+    SSD1306_Front_POSTED = 1,                       /* Handed over, a newer SSD1306_PostFrame still replaces it */
+    SSD1306_Front_FLUSHING = 2                      /* Taken by the flush core, its runs go on the bus */
+} SSD1306_Front;
+
 typedef enum eSSD1306_Packet_T {
     SSD1306_Packet_COMMAND = 0,
     SSD1306_Packet_DATA = 1
 } SSD1306_Packet_T;
 
-extern void Init_SSD1306(void);
-extern void SSD1306_SetDisplay(uint8 *buff, uint8 startPage, uint8 pageLen, uint8 startColumn, uint8 columnLen);
-extern void SSD1306_ClearDisplay(void);
+/**
+ * @brief Persistent GDDRAM image with per page dirty column span
+ * A page is clean when dirtyStart >= dirtyEnd.
+ */
+typedef struct _SSD1306_FrameBuffer {
+    uint8 buff[SSD1306_MAX_PAGE][SSD1306_MAX_SEG];  /* Page-major GDDRAM image */
+    uint8 dirtyStart[SSD1306_MAX_PAGE];             /* First dirty column of each page */
+    uint8 dirtyEnd[SSD1306_MAX_PAGE];               /* Last dirty column + 1 of each page */
+} SSD1306_FrameBuffer;
+
+/**
+ * @brief 1bpp image in GDDRAM layout (pageLen pages of columnLen bytes), PackBits compressed
+ * Made from a PBM file by Tools/ssd1306_image.py.
+ */
+typedef struct _SSD1306_Image {
+    const uint8 *data;
+    uint16 size;                                    /* Compressed bytes */
+    uint8 pageLen;
+    uint8 columnLen;
+} SSD1306_Image;
+
+/**
+ * @brief Commands accumulated between _BeginCommandList / _EndCommandList
+ */
+typedef struct _SSD1306_CmdList {
+    uint8 buff[SSD1306_CMD_LIST_MAX + 1];           /* Control Byte(Co = 0, D/C# = 0) + Command Bytes */
+    uint8 len;                                      /* Command Bytes */
+    boolean bActive;
+} SSD1306_CmdList;
+
+/**
+ * @brief I2C traffic generated by the driver (Slave address byte included)
+ */
+typedef struct _SSD1306_Stats {
+    uint32 txBytes;
+    uint32 txTransactions;
+    uint32 initTicks;                               /* STM0 ticks from Init_SSD1306 to the first frame on the panel */
+    uint32 frames;                                  /* Frames handed over by SSD1306_SwapFrame and flushed */
+    uint32 merged;                                  /* Posted frames replaced before the flush core took them (SSD1306_PostFrame) */
+    uint32 refused;                                 /* Posts refused while the front was flushing, the back frame keeps the draws */
+    uint32 dropped;                                 /* Frame periods skipped, the last frame was still on the bus */
+} SSD1306_Stats;
+
+typedef struct _SSD1306_Config {
+    Module_I2C_Config i2c;                          /* Panels on the same p_i2c share the bus */
+    SSD1306_Geometry geometry;
+    IfxDma_ChannelId dmaChannel;                    /* GDDRAM data of the bus, the first panel on p_i2c sets it up */
+} SSD1306_Config;
+
+/**
+ * @brief One panel: I2C device, transmit buffers, double buffer and GDDRAM shadow
+ * frames / shadow / txFrame come first and are multiples of 4 bytes: With an IFX_ALIGN(4) instance
+ * they are word aligned for SSD1306_FlushDiff and the DMA.
+ */
+typedef struct _SSD1306_Inst {
+    SSD1306_FrameBuffer frames[2];                  /* Double buffer */
+    uint8 shadow[SSD1306_MAX_PAGE][SSD1306_MAX_SEG];    /* GDDRAM content, kept by SSD1306_Blit */
+    uint8 txFrame[MODULE_I2C_DMA_HEADROOM + SSD1306_STREAM_BUFF_MAX];     /* Address byte + txBuff for the DMA */
+    uint8 *txBuff;
+    const SSD1306_Config *config;
+    Module_I2C_Inst i2c;
+    uint8 pageLen;                                  /* GDDRAM pages shown by the panel */
+    SSD1306_Stats stats;
+    SSD1306_CmdList cmdList;
+    Module_I2C_Transaction txTrans;
+    Module_I2C_Transaction cmdTrans;
+    Module_I2C_Transaction *pending[2];             /* Refused by the full I2C queue (txTrans / cmdTrans), submitted in this order */
+    uint8 pendingLen;
+    volatile boolean bTxBusy;                       /* txBuff / txTrans are on the bus */
+    volatile boolean bCmdBusy;                      /* cmdList / cmdTrans are on the bus */
+    volatile boolean bShadowValid;                  /* FALSE: Panel content unknown (before the clear, scroll) */
+    volatile uint8 backIndex;
+    volatile SSD1306_Front frontState;
+    IfxCpu_spinLock frameLock;
+    uint8 diffPage;                                 /* Flush cursor in the front frame */
+    uint8 diffWord;
+} SSD1306_Inst;
+
+extern const SSD1306_Config SSD1306_PanelConfig[SSD1306_PANEL_MAX];
+
+/**
+ * @brief Join the I2C bus of config, send the init command stream for the geometry and clear the panel
+ * 
+ * @param panel IFX_ALIGN(4) global (zero initialized), the render core starts drawing after this returns (pageLen)
+ * @param config 
+ */
+extern void Init_SSD1306(SSD1306_Inst *panel, const SSD1306_Config *config);
+extern void SSD1306_SetDisplay(SSD1306_Inst *panel, uint8 *buff, uint8 startPage, uint8 pageLen, uint8 startColumn, uint8 columnLen);
+extern void SSD1306_ClearDisplay(SSD1306_Inst *panel);
+/**
+ * @brief Stream a page-major rectangle in one transaction (Horizontal Addressing Mode)
+ * 
+ * @param buff First byte of the rectangle
+ * @param stride Bytes between two pages in buff (SSD1306_MAX_SEG for a full frame)
+ * @param startPage 
+ * @param pageLen 
+ * @param startColumn 
+ * @param columnLen 
+ */
+extern void SSD1306_Blit(SSD1306_Inst *panel, const uint8 *buff, uint16 stride, uint8 startPage, uint8 pageLen, uint8 startColumn, uint8 columnLen);
+
+/**
+ * @brief Decode image into the I2C transmit buffer and send it to the window at startPage / startColumn
+ * No frame buffer in between, the image must fit on the panel.
+ */
+extern void SSD1306_DrawImage(SSD1306_Inst *panel, const SSD1306_Image *image, uint8 startPage, uint8 startColumn);
+/**
+ * @brief Convert a row-major 1bpp image (SSD1306_IMAGE_STRIDE bytes per row, 64 rows) to page-major GDDRAM layout
+ * 8x8 pixel blocks are transposed in two 32 bit words.
+ * 
+ * @param buff SSD1306_MAX_PAGE * SSD1306_MAX_SEG bytes
+ * @param image 
+ * @param flags SSD1306_IMAGE_INVERT / SSD1306_IMAGE_MIRROR / SSD1306_IMAGE_LSB_FIRST
+ */
+extern void SSD1306_ImportImage(uint8 *buff, const uint8 *image, uint8 flags);
+
+/**
+ * @brief Clear the frame and mark every page dirty, so the first flush syncs the panel
+ */
+extern void SSD1306_InitFrame(SSD1306_FrameBuffer *frame);
+extern void SSD1306_MarkDirty(SSD1306_FrameBuffer *frame, uint8 page, uint8 startColumn, uint8 columnLen);
+extern void SSD1306_SetPixel(SSD1306_FrameBuffer *frame, uint8 x, uint8 y, uint8 bValue);
+/**
+ * @brief Send only the dirty column span of each dirty page, then mark the frame clean
+ * Neighbouring dirty pages share one window while the extra columns cost less than SSD1306_WINDOW_OVERHEAD.
+ */
+extern void SSD1306_Flush(SSD1306_Inst *panel, SSD1306_FrameBuffer *frame);
+/**
+ * @brief Send only the column runs that differ from the shadow copy of the GDDRAM, dirty spans are not needed
+ * Runs of a page closer than SSD1306_WINDOW_OVERHEAD are sent as one window. frame must be 4 byte aligned.
+ */
+extern void SSD1306_FlushDiff(SSD1306_Inst *panel, SSD1306_FrameBuffer *frame);
+
+/**
+ * @brief Back frame of the double buffer, only the rendering core draws into it
+ */
+extern SSD1306_FrameBuffer *SSD1306_GetBackFrame(SSD1306_Inst *panel);
+/**
+ * @brief Rendering core: Hand the back frame to the flush core at the frame boundary
+ * Waits while the previous frame is still being flushed, then the new back frame starts as a copy of it.
+ */
+extern void SSD1306_SwapFrame(SSD1306_Inst *panel);
+/**
+ * @brief Rendering core: Hand the back frame over without waiting
+ * A posted frame the flush core has not taken yet is replaced, so draws in between are merged into one frame.
+ * While the front is on the bus nothing is handed over, the changes stay in the back frame for the next post.
+ *
+ * @return boolean FALSE if the front frame is being flushed
+ */
+extern boolean SSD1306_PostFrame(SSD1306_Inst *panel);
+/**
+ * @brief Flush core: Take the handed over frame, SSD1306_FlushStep sends it
+ *
+ * @return boolean FALSE if no frame was posted
+ */
+extern boolean SSD1306_StartFrame(SSD1306_Inst *panel);
+/**
+ * @brief Flush core: Next changed run of the taken frame, nothing is done while the last run is still queued
+ * Runs the full I2C queue refused are submitted again first.
+ *
+ * @return boolean TRUE if the frame was finished
+ */
+extern boolean SSD1306_FlushStep(SSD1306_Inst *panel);
+/**
+ * @brief Flush core (the core of Init_SSD1306): Send what changed in a handed over frame (SSD1306_FlushDiff)
+ * 
+ * @return boolean FALSE if no new frame was there
+ */
+extern boolean SSD1306_FlushFrame(SSD1306_Inst *panel);
+/**
+ * @brief Flush core: SSD1306_FlushFrame for several panels without waiting for one of them
+ * Each call sends the next changed run of every panel whose last run is off the bus, so the runs of
+ * the panels take turns in the I2C queue. Call it in a loop.
+ * 
+ * @return boolean TRUE if a frame was finished
+ */
+extern boolean SSD1306_FlushPanels(SSD1306_Inst *panels, uint8 count);
+
+/**
+ * @brief Display On/Off with charge pump, one I2C transaction
+ */
+extern void SSD1306_SetPower(SSD1306_Inst *panel, uint8 bOn);
+/**
+ * @brief Stop, set up and start continuous horizontal scroll, one I2C transaction
+ * 
+ * @param bLeft Left Horizontal Scroll
+ * @param startPage 
+ * @param endPage 
+ * @param interval Scroll step interval in terms of frame frequency (0 ~ 7)
+ */
+extern void SSD1306_StartHorizontalScroll(SSD1306_Inst *panel, uint8 bLeft, uint8 startPage, uint8 endPage, uint8 interval);
+extern void SSD1306_StopScroll(SSD1306_Inst *panel);
+/**
+ * @brief GDDRAM row shown in the top row of the panel, one command byte
+ * RAM addresses and the shadow do not move: Frames drawn for line 0 appear rotated by line rows.
+ */
+extern void SSD1306_SetStartLine(SSD1306_Inst *panel, uint8 line);
+
+extern void SSD1306_GetStats(SSD1306_Inst *panel, SSD1306_Stats *stats);
+extern void SSD1306_ResetStats(SSD1306_Inst *panel);
 
 #endif
\ No newline at end of file
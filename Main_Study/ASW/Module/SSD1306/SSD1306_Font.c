@@ -0,0 +1,271 @@
+#include "SSD1306_Font.h"
+#include "IfxCpu.h"
+
+#include <string.h>
+
+static const SSD1306_GlyphStrip *_GetGlyph(const SSD1306_Font *font, char ch);
+static void _FillStrip(SSD1306_GlyphStrip *glyph, const SSD1306_Font *font, char ch);
+
+/* 5x7 ASCII font, blank columns on both sides of a glyph removed */
+static const uint8 ssd1306_font5x7Bitmap[] = {
+    0x00, 0x00,                    /* ' ' */
+    0x5F,                          /* '!' */
+    0x07, 0x00, 0x07,              /* '"' */
+    0x14, 0x7F, 0x14, 0x7F, 0x14,  /* '#' */
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,  /* '$' */
+    0x23, 0x13, 0x08, 0x64, 0x62,  /* '%' */
+    0x36, 0x49, 0x55, 0x22, 0x50,  /* '&' */
+    0x05, 0x03,                    /* ''' */
+    0x1C, 0x22, 0x41,              /* '(' */
+    0x41, 0x22, 0x1C,              /* ')' */
+    0x14, 0x08, 0x3E, 0x08, 0x14,  /* '*' */
+    0x08, 0x08, 0x3E, 0x08, 0x08,  /* '+' */
+    0x50, 0x30,                    /* ',' */
+    0x08, 0x08, 0x08, 0x08, 0x08,  /* '-' */
+    0x60, 0x60,                    /* '.' */
+    0x20, 0x10, 0x08, 0x04, 0x02,  /* '/' */
+    0x3E, 0x51, 0x49, 0x45, 0x3E,  /* '0' */
+    0x42, 0x7F, 0x40,              /* '1' */
+    0x42, 0x61, 0x51, 0x49, 0x46,  /* '2' */
+    0x21, 0x41, 0x45, 0x4B, 0x31,  /* '3' */
+    0x18, 0x14, 0x12, 0x7F, 0x10,  /* '4' */
+    0x27, 0x45, 0x45, 0x45, 0x39,  /* '5' */
+    0x3C, 0x4A, 0x49, 0x49, 0x30,  /* '6' */
+    0x01, 0x71, 0x09, 0x05, 0x03,  /* '7' */
+    0x36, 0x49, 0x49, 0x49, 0x36,  /* '8' */
+    0x06, 0x49, 0x49, 0x29, 0x1E,  /* '9' */
+    0x36, 0x36,                    /* ':' */
+    0x56, 0x36,                    /* ';' */
+    0x08, 0x14, 0x22, 0x41,        /* '<' */
+    0x14, 0x14, 0x14, 0x14, 0x14,  /* '=' */
+    0x41, 0x22, 0x14, 0x08,        /* '>' */
+    0x02, 0x01, 0x51, 0x09, 0x06,  /* '?' */
+    0x32, 0x49, 0x79, 0x41, 0x3E,  /* '@' */
+    0x7E, 0x11, 0x11, 0x11, 0x7E,  /* 'A' */
+    0x7F, 0x49, 0x49, 0x49, 0x36,  /* 'B' */
+    0x3E, 0x41, 0x41, 0x41, 0x22,  /* 'C' */
+    0x7F, 0x41, 0x41, 0x22, 0x1C,  /* 'D' */
+    0x7F, 0x49, 0x49, 0x49, 0x41,  /* 'E' */
+    0x7F, 0x09, 0x09, 0x01, 0x01,  /* 'F' */
+    0x3E, 0x41, 0x41, 0x51, 0x32,  /* 'G' */
+    0x7F, 0x08, 0x08, 0x08, 0x7F,  /* 'H' */
+    0x41, 0x7F, 0x41,              /* 'I' */
+    0x20, 0x40, 0x41, 0x3F, 0x01,  /* 'J' */
+    0x7F, 0x08, 0x14, 0x22, 0x41,  /* 'K' */
+    0x7F, 0x40, 0x40, 0x40, 0x40,  /* 'L' */
+    0x7F, 0x02, 0x04, 0x02, 0x7F,  /* 'M' */
+    0x7F, 0x04, 0x08, 0x10, 0x7F,  /* 'N' */
+    0x3E, 0x41, 0x41, 0x41, 0x3E,  /* 'O' */
+    0x7F, 0x09, 0x09, 0x09, 0x06,  /* 'P' */
+    0x3E, 0x41, 0x51, 0x21, 0x5E,  /* 'Q' */
+    0x7F, 0x09, 0x19, 0x29, 0x46,  /* 'R' */
+    0x46, 0x49, 0x49, 0x49, 0x31,  /* 'S' */
+    0x01, 0x01, 0x7F, 0x01, 0x01,  /* 'T' */
+    0x3F, 0x40, 0x40, 0x40, 0x3F,  /* 'U' */
+    0x1F, 0x20, 0x40, 0x20, 0x1F,  /* 'V' */
+    0x7F, 0x20, 0x18, 0x20, 0x7F,  /* 'W' */
+    0x63, 0x14, 0x08, 0x14, 0x63,  /* 'X' */
+    0x03, 0x04, 0x78, 0x04, 0x03,  /* 'Y' */
+    0x61, 0x51, 0x49, 0x45, 0x43,  /* 'Z' */
+    0x7F, 0x41, 0x41,              /* '[' */
+    0x02, 0x04, 0x08, 0x10, 0x20,  /* '\\' */
+    0x41, 0x41, 0x7F,              /* ']' */
+    0x04, 0x02, 0x01, 0x02, 0x04,  /* '^' */
+    0x40, 0x40, 0x40, 0x40, 0x40,  /* '_' */
+    0x01, 0x02, 0x04,              /* '`' */
+    0x20, 0x54, 0x54, 0x54, 0x78,  /* 'a' */
+    0x7F, 0x48, 0x44, 0x44, 0x38,  /* 'b' */
+    0x38, 0x44, 0x44, 0x44, 0x20,  /* 'c' */
+    0x38, 0x44, 0x44, 0x48, 0x7F,  /* 'd' */
+    0x38, 0x54, 0x54, 0x54, 0x18,  /* 'e' */
+    0x08, 0x7E, 0x09, 0x01, 0x02,  /* 'f' */
+    0x08, 0x14, 0x54, 0x54, 0x3C,  /* 'g' */
+    0x7F, 0x08, 0x04, 0x04, 0x78,  /* 'h' */
+    0x44, 0x7D, 0x40,              /* 'i' */
+    0x20, 0x40, 0x44, 0x3D,        /* 'j' */
+    0x7F, 0x10, 0x28, 0x44,        /* 'k' */
+    0x41, 0x7F, 0x40,              /* 'l' */
+    0x7C, 0x04, 0x18, 0x04, 0x78,  /* 'm' */
+    0x7C, 0x08, 0x04, 0x04, 0x78,  /* 'n' */
+    0x38, 0x44, 0x44, 0x44, 0x38,  /* 'o' */
+    0x7C, 0x14, 0x14, 0x14, 0x08,  /* 'p' */
+    0x08, 0x14, 0x14, 0x18, 0x7C,  /* 'q' */
+    0x7C, 0x08, 0x04, 0x04, 0x08,  /* 'r' */
+    0x48, 0x54, 0x54, 0x54, 0x20,  /* 's' */
+    0x04, 0x3F, 0x44, 0x40, 0x20,  /* 't' */
+    0x3C, 0x40, 0x40, 0x20, 0x7C,  /* 'u' */
+    0x1C, 0x20, 0x40, 0x20, 0x1C,  /* 'v' */
+    0x3C, 0x40, 0x30, 0x40, 0x3C,  /* 'w' */
+    0x44, 0x28, 0x10, 0x28, 0x44,  /* 'x' */
+    0x0C, 0x50, 0x50, 0x50, 0x3C,  /* 'y' */
+    0x44, 0x64, 0x54, 0x4C, 0x44,  /* 'z' */
+    0x08, 0x36, 0x41,              /* '{' */
+    0x7F,                          /* '|' */
+    0x41, 0x36, 0x08,              /* '}' */
+    0x08, 0x04, 0x08, 0x10, 0x08,  /* '~' */
+};
+static const uint16 ssd1306_font5x7Offset[] = {
+    0, 2, 3, 6, 11, 16, 21, 26, 28, 31, 34, 39, 44, 46, 51, 53,
+    58, 63, 66, 71, 76, 81, 86, 91, 96, 101, 106, 108, 110, 114, 119, 123,
+    128, 133, 138, 143, 148, 153, 158, 163, 168, 173, 176, 181, 186, 191, 196, 201,
+    206, 211, 216, 221, 226, 231, 236, 241, 246, 251, 256, 261, 264, 269, 272, 277,
+    282, 285, 290, 295, 300, 305, 310, 315, 320, 325, 328, 332, 336, 339, 344, 349,
+    354, 359, 364, 369, 374, 379, 384, 389, 394, 399, 404, 409, 412, 413, 416
+};
+static const uint8 ssd1306_font5x7Width[] = {
+    2, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5, 2, 5, 2, 5,
+    5, 3, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 3, 5, 5,
+    3, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 4, 3, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 1, 3, 5
+};
+
+const SSD1306_Font SSD1306_Font8 = {
+    .bitmap = ssd1306_font5x7Bitmap,
+    .offset = ssd1306_font5x7Offset,
+    .width = ssd1306_font5x7Width,
+    .first = ' ',
+    .last = '~',
+    .pages = 1,
+    .scale = 1,
+    .spacing = 1
+};
+
+const SSD1306_Font SSD1306_Font16 = {
+    .bitmap = ssd1306_font5x7Bitmap,
+    .offset = ssd1306_font5x7Offset,
+    .width = ssd1306_font5x7Width,
+    .first = ' ',
+    .last = '~',
+    .pages = 1,
+    .scale = 2,
+    .spacing = 2
+};
+
+/* Nibble with every bit doubled: one source byte becomes two pages at scale 2 */
+static const uint8 ssd1306_nibbleX2[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F, 0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+
+/* One cache per core, no lock: A strip is only refilled by the core that copies it */
+static SSD1306_GlyphStrip ssd1306_glyphCache[IFXCPU_NUM_MODULES][SSD1306_GLYPH_CACHE_LEN];
+static uint32 ssd1306_glyphUse[IFXCPU_NUM_MODULES];
+
+uint8 SSD1306_DrawText(SSD1306_FrameBuffer *frame, const SSD1306_Font *font, uint8 page, uint8 x, const char *text, uint8 fieldWidth)
+{
+    const uint8 height = font->pages * font->scale;
+    uint8 end;
+
+    if (page + height > SSD1306_MAX_PAGE || x >= SSD1306_MAX_SEG) {
+        return x;
+    }
+
+    end = SSD1306_RenderText(&frame->buff[page][0], SSD1306_MAX_SEG, font, x, text, fieldWidth);
+    for (int i = 0; i < height; i++) {
+        SSD1306_MarkDirty(frame, page + i, x, end - x);
+    }
+    return end;
+}
+
+uint8 SSD1306_RenderText(uint8 *line, uint16 stride, const SSD1306_Font *font, uint8 x, const char *text, uint8 fieldWidth)
+{
+    const uint8 height = font->pages * font->scale;
+    uint16 end = x;
+    uint16 fieldEnd = x + fieldWidth;
+
+    for (; *text != '\0' && end < SSD1306_MAX_SEG; text++) {
+        const SSD1306_GlyphStrip *glyph = _GetGlyph(font, *text);
+        const uint8 width = (end + glyph->width > SSD1306_MAX_SEG) ? (uint8)(SSD1306_MAX_SEG - end) : glyph->width;
+
+        for (int i = 0; i < height; i++) {
+            memcpy(&line[(i * stride) + end], glyph->strip[i], width);
+        }
+        end += width;
+    }
+
+    if (fieldEnd > SSD1306_MAX_SEG) {
+        fieldEnd = SSD1306_MAX_SEG;
+    }
+    if (fieldEnd > end) {
+        for (int i = 0; i < height; i++) {
+            memset(&line[(i * stride) + end], 0, fieldEnd - end);
+        }
+        end = fieldEnd;
+    }
+
+    return (uint8)end;
+}
+
+uint16 SSD1306_GetTextWidth(const SSD1306_Font *font, const char *text)
+{
+    uint16 width = 0;
+
+    for (; *text != '\0'; text++) {
+        const char ch = (*text < font->first || *text > font->last) ? '?' : *text;
+
+        width += (font->width[ch - font->first] * font->scale) + font->spacing;
+    }
+
+    return width;
+}
+
+/* Least recently used entry is refilled on a miss */
+static const SSD1306_GlyphStrip *_GetGlyph(const SSD1306_Font *font, char ch)
+{
+    const IfxCpu_ResourceCpu core = IfxCpu_getCoreIndex();
+    SSD1306_GlyphStrip *cache = ssd1306_glyphCache[core];
+    SSD1306_GlyphStrip *victim = &cache[0];
+    uint32 use;
+
+    if (ch < font->first || ch > font->last) {
+        ch = '?';
+    }
+
+    use = ++ssd1306_glyphUse[core];
+    for (int i = 0; i < SSD1306_GLYPH_CACHE_LEN; i++) {
+        SSD1306_GlyphStrip *entry = &cache[i];
+
+        if (entry->font == font && entry->ch == ch) {
+            entry->lastUse = use;
+            return entry;
+        }
+        if (entry->lastUse < victim->lastUse) {
+            victim = entry;
+        }
+    }
+
+    _FillStrip(victim, font, ch);
+    victim->lastUse = use;
+    return victim;
+}
+
+static void _FillStrip(SSD1306_GlyphStrip *glyph, const SSD1306_Font *font, char ch)
+{
+    const uint8 index = (uint8)(ch - font->first);
+    const uint8 *src = &font->bitmap[font->offset[index]];
+    const uint8 srcWidth = font->width[index];
+
+    memset(glyph->strip, 0, sizeof(glyph->strip));              /* Spacing columns stay blank */
+    for (int i = 0; i < font->pages; i++) {
+        for (int c = 0; c < srcWidth; c++) {
+            const uint8 b = src[(i * srcWidth) + c];
+
+            if (font->scale == 1) {
+                glyph->strip[i][c] = b;
+            } else {
+                const uint8 lo = ssd1306_nibbleX2[b & 0x0F];
+                const uint8 hi = ssd1306_nibbleX2[b >> 4];
+
+                glyph->strip[i * 2][c * 2] = lo;
+                glyph->strip[i * 2][(c * 2) + 1] = lo;
+                glyph->strip[(i * 2) + 1][c * 2] = hi;
+                glyph->strip[(i * 2) + 1][(c * 2) + 1] = hi;
+            }
+        }
+    }
+
+    glyph->font = font;
+    glyph->ch = ch;
+    glyph->width = (srcWidth * font->scale) + font->spacing;
+}
\ No newline at end of file
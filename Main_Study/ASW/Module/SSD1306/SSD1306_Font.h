@@ -0,0 +1,63 @@
+#ifndef SSD1306_FONT_H
+#define SSD1306_FONT_H
+
+#include "SSD1306.h"
+
+#define SSD1306_GLYPH_CACHE_LEN         16                                              /* Glyph strips kept in RAM per core */
+#define SSD1306_GLYPH_MAX_PAGES         2                                               /* Fonts must fit: pages * scale */
+#define SSD1306_GLYPH_MAX_WIDTH         16                                              /* (width * scale) + spacing */
+
+/**
+ * @brief Proportional font, glyph columns in GDDRAM layout (top row in bit 0)
+ * Glyph c starts at bitmap[offset[c - first]]: width[c - first] bytes of page 0, then of page 1 ...
+ * scale 2 doubles every column and every row when the glyph is put into the cache.
+ */
+typedef struct _SSD1306_Font {
+    const uint8 *bitmap;
+    const uint16 *offset;
+    const uint8 *width;
+    char first;
+    char last;
+    uint8 pages;                                    /* Pages of one glyph in bitmap */
+    uint8 scale;
+    uint8 spacing;                                  /* Blank columns after each glyph */
+} SSD1306_Font;
+
+/**
+ * @brief Glyph ready for the frame: one memcpy per page
+ */
+typedef struct _SSD1306_GlyphStrip {
+    const SSD1306_Font *font;                       /* NULL_PTR: Unused entry */
+    char ch;
+    uint8 width;                                    /* Columns with the spacing */
+    uint32 lastUse;
+    uint8 strip[SSD1306_GLYPH_MAX_PAGES][SSD1306_GLYPH_MAX_WIDTH];
+} SSD1306_GlyphStrip;
+
+extern const SSD1306_Font SSD1306_Font8;            /* 5x7 ASCII, 8 pixel line */
+extern const SSD1306_Font SSD1306_Font16;           /* SSD1306_Font8 doubled, 16 pixel line */
+
+/**
+ * @brief Copy the glyph strips of text into the frame from column x of page on, clipped at the right edge
+ * The columns up to x + fieldWidth are cleared behind the text, so a shorter value removes the old one.
+ * Any core, glyph cache per core: Not from an ISR that can preempt a text call of its own core.
+ *
+ * @param frame
+ * @param font
+ * @param page Top page of the line
+ * @param x
+ * @param text
+ * @param fieldWidth 0: Nothing is cleared
+ * @return uint8 End of the dirty span: Columns x ~ return - 1 of the line's pages are marked dirty
+ */
+extern uint8 SSD1306_DrawText(SSD1306_FrameBuffer *frame, const SSD1306_Font *font, uint8 page, uint8 x, const char *text, uint8 fieldWidth);
+/**
+ * @brief SSD1306_DrawText without a frame: The line's pages are stride bytes apart in line, nothing is marked
+ */
+extern uint8 SSD1306_RenderText(uint8 *line, uint16 stride, const SSD1306_Font *font, uint8 x, const char *text, uint8 fieldWidth);
+/**
+ * @brief Width of text in columns with the spacing
+ */
+extern uint16 SSD1306_GetTextWidth(const SSD1306_Font *font, const char *text);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include "SSD1306_Gfx.h"
+
+#include <string.h>
+
+static void _Apply(uint8 *pByte, uint8 mask, SSD1306_Color color);
+static void _FillColumns(uint8 *pByte, uint8 mask, sint16 len, SSD1306_Color color);
+/**
+ * @brief Fill the inclusive area x0 ~ x1, y0 ~ y1 after clipping and mark it dirty
+ */
+static void _FillArea(SSD1306_FrameBuffer *frame, sint16 x0, sint16 y0, sint16 x1, sint16 y1, SSD1306_Color color);
+static void _MarkArea(SSD1306_FrameBuffer *frame, sint16 x0, sint16 y0, sint16 x1, sint16 y1);
+/**
+ * @brief Single pixel without the dirty marking, the caller marks the whole shape once
+ */
+static void _PlotPixel(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, SSD1306_Color color);
+
+void SSD1306_DrawPixel(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, SSD1306_Color color)
+{
+    _FillArea(frame, x, y, x, y, color);
+}
+
+void SSD1306_DrawHLine(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, sint16 width, SSD1306_Color color)
+{
+    _FillArea(frame, x, y, x + width - 1, y, color);
+}
+
+void SSD1306_DrawVLine(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, sint16 height, SSD1306_Color color)
+{
+    _FillArea(frame, x, y, x, y + height - 1, color);
+}
+
+void SSD1306_DrawLine(SSD1306_FrameBuffer *frame, sint16 x0, sint16 y0, sint16 x1, sint16 y1, SSD1306_Color color)
+{
+    /* sint32: dx, dy and 2 * err of lines from -32768 to 32767 do not fit in sint16 */
+    const sint32 dx = (x1 > x0) ? ((sint32)x1 - x0) : ((sint32)x0 - x1);
+    const sint32 dy = (y1 > y0) ? ((sint32)y0 - y1) : ((sint32)y1 - y0);    /* Negative */
+    const sint32 sx = (x0 < x1) ? 1 : -1;
+    const sint32 sy = (y0 < y1) ? 1 : -1;
+    sint32 err = dx + dy;
+    sint32 x = x0;
+    sint32 y = y0;
+    boolean bInside = FALSE;
+
+    if (y0 == y1) {
+        _FillArea(frame, (x0 < x1) ? x0 : x1, y0, (x0 < x1) ? x1 : x0, y0, color);
+        return;
+    }
+    if (x0 == x1) {
+        _FillArea(frame, x0, (y0 < y1) ? y0 : y1, x0, (y0 < y1) ? y1 : y0, color);
+        return;
+    }
+    if (((x0 < 0) && (x1 < 0)) || ((x0 >= SSD1306_GFX_WIDTH) && (x1 >= SSD1306_GFX_WIDTH)) ||
+        ((y0 < 0) && (y1 < 0)) || ((y0 >= SSD1306_GFX_HEIGHT) && (y1 >= SSD1306_GFX_HEIGHT))) {
+        return;
+    }
+
+    while (1) {
+        const sint32 e2 = err * 2;
+
+        if (x >= 0 && x < SSD1306_GFX_WIDTH && y >= 0 && y < SSD1306_GFX_HEIGHT) {
+            _PlotPixel(frame, (sint16)x, (sint16)y, color);
+            bInside = TRUE;
+        } else if (bInside) {
+            break;                      /* A line leaves the panel only once */
+        }
+        if (x == x1 && y == y1) {
+            break;
+        }
+        if (e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+
+    _MarkArea(frame, (x0 < x1) ? x0 : x1, (y0 < y1) ? y0 : y1, (x0 < x1) ? x1 : x0, (y0 < y1) ? y1 : y0);
+}
+
+void SSD1306_DrawRect(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, sint16 width, sint16 height, SSD1306_Color color)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    _FillArea(frame, x, y, x + width - 1, y, color);
+    if (height > 1) {
+        _FillArea(frame, x, y + height - 1, x + width - 1, y + height - 1, color);
+    }
+    if (height > 2) {
+        _FillArea(frame, x, y + 1, x, y + height - 2, color);
+        if (width > 1) {
+            _FillArea(frame, x + width - 1, y + 1, x + width - 1, y + height - 2, color);
+        }
+    }
+}
+
+void SSD1306_FillRect(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, sint16 width, sint16 height, SSD1306_Color color)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    _FillArea(frame, x, y, x + width - 1, y + height - 1, color);
+}
+
+void SSD1306_DrawCircle(SSD1306_FrameBuffer *frame, sint16 xc, sint16 yc, sint16 radius, SSD1306_Color color)
+{
+    sint16 x = radius;
+    sint16 y = 0;
+    sint16 err = 1 - radius;
+
+    if (radius < 0) {
+        return;
+    }
+
+    while (x >= y) {
+        _PlotPixel(frame, xc + x, yc + y, color);
+        _PlotPixel(frame, xc - x, yc + y, color);
+        _PlotPixel(frame, xc + x, yc - y, color);
+        _PlotPixel(frame, xc - x, yc - y, color);
+        _PlotPixel(frame, xc + y, yc + x, color);
+        _PlotPixel(frame, xc - y, yc + x, color);
+        _PlotPixel(frame, xc + y, yc - x, color);
+        _PlotPixel(frame, xc - y, yc - x, color);
+
+        y++;
+        if (err < 0) {
+            err += (2 * y) + 1;
+        } else {
+            x--;
+            err += (2 * (y - x)) + 1;
+        }
+    }
+
+    _MarkArea(frame, xc - radius, yc - radius, xc + radius, yc + radius);
+}
+
+void SSD1306_FillCircle(SSD1306_FrameBuffer *frame, sint16 xc, sint16 yc, sint16 radius, SSD1306_Color color)
+{
+    sint16 x = radius;
+    sint16 y = 0;
+    sint16 err = 1 - radius;
+
+    if (radius < 0) {
+        return;
+    }
+
+    /* Columns are page-major byte masks: fill the circle column-wise */
+    while (x >= y) {
+        _FillArea(frame, xc + y, yc - x, xc + y, yc + x, color);
+        _FillArea(frame, xc - y, yc - x, xc - y, yc + x, color);
+        _FillArea(frame, xc + x, yc - y, xc + x, yc + y, color);
+        _FillArea(frame, xc - x, yc - y, xc - x, yc + y, color);
+
+        y++;
+        if (err < 0) {
+            err += (2 * y) + 1;
+        } else {
+            x--;
+            err += (2 * (y - x)) + 1;
+        }
+    }
+}
+
+void SSD1306_BlitSprite(SSD1306_FrameBuffer *frame, const SSD1306_Sprite *sprite, sint16 x, sint16 y, SSD1306_Color color)
+{
+    const sint16 top = (y >= 0) ? (y / 8) : -((7 - y) / 8);            /* Page of row y, rounded down */
+    const uint8 shift = (uint8)(y - (top * 8));
+    const sint16 pages = (sprite->height + 7) / 8;
+    const sint16 col0 = (x < 0) ? -x : 0;
+    const sint16 col1 = (x + sprite->width > SSD1306_GFX_WIDTH) ? (SSD1306_GFX_WIDTH - x) : sprite->width;
+
+    if (col0 >= col1 || sprite->height == 0) {
+        return;
+    }
+
+    for (sint16 i = 0; i < pages; i++) {
+        const sint16 rows = sprite->height - (i * 8);
+        const uint8 rowMask = (rows >= 8) ? 0xFF : (uint8)(0xFF >> (8 - rows));
+        const sint16 page = top + i;
+        const boolean bLow = (page >= 0 && page < SSD1306_MAX_PAGE) ? TRUE : FALSE;
+        const boolean bHigh = (shift != 0 && (page + 1) >= 0 && (page + 1) < SSD1306_MAX_PAGE) ? TRUE : FALSE;
+        const uint8 *pSrc = sprite->data + (i * sprite->width);
+
+        for (sint16 c = col0; c < col1; c++) {
+            const uint16 bits = (uint16)(pSrc[c] & rowMask) << shift;
+
+            if (bLow) _Apply(&frame->buff[page][x + c], (uint8)bits, color);
+            if (bHigh) _Apply(&frame->buff[page + 1][x + c], (uint8)(bits >> 8), color);
+        }
+    }
+
+    _MarkArea(frame, x + col0, y, x + col1 - 1, y + sprite->height - 1);
+}
+
+static void _Apply(uint8 *pByte, uint8 mask, SSD1306_Color color)
+{
+    if (color == SSD1306_Color_WHITE) {
+        *pByte |= mask;
+    } else if (color == SSD1306_Color_BLACK) {
+        *pByte &= (uint8)~mask;
+    } else {
+        *pByte ^= mask;
+    }
+}
+
+static void _FillColumns(uint8 *pByte, uint8 mask, sint16 len, SSD1306_Color color)
+{
+    /* Whole page in black / white: the columns are plain bytes */
+    if (mask == 0xFF && color != SSD1306_Color_INVERT) {
+        memset(pByte, (color == SSD1306_Color_WHITE) ? 0xFF : 0x00, len);
+        return;
+    }
+
+    if (color == SSD1306_Color_WHITE) {
+        for (sint16 i = 0; i < len; i++) pByte[i] |= mask;
+    } else if (color == SSD1306_Color_BLACK) {
+        for (sint16 i = 0; i < len; i++) pByte[i] &= (uint8)~mask;
+    } else {
+        for (sint16 i = 0; i < len; i++) pByte[i] ^= mask;
+    }
+}
+
+static void _FillArea(SSD1306_FrameBuffer *frame, sint16 x0, sint16 y0, sint16 x1, sint16 y1, SSD1306_Color color)
+{
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= SSD1306_GFX_WIDTH) x1 = SSD1306_GFX_WIDTH - 1;
+    if (y1 >= SSD1306_GFX_HEIGHT) y1 = SSD1306_GFX_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    for (sint16 page = y0 / 8; page <= y1 / 8; page++) {
+        uint8 mask = 0xFF;
+
+        if (page == y0 / 8) mask &= (uint8)(0xFF << (y0 % 8));
+        if (page == y1 / 8) mask &= (uint8)(0xFF >> (7 - (y1 % 8)));
+
+        _FillColumns(&frame->buff[page][x0], mask, x1 - x0 + 1, color);
+        SSD1306_MarkDirty(frame, (uint8)page, (uint8)x0, (uint8)(x1 - x0 + 1));
+    }
+}
+
+static void _MarkArea(SSD1306_FrameBuffer *frame, sint16 x0, sint16 y0, sint16 x1, sint16 y1)
+{
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= SSD1306_GFX_WIDTH) x1 = SSD1306_GFX_WIDTH - 1;
+    if (y1 >= SSD1306_GFX_HEIGHT) y1 = SSD1306_GFX_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    for (sint16 page = y0 / 8; page <= y1 / 8; page++) {
+        SSD1306_MarkDirty(frame, (uint8)page, (uint8)x0, (uint8)(x1 - x0 + 1));
+    }
+}
+
+static void _PlotPixel(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, SSD1306_Color color)
+{
+    if (x < 0 || y < 0 || x >= SSD1306_GFX_WIDTH || y >= SSD1306_GFX_HEIGHT) {
+        return;
+    }
+
+    _Apply(&frame->buff[y / 8][x], (uint8)(0x01 << (y % 8)), color);
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef SSD1306_GFX_H
+#define SSD1306_GFX_H
+
+#include "SSD1306.h"
+
+#define SSD1306_GFX_WIDTH               SSD1306_MAX_SEG
+#define SSD1306_GFX_HEIGHT              (SSD1306_MAX_PAGE * SSD1306_SEG_LEN)
+
+typedef enum eSSD1306_Color {
+    SSD1306_Color_BLACK = 0,
+    SSD1306_Color_WHITE = 1,
+    SSD1306_Color_INVERT = 2                        /* XOR */
+} SSD1306_Color;
+
+/**
+ * @brief 1bpp sprite in GDDRAM layout: width bytes per 8 rows, top row in bit 0
+ */
+typedef struct _SSD1306_Sprite {
+    const uint8 *data;
+    uint8 width;
+    uint8 height;
+} SSD1306_Sprite;
+
+/**
+ * @brief Primitives draw into frame->buff and mark the touched columns dirty, SSD1306_Flush sends them
+ * Coordinates may be outside of the panel, everything is clipped to 128 x 64.
+ */
+extern void SSD1306_DrawPixel(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, SSD1306_Color color);
+extern void SSD1306_DrawHLine(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, sint16 width, SSD1306_Color color);
+/**
+ * @brief One byte mask per page instead of one pixel per row
+ */
+extern void SSD1306_DrawVLine(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, sint16 height, SSD1306_Color color);
+/**
+ * @brief Bresenham, horizontal / vertical lines go to the span functions
+ * Error term in sint32 over the whole sint16 range, the steps end where the line leaves the panel.
+ */
+extern void SSD1306_DrawLine(SSD1306_FrameBuffer *frame, sint16 x0, sint16 y0, sint16 x1, sint16 y1, SSD1306_Color color);
+extern void SSD1306_DrawRect(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, sint16 width, sint16 height, SSD1306_Color color);
+/**
+ * @brief Byte mask per page, memset for whole pages in black / white
+ */
+extern void SSD1306_FillRect(SSD1306_FrameBuffer *frame, sint16 x, sint16 y, sint16 width, sint16 height, SSD1306_Color color);
+/**
+ * @brief Midpoint circle, with SSD1306_Color_INVERT the pixels shared by two octants are flipped twice
+ */
+extern void SSD1306_DrawCircle(SSD1306_FrameBuffer *frame, sint16 xc, sint16 yc, sint16 radius, SSD1306_Color color);
+/**
+ * @brief Filled with vertical spans, black / white only
+ */
+extern void SSD1306_FillCircle(SSD1306_FrameBuffer *frame, sint16 xc, sint16 yc, sint16 radius, SSD1306_Color color);
+/**
+ * @brief Set bits of the sprite are drawn in color, clear bits leave the frame as it is
+ * Each sprite byte is shifted over two pages when y is not a multiple of 8.
+ */
+extern void SSD1306_BlitSprite(SSD1306_FrameBuffer *frame, const SSD1306_Sprite *sprite, sint16 x, sint16 y, SSD1306_Color color);
+
+#endif
\ No newline at end of file
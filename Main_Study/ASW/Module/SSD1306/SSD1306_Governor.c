@@ -0,0 +1,103 @@
+#include "SSD1306_Governor.h"
+#include "IfxCpu_Irq.h"
+#include "IfxStm.h"
+#include "_Utilities/Ifx_Assert.h"
+#include "ASW/ASW_CONFIG.h"
+
+static SSD1306_Governor *ssd1306_governor = NULL_PTR;
+
+IFX_INTERRUPT(SSD1306_FrameIsr, 0, ISR_PRIORITY_SSD1306_FRAME);
+
+void Init_SSD1306_Governor(SSD1306_Governor *gov, SSD1306_Inst *panels, uint8 count, uint32 periodUs)
+{
+    IfxStm_CompareConfig stmConfig;
+    boolean intEnabled;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, ssd1306_governor == NULL_PTR);
+    gov->panels = panels;
+    gov->count = count;
+    gov->periodTicks = IfxStm_getTicksFromMicroseconds(&MODULE_STM0, periodUs);
+    gov->period = 0;
+    gov->servedPeriod = 0;
+    SSD1306_ResetGovernorStats(gov);
+    ssd1306_governor = gov;
+
+    IfxStm_initCompareConfig(&stmConfig);
+    stmConfig.comparator = IfxStm_Comparator_0;
+    stmConfig.comparatorInterrupt = IfxStm_ComparatorInterrupt_ir0;
+    stmConfig.ticks = gov->periodTicks;
+    stmConfig.triggerPriority = ISR_PRIORITY_SSD1306_FRAME;
+    stmConfig.typeOfService = IfxCpu_Irq_getTos(IfxCpu_getCoreIndex());
+
+    /* CMCON / ICR are shared with comparator 1 (I2C retry backoff, armed from the I2C interrupts of this core):
+     * IfxStm_initCompare rewrites both, an arm in between would be lost */
+    intEnabled = IfxCpu_disableInterrupts();
+    IfxStm_initCompare(&MODULE_STM0, &stmConfig);
+    IfxCpu_restoreInterrupts(intEnabled);
+}
+
+boolean SSD1306_RunGovernor(SSD1306_Governor *gov)
+{
+    const uint32 period = gov->period;
+    boolean bDone = FALSE;
+
+    if (period != gov->servedPeriod) {
+        /* Frame boundary: What was posted until now is one frame, missed ticks are not made up */
+        gov->servedPeriod = period;
+        for (int i = 0; i < gov->count; i++) {
+            SSD1306_Inst *panel = &gov->panels[i];
+
+            if (panel->frontState == SSD1306_Front_FLUSHING) {
+                panel->stats.dropped++;     /* Bus saturated: The next frame waits for the next period */
+            } else {
+                SSD1306_StartFrame(panel);
+            }
+        }
+    }
+
+    for (int i = 0; i < gov->count; i++) {
+        if (SSD1306_FlushStep(&gov->panels[i])) {
+            bDone = TRUE;
+        }
+    }
+
+    return bDone;
+}
+
+void SSD1306_GetGovernorStats(SSD1306_Governor *gov, SSD1306_GovernorStats *stats)
+{
+    const float32 elapsed = (float32)(IfxStm_get(&MODULE_STM0) - gov->statsStart) / IfxStm_getFrequency(&MODULE_STM0);
+    float32 busTime = 0.0f;
+
+    stats->frames = 0;
+    stats->merged = 0;
+    stats->refused = 0;
+    stats->dropped = 0;
+    for (int i = 0; i < gov->count; i++) {
+        const SSD1306_Inst *panel = &gov->panels[i];
+
+        stats->frames += panel->stats.frames;
+        stats->merged += panel->stats.merged;
+        stats->refused += panel->stats.refused;
+        stats->dropped += panel->stats.dropped;
+        busTime += (float32)panel->stats.txBytes * 9.0f / panel->config->i2c.baudrate;
+    }
+
+    stats->fps = (elapsed > 0.0f) ? (stats->frames / elapsed) : 0.0f;
+    stats->busLoad = (elapsed > 0.0f) ? (busTime / elapsed) : 0.0f;
+}
+
+void SSD1306_ResetGovernorStats(SSD1306_Governor *gov)
+{
+    for (int i = 0; i < gov->count; i++) {
+        SSD1306_ResetStats(&gov->panels[i]);
+    }
+    gov->statsStart = IfxStm_get(&MODULE_STM0);
+}
+
+void SSD1306_FrameIsr(void)
+{
+    IfxStm_clearCompareFlag(&MODULE_STM0, IfxStm_Comparator_0);
+    IfxStm_increaseCompare(&MODULE_STM0, IfxStm_Comparator_0, ssd1306_governor->periodTicks);
+    ssd1306_governor->period++;
+}
\ No newline at end of file
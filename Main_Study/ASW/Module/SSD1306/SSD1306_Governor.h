@@ -0,0 +1,57 @@
+#ifndef SSD1306_GOVERNOR_H
+#define SSD1306_GOVERNOR_H
+
+#include "SSD1306.h"
+
+/**
+ * @brief Frame period scheduler of the flush core
+ * The render core draws as often as it likes and calls SSD1306_PostFrame, the posts between two periods are one frame.
+ * At each STM0 compare tick every panel with a posted frame starts it, a panel still on the bus skips the period.
+ * Bus load: at most one frame per panel per period / Latency: a draw is on the bus after one period + one frame.
+ */
+typedef struct _SSD1306_Governor {
+    SSD1306_Inst *panels;
+    uint8 count;
+    uint32 periodTicks;
+    volatile uint32 period;                         /* Counted by the STM0 comparator 0 interrupt */
+    uint32 servedPeriod;
+    uint64 statsStart;                              /* STM0 time of the last SSD1306_ResetGovernorStats */
+} SSD1306_Governor;
+
+typedef struct _SSD1306_GovernorStats {
+    float32 fps;                                    /* Frames of all panels per second */
+    float32 busLoad;                                /* 0 ~ 1: Bus time of the panel bytes (9 clocks each) per elapsed time */
+    uint32 frames;
+    uint32 merged;                                  /* Posted frames replaced by a later post */
+    uint32 refused;                                 /* Posts refused while the front was flushing */
+    uint32 dropped;                                 /* Periods a panel skipped, its last frame was still on the bus */
+} SSD1306_GovernorStats;
+
+/**
+ * @brief Start the frame period on STM0 comparator 0, interrupt on the calling (flush) core
+ * One governor per application (asserted): The interrupt has no other way to find it.
+ * Call it on the core of the I2C bus (Init_I2C): STM0 CMCON / ICR are shared with the I2C retry on comparator 1,
+ * their setup is serialized by the interrupt lock of that core only.
+ *
+ * @param gov
+ * @param panels Initialized panels (Init_SSD1306)
+ * @param count
+ * @param periodUs SSD1306_FRAME_PERIOD_US
+ */
+extern void Init_SSD1306_Governor(SSD1306_Governor *gov, SSD1306_Inst *panels, uint8 count, uint32 periodUs);
+/**
+ * @brief Flush core loop: Start the posted frames at a period tick, then the next run of each panel (SSD1306_FlushStep)
+ *
+ * @return boolean TRUE if a frame was finished
+ */
+extern boolean SSD1306_RunGovernor(SSD1306_Governor *gov);
+/**
+ * @brief Achieved rates since the last reset, summed over the panels
+ */
+extern void SSD1306_GetGovernorStats(SSD1306_Governor *gov, SSD1306_GovernorStats *stats);
+/**
+ * @brief SSD1306_ResetStats of every panel and a new time base
+ */
+extern void SSD1306_ResetGovernorStats(SSD1306_Governor *gov);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "SSD1306_Scroll.h"
+#include "_Utilities/Ifx_Assert.h"
+
+static uint8 ssd1306_scrollLine[SSD1306_GLYPH_MAX_PAGES][SSD1306_MAX_SEG];  /* One rendered line, SSD1306_Blit copies it */
+
+void SSD1306_InitLog(SSD1306_LogView *log, SSD1306_Inst *panel, const SSD1306_Font *font)
+{
+    log->panel = panel;
+    log->font = font;
+    log->linePages = font->pages * font->scale;
+    log->lineLen = panel->pageLen / log->linePages;
+    /* Lines must tile the GDDRAM ring: A line never wraps from page 7 to page 0 (SSD1306_Blit clips there) */
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, (log->linePages <= SSD1306_GLYPH_MAX_PAGES) && ((SSD1306_MAX_PAGE % log->linePages) == 0));
+    log->top = 0;
+    log->count = 0;
+
+    SSD1306_StopScroll(panel);              /* GDDRAM must not move under the ring */
+    SSD1306_SetStartLine(panel, 0);
+    SSD1306_ClearDisplay(panel);
+}
+
+void SSD1306_PushLog(SSD1306_LogView *log, const char *text)
+{
+    SSD1306_Inst *panel = log->panel;
+    uint8 page;
+
+    SSD1306_RenderText(&ssd1306_scrollLine[0][0], SSD1306_MAX_SEG, log->font, 0, text, SSD1306_MAX_SEG);
+
+    if (log->count < log->lineLen) {
+        /* Panel not full yet: Next free line below the others, nothing moves */
+        page = (uint8)((log->top + (log->count * log->linePages)) % SSD1306_MAX_PAGE);
+        log->count++;
+        SSD1306_Blit(panel, &ssd1306_scrollLine[0][0], SSD1306_MAX_SEG, page, log->linePages, 0, SSD1306_MAX_SEG);
+        return;
+    }
+
+    /* GDDRAM page right below the panel: The oldest line on 128x64, a hidden page on 128x32 */
+    page = (uint8)((log->top + (log->lineLen * log->linePages)) % SSD1306_MAX_PAGE);
+    log->top = (uint8)((log->top + log->linePages) % SSD1306_MAX_PAGE);
+    SSD1306_Blit(panel, &ssd1306_scrollLine[0][0], SSD1306_MAX_SEG, page, log->linePages, 0, SSD1306_MAX_SEG);
+    SSD1306_SetStartLine(panel, log->top * SSD1306_SEG_LEN);
+}
+
+void SSD1306_CloseLog(SSD1306_LogView *log)
+{
+    SSD1306_Inst *panel = log->panel;
+
+    log->count = 0;
+    log->top = 0;
+
+    SSD1306_SetStartLine(panel, 0);
+    SSD1306_ClearDisplay(panel);
+}
+
+void SSD1306_StartTicker(SSD1306_Inst *panel, const SSD1306_Font *font, uint8 startPage, const char *text, uint8 bLeft, uint8 interval)
+{
+    const uint8 linePages = font->pages * font->scale;
+
+    if (startPage + linePages > panel->pageLen) {
+        return;
+    }
+
+    SSD1306_StopScroll(panel);              /* GDDRAM is not written while it scrolls */
+    SSD1306_RenderText(&ssd1306_scrollLine[0][0], SSD1306_MAX_SEG, font, 0, text, SSD1306_MAX_SEG);
+    SSD1306_Blit(panel, &ssd1306_scrollLine[0][0], SSD1306_MAX_SEG, startPage, linePages, 0, SSD1306_MAX_SEG);
+    SSD1306_StartHorizontalScroll(panel, bLeft, startPage, startPage + linePages - 1, interval);
+}
+
+void SSD1306_StopTicker(SSD1306_Inst *panel)
+{
+    SSD1306_StopScroll(panel);
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef SSD1306_SCROLL_H
+#define SSD1306_SCROLL_H
+
+#include "SSD1306_Font.h"
+
+/**
+ * @brief Scrolling text log on the whole panel, the 8 GDDRAM pages used as a ring
+ * The display start line points at the oldest line. A new line goes into the page below the panel and the
+ * start line moves one line down: 1 line of GDDRAM data + 1 command byte per line instead of the whole frame.
+ */
+typedef struct _SSD1306_LogView {
+    SSD1306_Inst *panel;
+    const SSD1306_Font *font;
+    uint8 linePages;                                /* Pages of one line: font pages * scale */
+    uint8 lineLen;                                  /* Lines on the panel */
+    uint8 top;                                      /* GDDRAM page shown in the top row */
+    uint8 count;                                    /* Lines pushed, up to lineLen */
+} SSD1306_LogView;
+
+/**
+ * @brief Clear the panel and put the start line back to 0
+ * The line height (font pages * scale) must divide the 8 GDDRAM pages, asserted.
+ * While the log is in use the frame functions (SSD1306_Flush, SSD1306_FlushFrame) must not be used,
+ * their pages would appear rotated.
+ */
+extern void SSD1306_InitLog(SSD1306_LogView *log, SSD1306_Inst *panel, const SSD1306_Font *font);
+/**
+ * @brief Append text as the bottom line, the oldest line scrolls out when the panel is full
+ * Text wider than the panel is clipped.
+ */
+extern void SSD1306_PushLog(SSD1306_LogView *log, const char *text);
+/**
+ * @brief Start line back to 0, the panel is cleared for the frame functions
+ */
+extern void SSD1306_CloseLog(SSD1306_LogView *log);
+
+/**
+ * @brief Draw text into the pages from startPage on and let the controller rotate them (continuous horizontal scroll)
+ * The text wraps around at the panel edge, no I2C traffic while it moves. Text wider than the panel is clipped.
+ *
+ * @param panel
+ * @param font
+ * @param startPage
+ * @param text
+ * @param bLeft Left Horizontal Scroll
+ * @param interval Scroll step interval in terms of frame frequency (0 ~ 7)
+ */
+extern void SSD1306_StartTicker(SSD1306_Inst *panel, const SSD1306_Font *font, uint8 startPage, const char *text, uint8 bLeft, uint8 interval);
+/**
+ * @brief Stop the ticker, its pages hold the text at an unknown offset and have to be redrawn
+ */
+extern void SSD1306_StopTicker(SSD1306_Inst *panel);
+
+#endif
\ No newline at end of file
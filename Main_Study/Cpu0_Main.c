@@ -28,9 +28,42 @@
 #include "IfxCpu.h"
 #include "IfxScuWdt.h"
 
-#include "SSD1306.h"
+#include "SSD1306_Governor.h"
+#include "ASW/ASW_CONFIG.h"
 
 IFX_ALIGN(4) IfxCpu_syncEvent g_cpuSyncEvent = 0;
+IFX_ALIGN(4) SSD1306_Inst g_ssd1306[SSD1306_PANEL_LEN];          /* Flushed here, rendered on CPU1 */
+SSD1306_Governor g_ssd1306Governor;
+volatile boolean g_ssd1306Ready = FALSE;                        /* Set once the panels are initialized, CPU1 waits for it */
+
+/* Tools/ssd1306_image.py charmander.pbm g_charmander */
+/* charmander.pbm: 128x64, 1024 -> 288 bytes */
+static const uint8 g_charmanderData[] = {
+    0xE6, 0xFF, 0xFB, 0x7F, 0xFB, 0xDF, 0xF8, 0x9F, 0xFB, 0x7F, 0xCB, 0xFF, 0xFE, 0xE3, 0xDE, 0xFF,
+    0xFE, 0x1F, 0xFE, 0xF3, 0xFE, 0xFE, 0xF2, 0xFF, 0xFE, 0x3F, 0xFE, 0xDF, 0xFB, 0xFF, 0xFE, 0xF8,
+    0xFE, 0x07, 0xFE, 0x3F, 0xDD, 0xFF, 0xFE, 0x07, 0xD8, 0xFF, 0xFE, 0x3F, 0xFE, 0x88, 0xFE, 0xF8,
+    0xEF, 0xFF, 0xFE, 0xFE, 0xFE, 0xB9, 0xFE, 0x00, 0xFE, 0x70, 0xF8, 0x00, 0xE3, 0xFF, 0xFE, 0x0F,
+    0xFE, 0xC0, 0xFE, 0xFF, 0xFE, 0xF7, 0xFE, 0xF9, 0xFE, 0xF7, 0xFE, 0x07, 0xEA, 0xFF, 0xFB, 0x7F,
+    0xFE, 0xFC, 0xFE, 0xE3, 0xFE, 0xEF, 0xFB, 0x1F, 0xFE, 0x1D, 0xFE, 0x1F, 0xFB, 0x0F, 0xFE, 0x03,
+    0xFE, 0x11, 0xF2, 0x00, 0xFE, 0x83, 0xFE, 0x9F, 0xFB, 0x0F, 0xEF, 0xFF, 0xFE, 0xE2, 0xFE, 0x8F,
+    0xFE, 0x1D, 0xF8, 0x1F, 0xFE, 0x00, 0xFE, 0x81, 0xF0, 0xFF, 0xFE, 0xE7, 0xFB, 0xC0, 0xFB, 0x0C,
+    0xFB, 0x1C, 0xFB, 0x00, 0xFE, 0x03, 0xFE, 0xE3, 0xFE, 0xF8, 0xFB, 0xFC, 0xFE, 0xFF, 0xFE, 0xFC,
+    0xFE, 0x00, 0xFB, 0x0F, 0xFB, 0x83, 0xFE, 0x18, 0xFE, 0x38, 0xFE, 0xFC, 0xF2, 0xFF, 0xFE, 0x7F,
+    0xFB, 0x9F, 0xFE, 0xE4, 0xFE, 0xDC, 0xFF, 0x0C, 0x00, 0x04, 0xFE, 0xE3, 0xDB, 0xFF, 0xFB, 0xFC,
+    0xFE, 0xE0, 0xFE, 0x9C, 0xE6, 0xFF, 0xFE, 0x1F, 0xFB, 0xFF, 0xFE, 0xF8, 0xFE, 0xC7, 0xFE, 0x07,
+    0xFE, 0x03, 0xFE, 0x83, 0xFE, 0x80, 0xFE, 0x84, 0xFE, 0xF7, 0xFE, 0x37, 0xFE, 0x3B, 0xFF, 0xDE,
+    0x00, 0xCE, 0xFE, 0xE7, 0xFE, 0xFC, 0xD5, 0xFF, 0xFE, 0xC1, 0xFE, 0x3E, 0xFE, 0x7F, 0xFE, 0x78,
+    0xFE, 0x37, 0xFE, 0x0F, 0xFB, 0x3F, 0xF8, 0x7F, 0xFE, 0x00, 0xFE, 0x0E, 0xF8, 0x3F, 0xFE, 0x0F,
+    0xFE, 0x06, 0xFE, 0x00, 0xFE, 0x81, 0xFB, 0xF7, 0xFE, 0xF9, 0xFE, 0xFE, 0xCC, 0xFF, 0xFE, 0xF3,
+    0xFE, 0xED, 0xFE, 0xE0, 0xFE, 0xEC, 0xFB, 0xE0, 0xFE, 0xF0, 0xFE, 0xFC, 0xEF, 0xFE, 0xFE, 0xF0,
+    0xFE, 0xE2, 0xFE, 0x9E, 0xFE, 0x8E, 0xFE, 0x9C, 0xFE, 0x80, 0xFE, 0x93, 0xFE, 0xEF, 0xDB, 0xFF,
+};
+static const SSD1306_Image g_charmander = {
+    .data = g_charmanderData,
+    .size = sizeof(g_charmanderData),
+    .pageLen = 8,
+    .columnLen = 128
+};
 
 void core0_main(void)
 {
@@ -46,8 +79,17 @@ void core0_main(void)
     IfxCpu_emitEvent(&g_cpuSyncEvent);
     IfxCpu_waitEvent(&g_cpuSyncEvent, 1);
     
-    Init_SSD1306();
+    for (int i = 0; i < SSD1306_PANEL_LEN; i++) {
+        Init_SSD1306(&g_ssd1306[i], &SSD1306_PanelConfig[i]);
+        if (g_ssd1306[i].pageLen == g_charmander.pageLen) {
+            SSD1306_DrawImage(&g_ssd1306[i], &g_charmander, 0, 0);  /* Boot image, the 128x32 panel is too small for it */
+        }
+    }
+    __dsync();                                                  /* pageLen / frame state before the flag */
+    g_ssd1306Ready = TRUE;
+    Init_SSD1306_Governor(&g_ssd1306Governor, g_ssd1306, SSD1306_PANEL_LEN, SSD1306_FRAME_PERIOD_US);
     while(1)
     {
+        SSD1306_RunGovernor(&g_ssd1306Governor);                /* Frames are rendered on CPU1 */
     }
 }
@@ -27,8 +27,14 @@
 #include "Ifx_Types.h"
 #include "IfxCpu.h"
 #include "IfxScuWdt.h"
+#include "IfxStm.h"
+
+#include "SSD1306_Gfx.h"
+#include "ASW/ASW_CONFIG.h"
 
 extern IfxCpu_syncEvent g_cpuSyncEvent;
+extern SSD1306_Inst g_ssd1306[SSD1306_PANEL_LEN];
+extern volatile boolean g_ssd1306Ready;
 
 void core1_main(void)
 {
@@ -43,7 +49,28 @@ void core1_main(void)
     IfxCpu_emitEvent(&g_cpuSyncEvent);
     IfxCpu_waitEvent(&g_cpuSyncEvent, 1);
     
+    /* pageLen and the frame state are set by Init_SSD1306 on CPU0 */
+    while (g_ssd1306Ready == FALSE);
+
+    const uint32 stepTicks = IfxStm_getTicksFromMicroseconds(&MODULE_STM0, 2000);
+    sint16 x = 0;
     while(1)
     {
+        const sint16 last = x;
+
+        /* Bar moves with time, not with the frame rate: CPU0 shows it at SSD1306_FRAME_PERIOD_US */
+        x = (sint16)((IfxStm_getLower(&MODULE_STM0) / stepTicks) % (SSD1306_MAX_SEG - 8));
+        if (x == last) {
+            continue;
+        }
+        for (int i = 0; i < SSD1306_PANEL_LEN; i++) {
+            /* Render the next frame while CPU0 streams the last one, bar on the bottom of each panel */
+            SSD1306_FrameBuffer *frame = SSD1306_GetBackFrame(&g_ssd1306[i]);
+            const sint16 y = (g_ssd1306[i].pageLen * SSD1306_SEG_LEN) - 16;
+
+            SSD1306_FillRect(frame, last, y, 8, 16, SSD1306_Color_BLACK);
+            SSD1306_FillRect(frame, x, y, 8, 16, SSD1306_Color_WHITE);
+            SSD1306_PostFrame(&g_ssd1306[i]);               /* Refused while flushing: The next post carries it */
+        }
     }
 }
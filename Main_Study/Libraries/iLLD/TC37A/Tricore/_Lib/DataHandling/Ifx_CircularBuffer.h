@@ -57,6 +57,17 @@
 /** \addtogroup IfxLld_lib_datahandling_circularbuffer
  * \{
  */
+/** \brief Contiguous regions of a circular buffer area
+ *
+ * The area starts at the buffer index. If it wraps around, the second region
+ * starts at the buffer base, else count[1] is 0.
+ */
+typedef struct
+{
+    void     *data[2];          /**< \brief start address of the regions */
+    Ifx_SizeT count[2];         /**< \brief size of the regions in bytes */
+} Ifx_CircularBuffer_Span;
+
 /** \brief Return the circular buffer 16 bit value, and post-increment the circular buffer pointer
  *
  * \param buffer Specifies circular buffer.
@@ -113,6 +124,48 @@ const void *Ifx_CircularBuffer_write8(Ifx_CircularBuffer *buffer, const void *da
  */
 const void *Ifx_CircularBuffer_write32(Ifx_CircularBuffer *buffer, const void *data, Ifx_SizeT count);
 
+/** \brief Return the regions of the next count bytes, without copy and without moving the index
+ *
+ * The regions can be written in place of Ifx_CircularBuffer_write8() or read in place of
+ * Ifx_CircularBuffer_read8(), Ifx_CircularBuffer_advance() then moves the index over them.
+ *
+ * \param buffer Specifies circular buffer.
+ * \param count Specifies number of bytes. count MUST be <= buffer->length.
+ * \param span Returns the regions.
+ *
+ * \return None.
+ */
+IFX_INLINE void Ifx_CircularBuffer_getSpan(const Ifx_CircularBuffer *buffer, Ifx_SizeT count, Ifx_CircularBuffer_Span *span)
+{
+    Ifx_SizeT first = __min(count, (Ifx_SizeT)(buffer->length - buffer->index));
+
+    span->data[0]  = &((uint8 *)buffer->base)[buffer->index];
+    span->count[0] = first;
+    span->data[1]  = buffer->base;
+    span->count[1] = count - first;
+}
+
+
+/** \brief Move the circular buffer index by count bytes
+ *
+ * \param buffer Specifies circular buffer.
+ * \param count Specifies number of bytes. count MUST be <= buffer->length.
+ *
+ * \return None.
+ */
+IFX_INLINE void Ifx_CircularBuffer_advance(Ifx_CircularBuffer *buffer, Ifx_SizeT count)
+{
+    uint32 index = (uint32)buffer->index + (uint32)count;
+
+    if (index >= buffer->length)
+    {
+        index -= buffer->length;
+    }
+
+    buffer->index = (uint16)index;
+}
+
+
 /** \} */
 //---------------------------------------------------------------------------
 #endif
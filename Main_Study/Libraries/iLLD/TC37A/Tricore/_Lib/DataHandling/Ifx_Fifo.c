@@ -413,4 +413,80 @@ Ifx_SizeT Ifx_Fifo_write(Ifx_Fifo *fifo, const void *data, Ifx_SizeT count, Ifx_
     return count;
 }
 
+
+Ifx_SizeT Ifx_Fifo_reserve(Ifx_Fifo *fifo, Ifx_SizeT count, Ifx_CircularBuffer_Span *span)
+{
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, span != NULL_PTR);
+
+    count         = __min(count, Ifx_Fifo_writeCount(fifo));    /* Only the reader modify it, and only to increase it */
+    count        -= count % fifo->elementSize;
+    buffer.base   = fifo->buffer;
+    buffer.length = (uint16)fifo->size;
+    buffer.index  = (uint16)fifo->endIndex;
+    Ifx_CircularBuffer_getSpan(&buffer, count, span);
+
+    return count;
+}
+
+
+void Ifx_Fifo_commit(Ifx_Fifo *fifo, Ifx_SizeT count)
+{
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, (count % fifo->elementSize) == 0);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, count <= Ifx_Fifo_writeCount(fifo));
+
+    if (count != 0)
+    {
+        buffer.base   = fifo->buffer;
+        buffer.length = (uint16)fifo->size;
+        buffer.index  = (uint16)fifo->endIndex;
+        Ifx_CircularBuffer_advance(&buffer, count);
+        fifo->endIndex = buffer.index;
+        Ifx_Fifo_endWrite(fifo, count, count);
+    }
+}
+
+
+Ifx_SizeT Ifx_Fifo_peek(Ifx_Fifo *fifo, Ifx_SizeT count, Ifx_CircularBuffer_Span *span)
+{
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, span != NULL_PTR);
+
+    count         = __min(count, Ifx_Fifo_readCount(fifo));     /* Only the writer modify it, and only to increase it */
+    count        -= count % fifo->elementSize;
+    buffer.base   = fifo->buffer;
+    buffer.length = (uint16)fifo->size;
+    buffer.index  = (uint16)fifo->startIndex;
+    Ifx_CircularBuffer_getSpan(&buffer, count, span);
+
+    return count;
+}
+
+
+void Ifx_Fifo_release(Ifx_Fifo *fifo, Ifx_SizeT count)
+{
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, (count % fifo->elementSize) == 0);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, count <= Ifx_Fifo_readCount(fifo));
+
+    if (count != 0)
+    {
+        buffer.base   = fifo->buffer;
+        buffer.length = (uint16)fifo->size;
+        buffer.index  = (uint16)fifo->startIndex;
+        Ifx_CircularBuffer_advance(&buffer, count);
+        fifo->startIndex = buffer.index;
+        Ifx_Fifo_readEnd(fifo, count, count);
+    }
+}
+
 //------------------------------------------------------------------------------
@@ -49,6 +49,7 @@
 //------------------------------------------------------------------------------
 #include "Ifx_Cfg.h"
 #include "Cpu/Std/IfxCpu_Intrinsics.h"
+#include "Ifx_CircularBuffer.h"
 //------------------------------------------------------------------------------
 
 /** Shared data of the FIFO
@@ -176,6 +177,53 @@ IFX_EXTERN Ifx_SizeT Ifx_Fifo_read(Ifx_Fifo *fifo, void *data, Ifx_SizeT count,
  */
 IFX_EXTERN Ifx_SizeT Ifx_Fifo_write(Ifx_Fifo *fifo, const void *data, Ifx_SizeT count, Ifx_TickTime timeout);
 
+/** \brief Return the free space of the fifo for a zero copy write
+ *
+ * The data are written in place into the returned regions, then published with
+ * Ifx_Fifo_commit(). Between both calls the fifo is not modified, a driver may
+ * format or DMA directly into the regions.
+ * Only complete elements are reserved, the function does not wait.
+ *
+ * \param fifo Pointer on the Fifo object
+ * \param count in bytes
+ * \param span Returns the free regions, at most count bytes
+ *
+ * \return Returns the number of bytes reserved
+ */
+IFX_EXTERN Ifx_SizeT Ifx_Fifo_reserve(Ifx_Fifo *fifo, Ifx_SizeT count, Ifx_CircularBuffer_Span *span);
+
+/** \brief Publish data written in place after Ifx_Fifo_reserve()
+ *
+ * \param fifo Pointer on the Fifo object
+ * \param count in bytes, a multiple of elementSize not bigger than the reserved count
+ *
+ * \return None
+ */
+IFX_EXTERN void Ifx_Fifo_commit(Ifx_Fifo *fifo, Ifx_SizeT count);
+
+/** \brief Return the data of the fifo for a zero copy read
+ *
+ * The data are read in place from the returned regions, then removed from the
+ * buffer with Ifx_Fifo_release().
+ * Only complete elements are returned, the function does not wait.
+ *
+ * \param fifo Pointer on the Fifo object
+ * \param count in bytes
+ * \param span Returns the data regions, at most count bytes
+ *
+ * \return Returns the number of bytes available in the regions
+ */
+IFX_EXTERN Ifx_SizeT Ifx_Fifo_peek(Ifx_Fifo *fifo, Ifx_SizeT count, Ifx_CircularBuffer_Span *span);
+
+/** \brief Remove data read in place after Ifx_Fifo_peek()
+ *
+ * \param fifo Pointer on the Fifo object
+ * \param count in bytes, a multiple of elementSize not bigger than the peeked count
+ *
+ * \return None
+ */
+IFX_EXTERN void Ifx_Fifo_release(Ifx_Fifo *fifo, Ifx_SizeT count);
+
 /** \brief Empty the fifo
  *
  * \param fifo Pointer on the Fifo object
@@ -0,0 +1,140 @@
+/**
+ * \file Ifx_MpscQueue.c
+ * \brief Lock free multi producer / single consumer queue of fixed size records
+ */
+
+//------------------------------------------------------------------------------
+#include "Ifx_MpscQueue.h"
+#include <string.h>
+#include "_Utilities/Ifx_Assert.h"
+//------------------------------------------------------------------------------
+/*
+ * Note: slot sequence numbers, for the position pos of a slot:
+ * - sequence == pos: the slot is free, a writer may claim position pos
+ * - sequence == pos + 1: the record of position pos is written, the reader may read it
+ * - sequence == pos + slotCount: the record is read, the slot is free for the next round
+ * A writer claims pos with a compare and swap of the tail from pos to pos + 1, then
+ * owns the slot alone: the record is copied, completed with DSYNC and published by the
+ * sequence store. Writers never wait for each other, a writer interrupted after the
+ * claim on its own CPU does not block the interrupt, which simply claims the next slot.
+ * All positions are free running 32 bit values compared by signed difference.
+ */
+#if IFX_CFG_MPSCQUEUE_HOST
+#define Ifx_MpscQueue_load(address)                 __atomic_load_n((address), __ATOMIC_ACQUIRE)
+#define Ifx_MpscQueue_store(address, value)         __atomic_store_n((address), (value), __ATOMIC_RELEASE)
+#define Ifx_MpscQueue_barrier()                     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define Ifx_MpscQueue_cmpSwap(address, value, condition) \
+    __sync_val_compare_and_swap((address), (condition), (value))
+#else
+#define Ifx_MpscQueue_load(address)                 (*(address))
+#define Ifx_MpscQueue_store(address, value)         (*(address) = (value))
+#define Ifx_MpscQueue_barrier()                     __dsync()
+#define Ifx_MpscQueue_cmpSwap(address, value, condition) \
+    ((uint32)__cmpAndSwap(((unsigned int *)(address)), (value), (condition)))
+#endif
+
+/** \brief Return the sequence number of the slot of position pos */
+#define Ifx_MpscQueue_sequence(queue, pos) ((volatile uint32 *)&(queue)->slots[((pos) & (queue)->mask) * (uint32)(queue)->slotSize])
+
+//------------------------------------------------------------------------------
+Ifx_MpscQueue *Ifx_MpscQueue_init(void *buffer, uint32 slotCount, Ifx_SizeT recordSize)
+{
+    Ifx_MpscQueue *queue = NULL_PTR;
+    uint32         pos;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, (slotCount >= 2) && ((slotCount & (slotCount - 1)) == 0));
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, recordSize > 0);
+
+    {
+        queue             = (Ifx_MpscQueue *)Ifx_AlignOn256((uint32)(size_t)buffer);
+        queue->slots      = (uint8 *)Ifx_AlignOn64(((uint32)(size_t)queue) + sizeof(Ifx_MpscQueue));
+        queue->mask       = slotCount - 1;
+        queue->recordSize = recordSize;
+        queue->slotSize   = (Ifx_SizeT)IFX_MPSCQUEUE_SLOT_SIZE(recordSize);
+        queue->tail.value = 0;
+        queue->head.value = 0;
+
+        for (pos = 0; pos < slotCount; pos++)
+        {
+            *Ifx_MpscQueue_sequence(queue, pos) = pos;
+        }
+
+        Ifx_MpscQueue_barrier();    /* object complete before it is handed to the other CPUs */
+    }
+
+    return queue;
+}
+
+
+boolean Ifx_MpscQueue_write(Ifx_MpscQueue *queue, const void *record)
+{
+    volatile uint32 *sequence;
+    uint32           pos;
+    uint32           claimed;
+    sint32           diff;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, queue != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, record != NULL_PTR);
+
+    pos = Ifx_MpscQueue_load(&queue->tail.value);
+
+    for ( ; ; )
+    {
+        sequence = Ifx_MpscQueue_sequence(queue, pos);
+        diff     = (sint32)(Ifx_MpscQueue_load(sequence) - pos);
+
+        if (diff == 0)
+        {
+            /* Slot free: claim the position */
+            claimed = Ifx_MpscQueue_cmpSwap(&queue->tail.value, pos + 1, pos);
+
+            if (claimed == pos)
+            {
+                break;
+            }
+
+            pos = claimed;  /* Another writer was faster, retry at the actual tail */
+        }
+        else if (diff < 0)
+        {
+            /* The slot of the previous round is not read yet: queue full */
+            return FALSE;
+        }
+        else
+        {
+            pos = Ifx_MpscQueue_load(&queue->tail.value);
+        }
+    }
+
+    memcpy((void *)&sequence[1], record, (size_t)queue->recordSize);
+    Ifx_MpscQueue_barrier();        /* Record written before it is published */
+    Ifx_MpscQueue_store(sequence, pos + 1);
+
+    return TRUE;
+}
+
+
+boolean Ifx_MpscQueue_read(Ifx_MpscQueue *queue, void *record)
+{
+    volatile uint32 *sequence;
+    uint32           pos;
+    boolean          result = FALSE;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, queue != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, record != NULL_PTR);
+
+    pos      = queue->head.value;
+    sequence = Ifx_MpscQueue_sequence(queue, pos);
+
+    if (Ifx_MpscQueue_load(sequence) == (pos + 1))
+    {
+        Ifx_MpscQueue_barrier();    /* Sequence loaded before the record */
+        memcpy(record, (const void *)&sequence[1], (size_t)queue->recordSize);
+        Ifx_MpscQueue_barrier();    /* Record read before the slot is released */
+        Ifx_MpscQueue_store(sequence, pos + queue->mask + 1);
+        queue->head.value = pos + 1;
+        result            = TRUE;
+    }
+
+    return result;
+}
@@ -0,0 +1,109 @@
+/**
+ * \file Ifx_MpscQueue.h
+ * \brief Lock free multi producer / single consumer queue of fixed size records
+ * \ingroup IfxLld_lib_datahandling_mpscqueue
+ *
+ * \defgroup IfxLld_lib_datahandling_mpscqueue MPSC queue
+ * This module implements a queue of fixed size records with any number of
+ * writers (threads and interrupts on all CPUs) and one reader. A writer claims
+ * a slot with a compare and swap on the tail, and each slot carries a sequence
+ * number telling if it is free, written or read. No global lock and no
+ * interrupt masking is used.
+ * \ingroup IfxLld_lib_datahandling
+ *
+ */
+
+#ifndef IFX_MPSCQUEUE_H
+#define IFX_MPSCQUEUE_H 1
+//------------------------------------------------------------------------------
+#include "Ifx_Cfg.h"
+#include "Cpu/Std/IfxCpu_Intrinsics.h"
+//------------------------------------------------------------------------------
+
+#ifndef IFX_CFG_MPSCQUEUE_HOST
+#if defined(__TASKING__) || defined(__HIGHTEC__) || defined(__DCC__) || defined(__ghs__) || defined(__tricore__)
+#define IFX_CFG_MPSCQUEUE_HOST (0)
+#else
+#define IFX_CFG_MPSCQUEUE_HOST (1)      /* Host build: compiler atomics replace cmpswap.w and dsync */
+#endif
+#endif
+
+/** \brief Bytes of a slot for records of recordSize bytes */
+#define IFX_MPSCQUEUE_SLOT_SIZE(recordSize)          (Ifx_AlignOn32(sizeof(uint32) + (recordSize)))
+
+/** \brief Bytes required by Ifx_MpscQueue_init() for slotCount records of recordSize bytes */
+#define IFX_MPSCQUEUE_MEMORY_SIZE(slotCount, recordSize) \
+    (sizeof(Ifx_MpscQueue) + IFX_ALIGN_256 + ((slotCount) * IFX_MPSCQUEUE_SLOT_SIZE(recordSize)))
+
+/** \addtogroup IfxLld_lib_datahandling_mpscqueue
+ * \{ */
+/** Queue position, padded to a full cache line
+ *
+ */
+typedef union
+{
+    volatile uint32 value;              /**< \brief free running position */
+    uint8           line[IFX_ALIGN_256];
+} Ifx_MpscQueue_Index;
+
+/** MPSC queue object
+ *
+ * The object is aligned on a cache line, so that the tail (stored by all the
+ * writers) and the head (stored by the reader) never share a line.
+ */
+typedef struct
+{
+    Ifx_MpscQueue_Index tail;           /**< \brief next position to be claimed by a writer */
+    Ifx_MpscQueue_Index head;           /**< \brief next position to be read, stored by the reader only */
+    uint8              *slots;          /**< \brief slotCount slots: sequence number followed by the record */
+    uint32              mask;           /**< \brief slotCount - 1 */
+    Ifx_SizeT           recordSize;     /**< \brief bytes of a record */
+    Ifx_SizeT           slotSize;       /**< \brief bytes of a slot, multiple of 32 bit */
+} Ifx_MpscQueue;
+
+/** \brief Initialize the MPSC queue object
+ *
+ * \param buffer Specifies the queue object address.
+ * \param slotCount Specifies the number of records, must be a power of 2
+ * \param recordSize Specifies the record size in bytes
+ *
+ * \return Returns a pointer on the queue object
+ *
+ * \note: The buffer parameter must point on a free memory location of at least
+ * IFX_MPSCQUEUE_MEMORY_SIZE(slotCount, recordSize) bytes.
+ *
+ * \note: As for Ifx_SpscFifo, the memory must be accessed uncached by all the CPUs
+ * (DSPR or LMU through the non cached segment) using its global address.
+ */
+IFX_EXTERN Ifx_MpscQueue *Ifx_MpscQueue_init(void *buffer, uint32 slotCount, Ifx_SizeT recordSize);
+
+/** \brief Add a record to the queue
+ *
+ * May be called concurrently by any number of writers, from threads or interrupts
+ * on any CPU. The function does not wait, neither for the reader nor for the other writers.
+ *
+ * \param queue Pointer on the queue object
+ * \param record Pointer on recordSize bytes
+ *
+ * \retval TRUE the record is added
+ * \retval FALSE the queue is full, the record is dropped
+ */
+IFX_EXTERN boolean Ifx_MpscQueue_write(Ifx_MpscQueue *queue, const void *record);
+
+/** \brief Remove the oldest record from the queue
+ *
+ * Must only be called by the single reader. The records are returned in the order
+ * their slots were claimed. A writer which claimed a slot but did not complete it
+ * yet holds back the records behind it.
+ *
+ * \param queue Pointer on the queue object
+ * \param record Pointer on recordSize bytes for storing the record
+ *
+ * \retval TRUE a record is returned
+ * \retval FALSE no complete record is available
+ */
+IFX_EXTERN boolean Ifx_MpscQueue_read(Ifx_MpscQueue *queue, void *record);
+
+/**\}*/
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,131 @@
+/**
+ * \file Ifx_SpscFifo.c
+ * \brief Lock free single producer / single consumer FIFO between two CPUs
+ */
+
+//------------------------------------------------------------------------------
+#include "Ifx_SpscFifo.h"
+#include "Ifx_CircularBuffer.h"
+#include "_Utilities/Ifx_Assert.h"
+#include "Stm/Std/IfxStm.h"
+//------------------------------------------------------------------------------
+/*
+ * Note: the SPSC fifo exchanges data between one writer and one reader which may
+ * run on different CPUs:
+ * - writer.total is only stored by the writer, reader.total only by the reader.
+ * The other side only loads it, so no read-modify-write is shared and no lock
+ * or interrupt disable is required
+ * - the 32 bit accesses to the totals are atomic. The totals are free running,
+ * the count is the unsigned difference and stays valid over the wrap around
+ * - publication order: the data accesses are completed (DSYNC) before the own
+ * total is stored, and the other total is loaded and DSYNC'ed before the data
+ * are accessed. The other CPU therefore never sees an index ahead of the data
+ * - writer and reader total are on different cache lines, a CPU never stores to
+ * the line polled by the other one
+ * - Only one reader and one writer are allowed by FIFO, no nested read write
+ *
+ */
+//------------------------------------------------------------------------------
+Ifx_SpscFifo *Ifx_SpscFifo_init(void *buffer, Ifx_SizeT size, Ifx_SizeT elementSize)
+{
+    Ifx_SpscFifo *fifo = NULL_PTR;
+
+    size = Ifx_AlignOn32(size);     /* data transfer is optimised for 32 bit access */
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, (elementSize > 0) && (elementSize <= size));
+    /* Check size over maximum FIFO size */
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, (size <= IFX_SIZET_MAX));
+
+    {
+        fifo                    = (Ifx_SpscFifo *)Ifx_AlignOn256((uint32)(size_t)buffer);
+        fifo->buffer            = (uint8 *)Ifx_AlignOn64(((uint32)(size_t)fifo) + sizeof(Ifx_SpscFifo));
+        fifo->writer.B.total    = 0;
+        fifo->writer.B.index    = 0;
+        fifo->writer.B.maxcount = 0;
+        fifo->reader.B.total    = 0;
+        fifo->reader.B.index    = 0;
+        fifo->size              = size;
+        fifo->elementSize       = elementSize;
+        __dsync();                  /* object complete before it is handed to the other CPU */
+    }
+
+    return fifo;
+}
+
+
+Ifx_SizeT Ifx_SpscFifo_read(Ifx_SpscFifo *fifo, void *data, Ifx_SizeT count, Ifx_TickTime timeout)
+{
+    Ifx_TickTime       deadLine;
+    Ifx_SizeT          blockSize;
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, data != NULL_PTR);
+
+    if (count >= fifo->elementSize)
+    {
+        buffer.base   = fifo->buffer;
+        buffer.length = (uint16)fifo->size;             /* size always fit into 16 bit */
+        buffer.index  = (uint16)fifo->reader.B.index;   /* index always fit into size */
+        deadLine      = IfxStm_getDeadLine(timeout);
+
+        do
+        {
+            blockSize = Ifx_SpscFifo_readCount(fifo);   /* Load the writer total */
+            __dsync();                                  /* ... before the data it covers */
+            blockSize  = __min(count, blockSize);
+            blockSize -= blockSize % fifo->elementSize;
+
+            if (blockSize != 0)
+            {
+                data                  = Ifx_CircularBuffer_read8(&buffer, data, blockSize);
+                __dsync();                              /* Data read before the space is released */
+                fifo->reader.B.total += (uint32)blockSize;
+                count                -= blockSize;
+            }
+        } while ((count >= fifo->elementSize) && (IfxStm_isDeadLine(deadLine) == FALSE));
+
+        fifo->reader.B.index = buffer.index;
+    }
+
+    return count;
+}
+
+
+Ifx_SizeT Ifx_SpscFifo_write(Ifx_SpscFifo *fifo, const void *data, Ifx_SizeT count, Ifx_TickTime timeout)
+{
+    Ifx_TickTime       deadLine;
+    Ifx_SizeT          blockSize;
+    Ifx_CircularBuffer buffer;
+
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, fifo != NULL_PTR);
+    IFX_ASSERT(IFX_VERBOSE_LEVEL_ERROR, data != NULL_PTR);
+
+    if (count >= fifo->elementSize)
+    {
+        buffer.base   = fifo->buffer;
+        buffer.length = (uint16)fifo->size;             /* size always fit into 16 bit */
+        buffer.index  = (uint16)fifo->writer.B.index;   /* index always fit into size */
+        deadLine      = IfxStm_getDeadLine(timeout);
+
+        do
+        {
+            blockSize = Ifx_SpscFifo_writeCount(fifo);  /* Load the reader total */
+            __dsync();                                  /* ... before the space it frees is written */
+            blockSize  = __min(count, blockSize);
+            blockSize -= blockSize % fifo->elementSize;
+
+            if (blockSize != 0)
+            {
+                data                    = Ifx_CircularBuffer_write8(&buffer, data, blockSize);
+                __dsync();                              /* Data written before they are published */
+                fifo->writer.B.total   += (uint32)blockSize;
+                count                  -= blockSize;
+                fifo->writer.B.maxcount = __max(fifo->writer.B.maxcount, Ifx_SpscFifo_readCount(fifo));
+            }
+        } while ((count >= fifo->elementSize) && (IfxStm_isDeadLine(deadLine) == FALSE));
+
+        fifo->writer.B.index = buffer.index;
+    }
+
+    return count;
+}
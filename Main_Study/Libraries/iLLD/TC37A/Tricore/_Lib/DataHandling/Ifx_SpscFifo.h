@@ -0,0 +1,155 @@
+/**
+ * \file Ifx_SpscFifo.h
+ * \brief Lock free single producer / single consumer FIFO between two CPUs
+ * \ingroup IfxLld_lib_datahandling_spscfifo
+ *
+ * \defgroup IfxLld_lib_datahandling_spscfifo SPSC FIFO
+ * This module implements a FIFO for one writer and one reader running on two
+ * different CPUs. No lock and no interrupt masking is used: each side only
+ * stores to its own index, and the index is published after the data with a
+ * DSYNC barrier in between.
+ *
+ * The object is not an \ref Ifx_Fifo: Ifx_Fifo keeps one shared count that
+ * both sides read-modify-write under a disabled interrupt, which is not atomic
+ * across CPUs. Here each side only owns a running total, the fill level is the
+ * difference of the two. The API follows the Ifx_Fifo one (init, read, write,
+ * readCount, writeCount, isEmpty) and the copy uses \ref Ifx_CircularBuffer.
+ * \ingroup IfxLld_lib_datahandling
+ *
+ */
+
+#ifndef IFX_SPSCFIFO_H
+#define IFX_SPSCFIFO_H 1
+//------------------------------------------------------------------------------
+#include "Ifx_Cfg.h"
+#include "Cpu/Std/IfxCpu_Intrinsics.h"
+//------------------------------------------------------------------------------
+
+/** \brief Size of a data cache line in bytes (TC3xx: 256 bit) */
+#define IFX_SPSCFIFO_LINE_SIZE (IFX_ALIGN_256)
+
+/** \addtogroup IfxLld_lib_datahandling_spscfifo
+ * \{ */
+/** Index owned by one side of the FIFO, padded to a full cache line
+ *
+ */
+typedef union
+{
+    struct
+    {
+        volatile uint32 total;      /**< \brief bytes passed by the owner since the init, free running. Only stored by the owner */
+        Ifx_SizeT       index;      /**< \brief position of the owner in the buffer. Only used by the owner */
+        Ifx_SizeT       maxcount;   /**< \brief highest value seen in the count, kept by the writer */
+    }     B;
+    uint8 line[IFX_SPSCFIFO_LINE_SIZE];
+} Ifx_SpscFifo_Index;
+
+/** SPSC Fifo object
+ *
+ * The object is aligned on IFX_SPSCFIFO_LINE_SIZE, so that writer and reader
+ * index never share a cache line.
+ */
+typedef struct
+{
+    Ifx_SpscFifo_Index writer;              /**< \brief stored by the writer CPU only */
+    Ifx_SpscFifo_Index reader;              /**< \brief stored by the reader CPU only */
+    void              *buffer;              /**< \brief aligned on 64 bit boundary */
+    Ifx_SizeT          size;                /**< \brief multiple of 32 bit */
+    Ifx_SizeT          elementSize;         /**< \brief minimum number of bytes (block) added / removed to / from the buffer */
+} Ifx_SpscFifo;
+
+/** \brief Initialize the SPSC FIFO object
+ *
+ * \param buffer Specifies the FIFO object address.
+ * \param size Specifies the FIFO buffer size in bytes
+ * \param elementSize Specifies data element size in bytes. size must be bigger or equal to elementSize.
+ *
+ * \return Returns a pointer on the FIFO object
+ *
+ * \note: The buffer parameter must point on a free memory location where the
+ * buffer object will be initialised. The size of this area must be at least
+ * equals to "size + sizeof(Ifx_SpscFifo) + IFX_SPSCFIFO_LINE_SIZE".
+ *
+ * \note: The TC3xx data caches are not coherent between the CPUs. The memory
+ * must be accessed uncached by both CPUs: a DSPR, or the LMU through the
+ * non cached segment (0xB...). Use the global address of the memory on both sides.
+ */
+IFX_EXTERN Ifx_SpscFifo *Ifx_SpscFifo_init(void *buffer, Ifx_SizeT size, Ifx_SizeT elementSize);
+
+/** \brief Read data from the fifo and remove them from the buffer.
+ *
+ * Only complete elements are returned, if count is not a multiple of
+ * elementSize then the incomplete element is not read/removed from the buffer.
+ * Must only be called by the reader CPU.
+ *
+ * \param fifo Pointer on the SPSC Fifo object
+ * \param data Pointer to the data buffer for storing values
+ * \param count in bytes
+ * \param timeout in system timer ticks, TIME_NULL returns with the data available
+ *
+ * \return return the number of byte that could not be read
+ */
+IFX_EXTERN Ifx_SizeT Ifx_SpscFifo_read(Ifx_SpscFifo *fifo, void *data, Ifx_SizeT count, Ifx_TickTime timeout);
+
+/** \brief Write data into the fifo.
+ *
+ * Only complete elements are written to the buffer, if count is not a multiple of
+ * elementSize then the incomplete element are not written to the buffer.
+ * Must only be called by the writer CPU.
+ *
+ * \param fifo Pointer on the SPSC Fifo object
+ * \param data Pointer to the data buffer to write into the Fifo
+ * \param count in bytes
+ * \param timeout in system timer ticks, TIME_NULL returns with the space available
+ *
+ * \return return the number of byte that could not be written
+ */
+IFX_EXTERN Ifx_SizeT Ifx_SpscFifo_write(Ifx_SpscFifo *fifo, const void *data, Ifx_SizeT count, Ifx_TickTime timeout);
+
+/**
+ * \brief Returns the size of the data in the buffer in bytes
+ *
+ * The value is exact for the reader, for the writer it may be lower than the
+ * actual count as the reader may remove data at any time.
+ *
+ * \param fifo Pointer on the SPSC Fifo object
+ *
+ * \return Returns the size of the data in the buffer in bytes
+ */
+IFX_INLINE Ifx_SizeT Ifx_SpscFifo_readCount(Ifx_SpscFifo *fifo)
+{
+    return (Ifx_SizeT)(fifo->writer.B.total - fifo->reader.B.total);
+}
+
+
+/** \brief Returns the free size in bytes
+ *
+ * The value is exact for the writer, for the reader it may be lower than the
+ * actual free size as the writer may add data at any time.
+ *
+ * \param fifo Pointer on the SPSC Fifo object
+ *
+ * \return Returns the free size in bytes
+ */
+IFX_INLINE Ifx_SizeT Ifx_SpscFifo_writeCount(Ifx_SpscFifo *fifo)
+{
+    return (Ifx_SizeT)(fifo->size - Ifx_SpscFifo_readCount(fifo));
+}
+
+
+/** \brief Indicates if the fifo is empty
+ *
+ * \param fifo Pointer on the SPSC Fifo object
+ *
+ * \retval TRUE is the buffer is empty
+ * \retval FALSE is the buffer is not empty
+ */
+IFX_INLINE boolean Ifx_SpscFifo_isEmpty(Ifx_SpscFifo *fifo)
+{
+    return (Ifx_SpscFifo_readCount(fifo) != 0) ? FALSE : TRUE;
+}
+
+
+/**\}*/
+//------------------------------------------------------------------------------
+#endif
@@ -0,0 +1,91 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdio.h>
+#include <setjmp.h>
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxStm.h"
+
+/**
+ * @brief Host build of the ASW / DataHandling sources (Test/Makefile)
+ * The SFRs from 0xF0000000 are plain memory mapped at their TriCore addresses (Host_Cpu.c), the inline
+ * register accesses of the iLLD headers work on it. Nothing reacts to a register write by itself:
+ * Host_I2cModel.c plays the I2C0 module, the tests move STM0 with Host_advance.
+ * The program is linked without PIE, so global data can be cast to uint32 as on the TriCore.
+ */
+
+#define HOST_SFR_BASE                   0xF0000000u
+#define HOST_SFR_SIZE                   0x00100000u
+#define HOST_SOURCE_FREQUENCY           300000000.0f                                    /* fSOURCE0 / 1 / 2 */
+#define HOST_STM_DIV                    3                                               /* fSTM = 100 MHz */
+#define HOST_STM_TICKS_PER_US           100
+
+/* Test result, checked by TEST_CHECK */
+typedef struct _Host_Result {
+    uint32 checks;
+    uint32 failures;
+} Host_Result;
+
+extern Host_Result host_result;
+
+#define TEST_CHECK(expr)                                                                                \
+    do {                                                                                                \
+        host_result.checks++;                                                                           \
+        if (!(expr)) {                                                                                  \
+            host_result.failures++;                                                                     \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr);                             \
+        }                                                                                               \
+    } while (0)
+
+/**
+ * @brief IFX_ASSERT of the sources (Ifx_Cfg.h): Fails the test, or returns to Host_expectAssert
+ * Used as: if (Host_expectAssert() == 0) { call that has to assert; } TEST_CHECK(host_assertCount == 1)
+ */
+#define Host_expectAssert()             (host_assertArmed = TRUE, setjmp(host_assertJump))
+
+extern jmp_buf host_assertJump;
+extern volatile boolean host_assertArmed;
+extern volatile uint32 host_assertCount;
+
+/**
+ * @brief Summary line and exit code of a test program
+ */
+extern int Host_report(const char *name);
+
+/**
+ * @brief Core of the calling thread: IfxCpu_getCoreIndex / IfxCpu_getCoreId
+ */
+extern void Host_setCore(IfxCpu_ResourceCpu cpu);
+extern boolean Host_interruptsEnabled(void);
+/**
+ * @brief Called by a thread that turns its interrupts off (TRUE) and on again (FALSE), NULL_PTR: Nothing is called
+ * Host_I2cPoll uses it to follow the interrupts-off sections of the polling writes.
+ */
+extern void (*volatile host_lockHook)(boolean bLocked);
+/**
+ * @brief ICR.CCPN of the calling thread, as the interrupt entry sets it (0: Not in an ISR)
+ * @return uint32 CCPN before
+ */
+extern uint32 Host_setPriority(uint32 ccpn);
+
+/**
+ * @brief STM0 time
+ */
+extern void Host_advance(uint32 ticks);
+extern uint32 Host_now(void);
+/**
+ * @brief TRUE if the interrupt of comparator is enabled and its compare value is reached
+ */
+extern boolean Host_stmDue(IfxStm_Comparator comparator);
+/**
+ * @brief Ticks until the compare of comparator, 0 if it is due
+ */
+extern uint32 Host_stmRemain(IfxStm_Comparator comparator);
+
+/**
+ * @brief Yield the host CPU in the spin loops of the thread tests (the host may have a single core)
+ */
+extern void Host_yield(void);
+
+#endif
@@ -0,0 +1,149 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include "Host.h"
+#include "IfxScuCcu.h"
+
+Host_Result host_result;
+jmp_buf host_assertJump;
+volatile boolean host_assertArmed = FALSE;
+volatile uint32 host_assertCount = 0;
+void (*volatile host_lockHook)(boolean bLocked) = NULL_PTR;
+
+static __thread uint32 host_coreId = 0;
+static __thread uint32 host_icr = (1u << 15);                   /* ICR.IE */
+
+/* SFR window at its TriCore address, before main so that initialized globals pointing into it work */
+__attribute__((constructor)) static void Host_mapSfr(void)
+{
+    void *sfr = mmap((void *)(uintptr_t)HOST_SFR_BASE, HOST_SFR_SIZE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (sfr != (void *)(uintptr_t)HOST_SFR_BASE) {
+        fprintf(stderr, "Host: SFR window at 0x%08X not available\n", HOST_SFR_BASE);
+        exit(2);
+    }
+
+    /* Clock dividers read by the frequency getters of IfxScuCcu.h */
+    MODULE_SCU.CCUCON0.B.STMDIV = HOST_STM_DIV;
+    MODULE_SCU.CCUCON1.B.I2CDIV = 2;
+}
+
+unsigned int Host_mfcr(unsigned int reg)
+{
+    switch (reg) {
+    case CPU_CORE_ID:
+        return host_coreId;
+    case CPU_ICR:
+        return host_icr;
+    default:
+        return 0;
+    }
+}
+
+void Host_mtcr(unsigned int reg, unsigned int value)
+{
+    if (reg == CPU_ICR) {
+        host_icr = value;
+    }
+}
+
+void Host_disable(void)
+{
+    const boolean bWasEnabled = (host_icr & (1u << 15)) ? TRUE : FALSE;
+
+    host_icr &= ~(1u << 15);
+    if (bWasEnabled && host_lockHook != NULL_PTR) {
+        host_lockHook(TRUE);
+    }
+}
+
+void Host_enable(void)
+{
+    const boolean bWasEnabled = (host_icr & (1u << 15)) ? TRUE : FALSE;
+
+    host_icr |= (1u << 15);
+    if (bWasEnabled == FALSE && host_lockHook != NULL_PTR) {
+        host_lockHook(FALSE);
+    }
+}
+
+void Host_debug(void)
+{
+    fprintf(stderr, "Host: debug instruction\n");
+    abort();
+}
+
+/* cmpswap.w: Returns the old value, stores value if it was condition */
+unsigned int Host_cmpAndSwap(unsigned int volatile *address, unsigned int value, unsigned int condition)
+{
+    unsigned int old = condition;
+
+    __atomic_compare_exchange_n(address, &old, value, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return old;
+}
+
+void Host_assert(const char *expr, const char *file, int line)
+{
+    host_assertCount++;
+    if (host_assertArmed) {
+        host_assertArmed = FALSE;
+        longjmp(host_assertJump, 1);
+    }
+    host_result.failures++;
+    printf("%s:%d: IFX_ASSERT failed: %s\n", file, line, expr);
+}
+
+int Host_report(const char *name)
+{
+    printf("%s: %u checks, %u failed\n", name, host_result.checks, host_result.failures);
+    return (host_result.failures == 0) ? 0 : 1;
+}
+
+void Host_setCore(IfxCpu_ResourceCpu cpu)
+{
+    host_coreId = (uint32)cpu;
+}
+
+boolean Host_interruptsEnabled(void)
+{
+    return (host_icr & (1u << 15)) ? TRUE : FALSE;
+}
+
+uint32 Host_setPriority(uint32 ccpn)
+{
+    const uint32 old = host_icr & 0xFFu;
+
+    host_icr = (host_icr & ~0xFFu) | (ccpn & 0xFFu);
+    return old;
+}
+
+void Host_advance(uint32 ticks)
+{
+    MODULE_STM0.TIM0.U += ticks;
+}
+
+uint32 Host_now(void)
+{
+    return MODULE_STM0.TIM0.U;
+}
+
+boolean Host_stmDue(IfxStm_Comparator comparator)
+{
+    const uint32 enabled = (comparator == IfxStm_Comparator_0) ? MODULE_STM0.ICR.B.CMP0EN : MODULE_STM0.ICR.B.CMP1EN;
+
+    return (enabled && Host_stmRemain(comparator) == 0) ? TRUE : FALSE;
+}
+
+uint32 Host_stmRemain(IfxStm_Comparator comparator)
+{
+    const sint32 remain = (sint32)(MODULE_STM0.CMP[comparator].U - MODULE_STM0.TIM0.U);
+
+    return (remain > 0) ? (uint32)remain : 0;
+}
+
+void Host_yield(void)
+{
+    sched_yield();
+}
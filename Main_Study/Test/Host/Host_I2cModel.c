@@ -0,0 +1,307 @@
+#include <stdint.h>
+#include <string.h>
+#include "Host_I2cModel.h"
+#include "ASW/ASW_CONFIG.h"
+
+Host_I2cModel host_i2cModel;
+
+extern void I2c0_DtrIsr(void);
+extern void I2c0_ProtocolIsr(void);
+extern void I2c0_RetryIsr(void);
+
+static Host_I2cSlave *_FindSlave(uint8 addr);
+static uint32 _Request(void);
+static void _DmaMove(uint32 channelId);
+static void _DmaReset(void);
+static void _RxWord(uint32 word);
+static void _Packet(void);
+static void _Stop(void);
+static void _Compare(void);
+static void _DecodePins(void);
+static void _Protocol(uint32 pirqss);
+static void _Isr(void (*isr)(void), uint32 priority);
+
+void Host_I2cModel_init(float32 baudrate)
+{
+    memset(&host_i2cModel, 0, sizeof(host_i2cModel));
+    host_i2cModel.byteTicks = (uint32)((9.0f * HOST_STM_TICKS_PER_US * 1000000.0f) / baudrate);
+    host_i2cModel.bScl = TRUE;
+    host_i2cModel.bSda = TRUE;
+
+    MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_idle;
+    MODULE_I2C0.TPSCTRL.U = 0;
+    MODULE_I2C0.ENDDCTRL.U = 0;
+    MODULE_I2C0.PIRQSS.U = 0;
+    MODULE_I2C0.RIS.U = 0;
+    MODULE_STM0.ICR.B.CMP1EN = 0;
+    MODULE_P13.IN.U = (1u << HOST_I2CMODEL_SCL_PIN) | (1u << HOST_I2CMODEL_SDA_PIN);
+}
+
+Host_I2cSlave *Host_I2cModel_addSlave(uint8 addr)
+{
+    for (int i = 0; i < HOST_I2CMODEL_SLAVES; i++) {
+        if (host_i2cModel.slave[i].addr == 0) {
+            host_i2cModel.slave[i].addr = addr;
+            return &host_i2cModel.slave[i];
+        }
+    }
+
+    return NULL_PTR;
+}
+
+void Host_I2cModel_holdSda(uint8 clocks)
+{
+    host_i2cModel.bSdaHeld = TRUE;
+    host_i2cModel.sdaHoldClocks = clocks;
+    host_i2cModel.sclPulses = 0;
+    MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_remoteSlave;
+    MODULE_P13.IN.U &= ~(1u << HOST_I2CMODEL_SDA_PIN);
+}
+
+boolean Host_I2cModel_step(void)
+{
+    if (MODULE_I2C0.ENDDCTRL.B.SETEND) {
+        _Stop();
+    } else if (MODULE_I2C0.TPSCTRL.B.TPS != 0) {
+        _Packet();
+    } else if (MODULE_STM0.ICR.B.CMP1EN) {
+        _Compare();
+    } else {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+uint32 Host_I2cModel_run(void)
+{
+    uint32 steps = 0;
+
+    while (Host_I2cModel_step()) {
+        steps++;
+    }
+
+    return steps;
+}
+
+static Host_I2cSlave *_FindSlave(uint8 addr)
+{
+    for (int i = 0; i < HOST_I2CMODEL_SLAVES; i++) {
+        if (host_i2cModel.slave[i].addr == addr) {
+            return &host_i2cModel.slave[i];
+        }
+    }
+
+    return NULL_PTR;
+}
+
+/* FIFO single request: The DTR interrupt or the DMA channel writes the next word to TXD */
+static uint32 _Request(void)
+{
+    volatile Ifx_SRC_SRCR *src = IfxI2c_getDtrSrcPointer(&MODULE_I2C0);
+
+    MODULE_I2C0.TXD.U = 0;
+    MODULE_I2C0.RIS.U = (1u << IFX_I2C_RIS_SREQ_INT_OFF);
+    if (src->B.TOS == IfxSrc_Tos_dma) {
+        _DmaMove(src->B.SRPN);
+    } else {
+        host_i2cModel.dtrIsrs++;
+        _Isr(I2c0_DtrIsr, ISR_PRIORITY_I2C0_DTR);
+    }
+    MODULE_I2C0.RIS.U = 0;
+
+    return MODULE_I2C0.TXD.U;
+}
+
+/* 32 bit move, destination fixed (Module_I2C: DCBE, no circular range). TCOUNT 0: The request starts a transaction */
+static void _DmaMove(uint32 channelId)
+{
+    Host_I2cModel *model = &host_i2cModel;
+    Ifx_DMA_CH *ch = &MODULE_DMA.CH[channelId];
+
+    model->dmaChannel = channelId;
+    if (ch->CHCSR.B.TCOUNT == 0) {
+        ch->CHCSR.B.TCOUNT = ch->CHCFGR.B.TREL;
+    }
+    if (ch->CHCSR.B.TCOUNT == 0) {
+        return;
+    }
+
+    *(volatile uint32 *)(uintptr_t)ch->DADR.U = *(volatile uint32 *)(uintptr_t)ch->SADR.U;
+    ch->SADR.U += 4;
+    ch->CHCSR.B.TCOUNT--;
+    model->dmaMoves++;
+
+    /* Transaction done: The entry overwrites the 8 words of the channel */
+    if (ch->CHCSR.B.TCOUNT == 0 && ch->ADICR.B.SHCT == IfxDma_ChannelShadow_linkedList) {
+        const volatile uint32 *entry = (const volatile uint32 *)(uintptr_t)ch->SHADR.U;
+        volatile uint32 *regs = (volatile uint32 *)ch;
+
+        for (uint32 i = 0; i < sizeof(Ifx_DMA_CH) / 4; i++) {
+            regs[i] = entry[i];
+        }
+        model->dmaLoads++;
+    }
+}
+
+/* FIFO single request with a received word in RXD */
+static void _RxWord(uint32 word)
+{
+    MODULE_I2C0.RXD.U = word;
+    MODULE_I2C0.RIS.U = (1u << IFX_I2C_RIS_SREQ_INT_OFF);
+    host_i2cModel.dtrIsrs++;
+    _Isr(I2c0_DtrIsr, ISR_PRIORITY_I2C0_DTR);
+    MODULE_I2C0.RIS.U = 0;
+}
+
+static void _Packet(void)
+{
+    Host_I2cModel *model = &host_i2cModel;
+    const uint32 tps = MODULE_I2C0.TPSCTRL.B.TPS;
+    Host_I2cPacket *packet = &model->packet[model->packetLen % HOST_I2CMODEL_PACKETS];
+    uint32 word = _Request();
+    uint32 pirqss = (1u << IFX_I2C_PIRQSS_TX_END_OFF);
+    Host_I2cSlave *slave;
+
+    /* Taken: The next packet needs a new TPS */
+    MODULE_I2C0.TPSCTRL.B.TPS = 0;
+    MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_busyMaster;
+
+    model->packetLen++;
+    packet->addr = (uint8)((word & 0xFF) >> 1);
+    packet->bRead = (word & 0x01) ? TRUE : FALSE;
+    packet->bNak = FALSE;
+    packet->offset = model->bytesLen;
+    packet->len = 0;
+    packet->startTick = Host_now();
+
+    slave = _FindSlave(packet->addr);
+    if (slave == NULL_PTR || slave->bAbsent || slave->nakCount > 0) {
+        if (slave != NULL_PTR && slave->nakCount > 0) {
+            slave->nakCount--;
+        }
+        packet->bNak = TRUE;
+        Host_advance(model->byteTicks);
+        _Protocol(pirqss | (1u << IFX_I2C_PIRQSS_NACK_OFF));
+        return;
+    }
+
+    if (packet->bRead) {
+        const uint32 mrps = MODULE_I2C0.MRPSCTRL.B.MRPS;
+
+        for (uint32 i = 0; i < mrps; i += 4) {
+            uint32 rx = 0;
+
+            for (uint32 j = 0; j < 4 && (i + j) < mrps; j++) {
+                const uint8 value = slave->regs[slave->reg++];
+
+                rx |= (uint32)value << (j * 8);
+                if (model->bytesLen < HOST_I2CMODEL_BYTES) model->bytes[model->bytesLen++] = value;
+            }
+            _RxWord(rx);
+        }
+        packet->len = mrps;
+    } else {
+        /* Address byte is byte 0 of the first word */
+        for (uint32 i = 1; i < tps; i++) {
+            uint8 value;
+
+            if ((i & 3) == 0) {
+                word = _Request();
+            }
+            value = (uint8)(word >> ((i & 3) * 8));
+            if (i == 1) {
+                slave->reg = value;
+            } else {
+                slave->regs[slave->reg++] = value;
+            }
+            if (model->bytesLen < HOST_I2CMODEL_BYTES) model->bytes[model->bytesLen++] = value;
+        }
+        packet->len = tps - 1;
+    }
+
+    Host_advance(model->byteTicks * (1 + packet->len));
+    _Protocol(pirqss);
+}
+
+static void _Stop(void)
+{
+    MODULE_I2C0.ENDDCTRL.B.SETEND = 0;
+    MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_idle;
+    Host_advance(host_i2cModel.byteTicks / 9);
+    _Protocol(1u << IFX_I2C_PIRQSS_TX_END_OFF);
+}
+
+static void _Compare(void)
+{
+    Host_I2cModel *model = &host_i2cModel;
+    const uint32 ticks = Host_stmRemain(IfxStm_Comparator_1);
+
+    if (model->backoffLen < HOST_I2CMODEL_BACKOFFS) {
+        model->backoffTicks[model->backoffLen++] = ticks;
+    }
+    Host_advance(ticks);
+
+    MODULE_P13.OMR.U = 0;
+    _Isr(I2c0_RetryIsr, ISR_PRIORITY_I2C0_RETRY);
+    _DecodePins();
+}
+
+/* Last OMR write of the retry interrupt: SCL rising edges and STOP (SDA rising while SCL is high) */
+static void _DecodePins(void)
+{
+    Host_I2cModel *model = &host_i2cModel;
+    const uint32 omr = MODULE_P13.OMR.U;
+    boolean bScl = model->bScl;
+    boolean bSda = model->bSda;
+
+    if (omr & (1u << HOST_I2CMODEL_SCL_PIN)) bScl = TRUE;
+    if (omr & (1u << (16 + HOST_I2CMODEL_SCL_PIN))) bScl = FALSE;
+    if (omr & (1u << HOST_I2CMODEL_SDA_PIN)) bSda = TRUE;
+    if (omr & (1u << (16 + HOST_I2CMODEL_SDA_PIN))) bSda = FALSE;
+
+    if (bScl && !model->bScl) {
+        model->sclPulses++;
+        if (model->bSdaHeld && model->sclPulses >= model->sdaHoldClocks) {
+            model->bSdaHeld = FALSE;
+            MODULE_P13.IN.U |= (1u << HOST_I2CMODEL_SDA_PIN);
+        }
+    }
+    if (bSda && !model->bSda && bScl && !model->bSdaHeld) {
+        model->stops++;
+        MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_idle;
+    }
+
+    model->bScl = bScl;
+    model->bSda = bSda;
+}
+
+static void _Protocol(uint32 pirqss)
+{
+    MODULE_I2C0.PIRQSS.U = pirqss;
+    host_i2cModel.protocolIsrs++;
+    _Isr(I2c0_ProtocolIsr, ISR_PRIORITY_I2C0_P);
+    MODULE_I2C0.PIRQSS.U = 0;
+}
+
+/* Interrupt entry: The ISR and the callbacks it calls run at its priority */
+static void _Isr(void (*isr)(void), uint32 priority)
+{
+    const uint32 ccpn = Host_setPriority(priority);
+
+    isr();
+    Host_setPriority(ccpn);
+    _DmaReset();
+}
+
+/* TSR.RST of the channel: Done when the interrupt that requested it returns, the channel starts over */
+static void _DmaReset(void)
+{
+    const uint32 channelId = host_i2cModel.dmaChannel;
+
+    if (MODULE_DMA.TSR[channelId].B.RST) {
+        MODULE_DMA.CH[channelId].CHCSR.B.TCOUNT = 0;
+        MODULE_DMA.TSR[channelId].B.RST = 0;
+        host_i2cModel.dmaResets++;
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef HOST_I2CMODEL_H
+#define HOST_I2CMODEL_H
+
+#include "Host.h"
+#include "Module_I2C.h"
+
+/**
+ * @brief I2C0 as seen through its registers, under the real Module_I2C.c
+ * Host_I2cModel_step plays the next bus event and calls the ISR Module_I2C_Async routed to it:
+ * - TPSCTRL.TPS set: One packet (START or repeated START to TX_END), TXD is fed by single requests on I2c0_DtrIsr.
+ *   With the DTR service request routed to the DMA (SRC TOS), each request is one 32 bit move of the channel
+ *   SRPN from SADR to DADR: A transaction takes CHCFGR.TREL moves, its end loads the linked list entry at SHADR.
+ *   TSR.RST of that channel clears TCOUNT when the ISR that wrote it returns
+ * - ENDDCTRL.SETEND set: STOP, bus idle, TX_END on I2c0_ProtocolIsr
+ * - STM0 comparator 1 armed: STM0 is moved to the compare, I2c0_RetryIsr. The P13 OMR writes of the bus
+ *   recovery are decoded into SCL / SDA levels
+ * The ISRs run with ICR.CCPN at their ISR_PRIORITY_I2C0_*, as after the interrupt entry.
+ * Bytes on the bus take byteTicks of STM0 each (9 clocks at the baudrate).
+ */
+
+#define HOST_I2CMODEL_SLAVES            4
+#define HOST_I2CMODEL_PACKETS           512
+#define HOST_I2CMODEL_BYTES             16384
+#define HOST_I2CMODEL_BACKOFFS          32
+#define HOST_I2CMODEL_SCL_PIN           1                                               /* IfxI2c0_SCL_P13_1_INOUT */
+#define HOST_I2CMODEL_SDA_PIN           2                                               /* IfxI2c0_SDA_P13_2_INOUT */
+
+typedef struct _Host_I2cSlave {
+    uint8 addr;                                          /* 7 bit, 0 = free slot */
+    uint8 nakCount;                                      /* Next address bytes answered with NAK */
+    boolean bAbsent;                                     /* Every address byte is answered with NAK */
+    uint8 reg;                                           /* Register pointer: First byte of a write, incremented per read byte */
+    uint8 regs[256];
+} Host_I2cSlave;
+
+/* START (or repeated START) to TX_END */
+typedef struct _Host_I2cPacket {
+    uint8 addr;
+    boolean bRead;
+    boolean bNak;
+    uint32 offset;                                       /* Data bytes in host_i2cModel.bytes, address byte excluded */
+    uint32 len;
+    uint32 startTick;
+} Host_I2cPacket;
+
+typedef struct _Host_I2cModel {
+    Host_I2cSlave slave[HOST_I2CMODEL_SLAVES];
+    uint32 byteTicks;
+    uint8 sdaHoldClocks;                                 /* SCL pulses until the slave holding SDA lets go */
+    boolean bSdaHeld;
+    boolean bScl;                                        /* Levels driven by the bus recovery */
+    boolean bSda;
+    uint32 sclPulses;
+    uint32 stops;                                        /* STOP conditions driven by the bus recovery */
+    uint32 backoffTicks[HOST_I2CMODEL_BACKOFFS];         /* Every STM compare armed by Module_I2C, in ticks */
+    uint32 backoffLen;
+    uint32 dtrIsrs;                                      /* FIFO requests served by the CPU */
+    uint32 protocolIsrs;
+    uint32 dmaMoves;                                     /* FIFO requests served by the DMA channel */
+    uint32 dmaLoads;                                     /* Linked list entries loaded into the channel */
+    uint32 dmaResets;
+    uint32 dmaChannel;                                   /* Channel of the last move */
+    Host_I2cPacket packet[HOST_I2CMODEL_PACKETS];
+    uint32 packetLen;
+    uint8 bytes[HOST_I2CMODEL_BYTES];
+    uint32 bytesLen;
+} Host_I2cModel;
+
+extern Host_I2cModel host_i2cModel;
+
+/**
+ * @brief Idle bus, no slave, STM0 comparator 1 off
+ * @param baudrate SCL of the bus (byteTicks)
+ */
+extern void Host_I2cModel_init(float32 baudrate);
+extern Host_I2cSlave *Host_I2cModel_addSlave(uint8 addr);
+/**
+ * @brief A slave holds SDA low (bus busy with another master) until clocks SCL pulses of the recovery
+ */
+extern void Host_I2cModel_holdSda(uint8 clocks);
+/**
+ * @brief Play the next bus event
+ * @return boolean FALSE if nothing is pending on the bus
+ */
+extern boolean Host_I2cModel_step(void);
+/**
+ * @brief Step until nothing is pending
+ * @return uint32 Steps played
+ */
+extern uint32 Host_I2cModel_run(void);
+
+#endif
@@ -0,0 +1,294 @@
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include "Host_I2cPoll.h"
+
+#define SREQ                            (1u << IFX_I2C_RIS_SREQ_INT_OFF)
+
+Host_I2cPoll host_i2cPoll;
+
+/* Bus thread state, the caller only touches it after the join */
+static struct {
+    uint32 word[HOST_I2CPOLL_FIFO_WORDS];                /* TX words, RX words once the address byte is out */
+    uint8 len[HOST_I2CPOLL_FIFO_WORDS];                  /* Bytes of the word in the packet */
+    uint32 head;
+    uint32 count;
+    uint8 shift;                                         /* Bytes of the head word already on the bus */
+    boolean bActive;
+    boolean bRead;
+    uint32 tps;
+    uint32 taken;                                        /* Bytes of the packet taken from TXD */
+    uint32 sent;                                         /* Bytes of the packet on the bus */
+    uint32 mrps;
+    uint32 received;
+    uint32 rxBytes;                                      /* Bytes received into the next RX word */
+    boolean bRxRequest;                                  /* SREQ raised for RXD, the next ICR takes the word */
+} fifo;
+
+static pthread_t busThread;
+static volatile boolean bRun;
+
+static void _LockHook(boolean bLocked);
+static void *_BusThread(void *arg);
+static boolean _Step(void);
+static uint32 _Take(volatile unsigned int *reg, uint32 empty);
+static void _TxWord(uint32 word);
+static void _Shift(void);
+static void _Receive(void);
+static void _PopRx(void);
+static boolean _Request(boolean bRx);
+
+void Host_I2cPoll_start(float32 baudrate)
+{
+    memset(&host_i2cPoll, 0, sizeof(host_i2cPoll));
+    memset(&fifo, 0, sizeof(fifo));
+    host_i2cPoll.byteTicks = (uint32)((9.0f * HOST_STM_TICKS_PER_US * 1000000.0f) / baudrate);
+
+    MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_idle;
+    MODULE_I2C0.TXD.U = HOST_I2CPOLL_TXD_EMPTY;
+    MODULE_I2C0.RXD.U = 0;
+    MODULE_I2C0.TPSCTRL.U = 0;
+    MODULE_I2C0.MRPSCTRL.U = 0;
+    MODULE_I2C0.ENDDCTRL.U = 0;
+    MODULE_I2C0.FFSSTAT.U = 0;
+    MODULE_I2C0.PIRQSS.U = 0;
+    MODULE_I2C0.PIRQSC.U = 0;
+    MODULE_I2C0.ERRIRQSS.U = 0;
+    MODULE_I2C0.ERRIRQSC.U = 0;
+    MODULE_I2C0.RIS.U = 0;
+    MODULE_I2C0.ICR.U = 0;
+
+    bRun = TRUE;
+    host_lockHook = _LockHook;
+    pthread_create(&busThread, NULL, _BusThread, NULL);
+}
+
+void Host_I2cPoll_stop(void)
+{
+    bRun = FALSE;
+    pthread_join(busThread, NULL);
+    host_lockHook = NULL_PTR;
+
+    /* Register writes the bus thread has not seen yet, e.g. the STOP of the last call */
+    while (_Step());
+}
+
+/* Calling thread: Interrupts off and on again */
+static void _LockHook(boolean bLocked)
+{
+    Host_I2cPoll *poll = &host_i2cPoll;
+
+    if (bLocked) {
+        poll->lockStartWords = poll->words;
+        poll->bLocked = TRUE;
+        return;
+    }
+
+    /* Every register write up to here is taken before a new request can come */
+    while (MODULE_I2C0.TXD.U != HOST_I2CPOLL_TXD_EMPTY || MODULE_I2C0.ICR.U != 0 || MODULE_I2C0.PIRQSC.U != 0 ||
+           MODULE_I2C0.ERRIRQSC.U != 0 || MODULE_I2C0.ENDDCTRL.U != 0) {
+        sched_yield();
+    }
+    if (poll->words != poll->lockStartWords) {
+        const uint32 words = poll->words - poll->lockStartWords;
+
+        poll->lockSections++;
+        if (words > poll->maxLockWords) {
+            poll->maxLockWords = words;
+        }
+    }
+    poll->bLocked = FALSE;
+}
+
+/* Runs while there is work, the calling thread gets the CPU when a request is raised or nothing is left */
+static void *_BusThread(void *arg)
+{
+    (void)arg;
+    while (bRun) {
+        if (_Step() == FALSE) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* One register pass and one byte on the bus, FALSE if the calling thread has to go on */
+static boolean _Step(void)
+{
+    /* TXD before the clears: A clear written ahead of the word is taken with it */
+    const uint32 txd = _Take(&MODULE_I2C0.TXD.U, HOST_I2CPOLL_TXD_EMPTY);
+    const uint32 icr = _Take(&MODULE_I2C0.ICR.U, 0);
+    const uint32 pirqsc = _Take(&MODULE_I2C0.PIRQSC.U, 0);
+    const uint32 errirqsc = _Take(&MODULE_I2C0.ERRIRQSC.U, 0);
+    const uint32 enddctrl = _Take(&MODULE_I2C0.ENDDCTRL.U, 0);
+    boolean bRx;
+
+    if (icr != 0) {
+        if ((icr & SREQ) && fifo.bRxRequest) {
+            _PopRx();
+        }
+        MODULE_I2C0.RIS.U &= ~icr;
+    }
+    MODULE_I2C0.PIRQSS.U &= ~pirqsc;
+    MODULE_I2C0.ERRIRQSS.U &= ~errirqsc;
+    if (enddctrl & (IFX_I2C_ENDDCTRL_SETEND_MSK << IFX_I2C_ENDDCTRL_SETEND_OFF)) {
+        host_i2cPoll.stops++;
+        MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_idle;
+        MODULE_I2C0.PIRQSS.U |= (1u << IFX_I2C_PIRQSS_TX_END_OFF);
+    }
+    if (txd != HOST_I2CPOLL_TXD_EMPTY) {
+        _TxWord(txd);
+    }
+
+    /* Read packet after its address byte: The FIFO holds RX words until they are read */
+    bRx = (fifo.bRead && fifo.tps > 0 && fifo.sent == fifo.tps) ? TRUE : FALSE;
+    if (bRx) {
+        _Receive();
+    } else if (fifo.count > 0) {
+        _Shift();
+    }
+    MODULE_I2C0.FFSSTAT.B.FFS = fifo.count;
+
+    if (_Request(bRx)) {
+        return FALSE;
+    }
+    if (bRx) {
+        return (fifo.received < fifo.mrps && fifo.count < HOST_I2CPOLL_FIFO_WORDS) ? TRUE : FALSE;
+    }
+
+    return (fifo.count > 0) ? TRUE : FALSE;
+}
+
+/* Register written by the calling thread: Read and reset in one go, a write in between is not lost */
+static uint32 _Take(volatile unsigned int *reg, uint32 empty)
+{
+    return __atomic_exchange_n(reg, empty, __ATOMIC_SEQ_CST);
+}
+
+static void _TxWord(uint32 word)
+{
+    Host_I2cPoll *poll = &host_i2cPoll;
+    const uint32 tail = (fifo.head + fifo.count) % HOST_I2CPOLL_FIFO_WORDS;
+
+    /* The first word of a packet is the one with the address byte */
+    if (fifo.bActive == FALSE) {
+        fifo.bActive = TRUE;
+        fifo.bRead = (word & 0x01) ? TRUE : FALSE;
+        fifo.tps = MODULE_I2C0.TPSCTRL.B.TPS;
+        fifo.taken = 0;
+        fifo.sent = 0;
+        fifo.mrps = MODULE_I2C0.MRPSCTRL.B.MRPS;
+        fifo.received = 0;
+        fifo.rxBytes = 0;
+        poll->packets++;
+        if (MODULE_I2C0.ADDRCFG.B.MCE) {
+            poll->hsPackets++;
+        }
+        MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_busyMaster;
+    }
+    poll->words++;
+
+    /* A word beyond TPS or into a full FIFO is lost, the bytes on the bus show it */
+    if (fifo.count == HOST_I2CPOLL_FIFO_WORDS || fifo.taken >= fifo.tps) {
+        return;
+    }
+    fifo.word[tail] = word;
+    fifo.len[tail] = (uint8)(((fifo.tps - fifo.taken) < 4) ? (fifo.tps - fifo.taken) : 4);
+    fifo.taken += fifo.len[tail];
+    fifo.count++;
+}
+
+static void _Shift(void)
+{
+    Host_I2cPoll *poll = &host_i2cPoll;
+    const uint8 value = (uint8)(fifo.word[fifo.head] >> (fifo.shift * 8));
+    const boolean bMasterCode = (fifo.sent == 0 && (value & 0xF8) == 0x08) ? TRUE : FALSE;
+
+    Host_advance(poll->byteTicks);
+    if (poll->bytesLen < HOST_I2CPOLL_BYTES) {
+        poll->bytes[poll->bytesLen++] = value;
+    }
+    fifo.sent++;
+
+    if (++fifo.shift == fifo.len[fifo.head]) {
+        fifo.shift = 0;
+        fifo.head = (fifo.head + 1) % HOST_I2CPOLL_FIFO_WORDS;
+        fifo.count--;
+    }
+    if (bMasterCode) {
+        poll->masterCodes++;
+        fifo.bActive = FALSE;
+        MODULE_I2C0.PIRQSS.U |= (1u << IFX_I2C_PIRQSS_NACK_OFF) | (1u << IFX_I2C_PIRQSS_TX_END_OFF);
+    } else if (fifo.sent == fifo.tps && (fifo.bRead == FALSE || fifo.mrps == 0)) {
+        fifo.bActive = FALSE;
+        MODULE_I2C0.PIRQSS.U |= (1u << IFX_I2C_PIRQSS_TX_END_OFF);
+    }
+}
+
+/* One byte from the slave, the bus waits (SCL low) while the RX FIFO is full */
+static void _Receive(void)
+{
+    Host_I2cPoll *poll = &host_i2cPoll;
+    const uint32 tail = (fifo.head + fifo.count) % HOST_I2CPOLL_FIFO_WORDS;
+    uint8 value;
+
+    if (fifo.received >= fifo.mrps || fifo.count == HOST_I2CPOLL_FIFO_WORDS) {
+        return;
+    }
+    value = poll->readData[poll->readPos++ % sizeof(poll->readData)];
+    Host_advance(poll->byteTicks);
+    if (poll->bytesLen < HOST_I2CPOLL_BYTES) {
+        poll->bytes[poll->bytesLen++] = value;
+    }
+
+    if (fifo.rxBytes == 0) {
+        fifo.word[tail] = 0;
+    }
+    fifo.word[tail] |= (uint32)value << (fifo.rxBytes * 8);
+    fifo.received++;
+    if (++fifo.rxBytes == 4 || fifo.received == fifo.mrps) {
+        fifo.len[tail] = (uint8)fifo.rxBytes;
+        fifo.rxBytes = 0;
+        if (fifo.count++ == 0) {
+            MODULE_I2C0.RXD.U = fifo.word[fifo.head];
+        }
+    }
+    if (fifo.received == fifo.mrps) {
+        fifo.bActive = FALSE;
+        MODULE_I2C0.PIRQSS.U |= (1u << IFX_I2C_PIRQSS_TX_END_OFF);
+    }
+}
+
+/* RXD was read: The next word of the RX FIFO */
+static void _PopRx(void)
+{
+    fifo.bRxRequest = FALSE;
+    fifo.head = (fifo.head + 1) % HOST_I2CPOLL_FIFO_WORDS;
+    fifo.count--;
+    host_i2cPoll.words++;
+    if (fifo.count > 0) {
+        MODULE_I2C0.RXD.U = fifo.word[fifo.head];
+    }
+}
+
+/* Single request for the next TX word or for the RX word in RXD, TRUE if one was raised */
+static boolean _Request(boolean bRx)
+{
+    boolean bRequest;
+
+    if (host_i2cPoll.bLocked || (MODULE_I2C0.RIS.U & SREQ) || MODULE_I2C0.TXD.U != HOST_I2CPOLL_TXD_EMPTY) {
+        return FALSE;
+    }
+    if (bRx) {
+        bRequest = (fifo.count > 0 && fifo.bRxRequest == FALSE) ? TRUE : FALSE;
+        fifo.bRxRequest |= bRequest;
+    } else {
+        bRequest = (fifo.bActive && fifo.taken < fifo.tps && fifo.count < HOST_I2CPOLL_FIFO_WORDS) ? TRUE : FALSE;
+    }
+    if (bRequest) {
+        MODULE_I2C0.RIS.U |= SREQ;
+    }
+
+    return bRequest;
+}
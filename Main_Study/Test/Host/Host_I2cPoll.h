@@ -0,0 +1,54 @@
+#ifndef HOST_I2CPOLL_H
+#define HOST_I2CPOLL_H
+
+#include "Host.h"
+#include "Module_I2C.h"
+
+/**
+ * @brief I2C0 FIFO for the blocking calls (no ISR), played by a bus thread next to the calling thread
+ * The bus thread takes the words written to TXD into an 8 word FIFO and shifts one byte per byteTicks of STM0.
+ * The first word starts a packet of TPSCTRL.TPS bytes:
+ * - Master code (0000 1xxx): Not answered, NACK + TX_END, the master keeps the bus
+ * - Address with R/W set: MRPSCTRL.MRPS bytes of readData into the RX FIFO, RXD is its first word.
+ *   The request clear (ICR) after the read of RXD takes the word, TX_END after the last byte
+ * - Otherwise TX_END after the last byte
+ * Writes to ICR / PIRQSC / ERRIRQSC clear their flags, ENDDCTRL.SETEND is a STOP (bus idle, TX_END).
+ * RIS.SREQ is raised while the packet needs a word (TX) or has one (RX) and the calling thread has its
+ * interrupts on: The end of each interrupts-off section (host_lockHook) waits until the bus thread has taken
+ * every register write, so the words moved in a section are counted exactly.
+ */
+
+#define HOST_I2CPOLL_FIFO_WORDS         8
+#define HOST_I2CPOLL_BYTES              16384
+#define HOST_I2CPOLL_TXD_EMPTY          0xFFFFFFFFu                                     /* TXD taken: Data never has 4 x 0xFF */
+
+typedef struct _Host_I2cPoll {
+    uint32 byteTicks;
+    volatile uint32 words;                               /* FIFO words moved by the CPU: TXD written, RXD read */
+    volatile boolean bLocked;                            /* Calling thread has its interrupts off */
+    uint32 lockStartWords;
+    uint32 lockSections;                                 /* Interrupts-off sections that moved a FIFO word */
+    uint32 maxLockWords;                                 /* Most FIFO words moved in one section */
+    uint32 packets;
+    uint32 hsPackets;                                    /* Packets started with ADDRCFG.MCE set */
+    uint32 masterCodes;
+    uint32 stops;
+    uint8 readData[256];                                 /* Bytes of the read packets, in turn */
+    uint32 readPos;
+    uint8 bytes[HOST_I2CPOLL_BYTES];                     /* Bytes on the bus, address bytes included */
+    uint32 bytesLen;
+} Host_I2cPoll;
+
+extern Host_I2cPoll host_i2cPoll;
+
+/**
+ * @brief Idle bus, empty FIFO, start the bus thread and follow the interrupts-off sections of the calling thread
+ * @param baudrate SCL of the bus (byteTicks)
+ */
+extern void Host_I2cPoll_start(float32 baudrate);
+/**
+ * @brief Stop the bus thread, host_lockHook off, the register writes left are taken
+ */
+extern void Host_I2cPoll_stop(void);
+
+#endif
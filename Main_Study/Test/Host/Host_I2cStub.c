@@ -0,0 +1,224 @@
+#include <string.h>
+#include "Host_I2cStub.h"
+
+Host_I2cStub host_i2cStub;
+
+static uint32 _ByteTicks(Module_I2C_Inst *inst);
+static uint32 _WireBytes(const Module_I2C_Transaction *trans);
+static void _Record(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans, uint32 startTick);
+static uint32 _RecordOne(Module_I2C_Inst *inst, Module_I2C_Dir dir, uint8 header, boolean bHeader,
+                         volatile uint8 *data, Ifx_SizeT len, uint32 startTick);
+static void _Finish(Host_I2cQueued *queued);
+
+void Host_I2cStub_reset(void)
+{
+    memset(&host_i2cStub, 0, sizeof(host_i2cStub));
+    host_i2cStub.queueMax = HOST_I2CSTUB_QUEUE;
+    host_i2cStub.busTick = Host_now();
+}
+
+uint32 Host_I2cStub_run(void)
+{
+    Host_I2cStub *stub = &host_i2cStub;
+    uint32 count = 0;
+
+    while (stub->queueLen > 0 && (sint32)(Host_now() - stub->queue[stub->queueHead].endTick) >= 0) {
+        Host_I2cQueued queued = stub->queue[stub->queueHead];
+
+        stub->queueHead = (stub->queueHead + 1) % HOST_I2CSTUB_QUEUE;
+        stub->queueLen--;
+        _Finish(&queued);
+        count++;
+    }
+
+    return count;
+}
+
+boolean Host_I2cStub_next(void)
+{
+    Host_I2cStub *stub = &host_i2cStub;
+    sint32 wait;
+
+    if (stub->queueLen == 0) {
+        return FALSE;
+    }
+
+    wait = (sint32)(stub->queue[stub->queueHead].endTick - Host_now());
+    if (wait > 0) {
+        Host_advance((uint32)wait);
+    }
+    Host_I2cStub_run();
+    return TRUE;
+}
+
+uint32 Host_I2cStub_wireBytes(uint32 first, uint8 addr)
+{
+    uint32 bytes = 0;
+
+    for (uint32 i = first; i < host_i2cStub.transLen; i++) {
+        if (addr == 0 || host_i2cStub.trans[i].addr == addr) {
+            bytes += 1 + host_i2cStub.trans[i].len;
+        }
+    }
+
+    return bytes;
+}
+
+/* Module_I2C.h */
+
+void Init_I2C(Module_I2C_Inst *inst, const Module_I2C_Config *config)
+{
+    memset(inst, 0, sizeof(*inst));
+    inst->config = config;
+    inst->dev.deviceAddress = config->addr << 1;
+    inst->dev.addressMode = IfxI2c_AddressMode_7Bit;
+    inst->dev.speedMode = IfxI2c_Mode_StandardAndFast;
+}
+
+void Init_I2C_Async(Module_I2C_Inst *inst)
+{
+    (void)inst;
+}
+
+void Init_I2C_Dma(Module_I2C_Inst *inst, IfxDma_ChannelId channelId)
+{
+    (void)inst;
+    host_i2cStub.dmaChannel = channelId;
+}
+
+IfxI2c_I2c_Status I2c_write(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size)
+{
+    Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_WRITE, .data = data, .size = size};
+    uint32 start = host_i2cStub.busTick;
+
+    if ((sint32)(Host_now() - start) > 0) start = Host_now();
+    _Record(inst, &trans, start);
+    Host_advance(host_i2cStub.busTick - Host_now());
+    return IfxI2c_I2c_Status_ok;
+}
+
+IfxI2c_I2c_Status I2c_read(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size)
+{
+    Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_READ, .data = data, .size = size};
+    uint32 start = host_i2cStub.busTick;
+
+    if ((sint32)(Host_now() - start) > 0) start = Host_now();
+    _Record(inst, &trans, start);
+    Host_advance(host_i2cStub.busTick - Host_now());
+    return IfxI2c_I2c_Status_ok;
+}
+
+boolean I2c_submit(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans)
+{
+    Host_I2cStub *stub = &host_i2cStub;
+    Host_I2cQueued queued;
+    uint32 start = stub->busTick;
+
+    stub->submits++;
+    if (stub->refuseNext > 0 || (stub->bDeferred && stub->queueLen >= stub->queueMax)) {
+        if (stub->refuseNext > 0) stub->refuseNext--;
+        stub->refused++;
+        return FALSE;
+    }
+
+    /* Bus time from the end of the last transaction, or from now if the bus is idle */
+    if ((sint32)(Host_now() - start) > 0) start = Host_now();
+    queued.trans = *trans;
+    queued.inst = inst;
+    queued.endTick = start + (_WireBytes(trans) * _ByteTicks(inst));
+    stub->busTick = queued.endTick;
+    stub->busyTicks += queued.endTick - start;
+
+    if (stub->bDeferred) {
+        stub->queue[(stub->queueHead + stub->queueLen) % HOST_I2CSTUB_QUEUE] = queued;
+        stub->queueLen++;
+    } else {
+        Host_advance(queued.endTick - Host_now());
+        _Finish(&queued);
+    }
+
+    return TRUE;
+}
+
+static uint32 _ByteTicks(Module_I2C_Inst *inst)
+{
+    return (uint32)((9.0f * HOST_STM_TICKS_PER_US * 1000000.0f) / inst->config->baudrate);
+}
+
+/* Address byte + chunk header per bus transaction */
+static uint32 _WireBytes(const Module_I2C_Transaction *trans)
+{
+    if (trans->dir == Module_I2C_Dir_WRITE && trans->chunkSize > 0 && trans->size > 1) {
+        const uint32 chunks = (trans->size - 1 + trans->chunkSize - 1) / trans->chunkSize;
+
+        return (trans->size - 1) + (chunks * 2);
+    } else if (trans->dir == Module_I2C_Dir_WRITE_READ) {
+        return trans->size + trans->rxSize + 2;
+    }
+
+    return trans->size + 1;
+}
+
+/* Bus transactions of trans as Module_I2C cuts them, the buffers are read now */
+static void _Record(Module_I2C_Inst *inst, const Module_I2C_Transaction *trans, uint32 startTick)
+{
+    const Ifx_SizeT first = trans->bDma ? MODULE_I2C_DMA_HEADROOM : 0;
+    uint32 tick = startTick;
+
+    if (trans->dir == Module_I2C_Dir_WRITE && trans->chunkSize > 0 && trans->size > 1) {
+        const uint8 header = trans->data[first];
+
+        for (Ifx_SizeT sent = 0; sent < trans->size - 1; sent += trans->chunkSize) {
+            const Ifx_SizeT rest = trans->size - 1 - sent;
+            const Ifx_SizeT len = (rest > trans->chunkSize) ? trans->chunkSize : rest;
+
+            tick = _RecordOne(inst, Module_I2C_Dir_WRITE, header, TRUE, &trans->data[first + 1 + sent], len, tick);
+        }
+    } else if (trans->dir == Module_I2C_Dir_WRITE_READ) {
+        tick = _RecordOne(inst, Module_I2C_Dir_WRITE, 0, FALSE, trans->data, trans->size, tick);
+        tick = _RecordOne(inst, Module_I2C_Dir_READ, 0, FALSE, trans->rxData, trans->rxSize, tick);
+    } else {
+        tick = _RecordOne(inst, trans->dir, 0, FALSE, &trans->data[first], trans->size, tick);
+    }
+    host_i2cStub.busTick = ((sint32)(tick - host_i2cStub.busTick) > 0) ? tick : host_i2cStub.busTick;
+}
+
+/* Reads return 0 bytes */
+static uint32 _RecordOne(Module_I2C_Inst *inst, Module_I2C_Dir dir, uint8 header, boolean bHeader,
+                         volatile uint8 *data, Ifx_SizeT len, uint32 startTick)
+{
+    Host_I2cStub *stub = &host_i2cStub;
+    Host_I2cTrans *rec = &stub->trans[stub->transLen % HOST_I2CSTUB_TRANS];
+    const uint32 total = len + (bHeader ? 1 : 0);
+
+    stub->transLen++;
+    rec->addr = (uint8)(inst->dev.deviceAddress >> 1);
+    rec->dir = dir;
+    rec->offset = stub->bytesLen;
+    rec->len = total;
+    rec->startTick = startTick;
+    rec->endTick = startTick + ((1 + total) * _ByteTicks(inst));
+
+    if (stub->bytesLen + total <= HOST_I2CSTUB_BYTES) {
+        if (bHeader) {
+            stub->bytes[stub->bytesLen++] = header;
+        }
+        for (Ifx_SizeT i = 0; i < len; i++) {
+            if (dir == Module_I2C_Dir_READ) {
+                data[i] = 0;
+            }
+            stub->bytes[stub->bytesLen++] = data[i];
+        }
+    }
+
+    return rec->endTick;
+}
+
+static void _Finish(Host_I2cQueued *queued)
+{
+    _Record(queued->inst, &queued->trans, queued->endTick - (_WireBytes(&queued->trans) * _ByteTicks(queued->inst)));
+
+    if (queued->trans.callback != NULL_PTR) {
+        queued->trans.callback(IfxI2c_I2c_Status_ok, queued->trans.arg);
+    }
+}
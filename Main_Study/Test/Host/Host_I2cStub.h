@@ -0,0 +1,74 @@
+#ifndef HOST_I2CSTUB_H
+#define HOST_I2CSTUB_H
+
+#include "Host.h"
+#include "Module_I2C.h"
+
+/**
+ * @brief Recording stand-in for Module_I2C.c under the SSD1306 driver
+ * Every bus transaction is recorded as the queue puts it on the wire: A chunked write is cut into
+ * chunkSize pieces with the header byte in front of each, a bDma write starts at data[1].
+ * The bus time of a transaction is (address + bytes) * 9 clocks at the baudrate of its device.
+ * Immediate: I2c_submit moves STM0 over the bus time and calls the callback before it returns.
+ * Deferred: Transactions wait in the queue until Host_I2cStub_run reaches their end time.
+ */
+
+#define HOST_I2CSTUB_TRANS              4096
+#define HOST_I2CSTUB_BYTES              (256 * 1024)
+#define HOST_I2CSTUB_QUEUE              (MODULE_I2C_QUEUE_LEN * Module_I2C_Priority_COUNT)
+
+typedef struct _Host_I2cTrans {
+    uint8 addr;                                          /* 7 bit */
+    Module_I2C_Dir dir;
+    uint32 offset;                                       /* Bytes after the address byte in host_i2cStub.bytes */
+    uint32 len;
+    uint32 startTick;
+    uint32 endTick;
+} Host_I2cTrans;
+
+typedef struct _Host_I2cQueued {
+    Module_I2C_Transaction trans;
+    Module_I2C_Inst *inst;
+    uint32 endTick;
+} Host_I2cQueued;
+
+typedef struct _Host_I2cStub {
+    boolean bDeferred;
+    uint8 queueMax;                                      /* I2c_submit refuses with this many queued (deferred) */
+    uint32 refuseNext;                                   /* I2c_submit calls to refuse whatever the queue holds */
+    Host_I2cQueued queue[HOST_I2CSTUB_QUEUE];
+    uint8 queueHead;
+    uint8 queueLen;
+    uint32 busTick;                                      /* End of the last transaction on the bus */
+    uint32 busyTicks;                                    /* Sum of the bus times */
+    uint32 submits;
+    uint32 refused;
+    IfxDma_ChannelId dmaChannel;                         /* Last Init_I2C_Dma */
+    Host_I2cTrans trans[HOST_I2CSTUB_TRANS];
+    uint32 transLen;
+    uint8 bytes[HOST_I2CSTUB_BYTES];
+    uint32 bytesLen;
+} Host_I2cStub;
+
+extern Host_I2cStub host_i2cStub;
+
+/**
+ * @brief Nothing recorded or queued, immediate mode
+ */
+extern void Host_I2cStub_reset(void);
+/**
+ * @brief Deferred mode: Finish the queued transactions that ended by Host_now()
+ * @return uint32 Transactions finished
+ */
+extern uint32 Host_I2cStub_run(void);
+/**
+ * @brief Deferred mode: Move STM0 to the end of the next queued transaction and finish it
+ * @return boolean FALSE if the queue is empty
+ */
+extern boolean Host_I2cStub_next(void);
+/**
+ * @brief Bytes on the wire of the recorded transactions from first on, address bytes included
+ */
+extern uint32 Host_I2cStub_wireBytes(uint32 first, uint8 addr);
+
+#endif
@@ -0,0 +1,75 @@
+#include "Host.h"
+#include "IfxCpu_Irq.h"
+#include "IfxScuCcu.h"
+#include "IfxScuWdt.h"
+
+/* iLLD functions whose sources are not built for the host (TriCore assembly, PLL / watchdog sequences) */
+
+float32 IfxScuCcu_getSourceFrequency(IfxScuCcu_Fsource fsource)
+{
+    (void)fsource;
+    return HOST_SOURCE_FREQUENCY;
+}
+
+void IfxScuWdt_clearCpuEndinit(uint16 password)
+{
+    (void)password;
+}
+
+void IfxScuWdt_setCpuEndinit(uint16 password)
+{
+    (void)password;
+}
+
+void IfxScuWdt_clearSafetyEndinit(uint16 password)
+{
+    (void)password;
+}
+
+void IfxScuWdt_setSafetyEndinit(uint16 password)
+{
+    (void)password;
+}
+
+uint16 IfxScuWdt_getCpuWatchdogPassword(void)
+{
+    return 0;
+}
+
+uint16 IfxScuWdt_getSafetyWatchdogPassword(void)
+{
+    return 0;
+}
+
+/* As IfxCpu_Irq.c */
+IfxSrc_Tos IfxCpu_Irq_getTos(IfxCpu_ResourceCpu coreId)
+{
+    const IfxSrc_Tos tos[IFXCPU_NUM_MODULES] = {
+        IfxSrc_Tos_cpu0, IfxSrc_Tos_cpu1,
+        IfxSrc_Tos_cpu2,
+    };
+
+    return tos[coreId];
+}
+
+/* As IfxCpu.c, on the host __cmpAndSwap */
+boolean IfxCpu_setSpinLock(IfxCpu_spinLock *lock, uint32 timeoutCount)
+{
+    boolean retVal = FALSE;
+
+    do {
+        if (__cmpAndSwap((unsigned int *)lock, 1UL, 0) == 0) {
+            retVal = TRUE;
+        } else {
+            timeoutCount--;
+            Host_yield();
+        }
+    } while ((retVal == FALSE) && (timeoutCount > 0));
+
+    return retVal;
+}
+
+void IfxCpu_resetSpinLock(IfxCpu_spinLock *lock)
+{
+    __atomic_store_n(lock, 0, __ATOMIC_SEQ_CST);
+}
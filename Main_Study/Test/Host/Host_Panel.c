@@ -0,0 +1,131 @@
+#include <string.h>
+#include "Host_Panel.h"
+
+static uint8 _Params(uint8 cmd);
+static void _Command(Host_Panel *panel, uint8 value);
+static void _Execute(Host_Panel *panel);
+static void _Data(Host_Panel *panel, uint8 value);
+
+void Host_Panel_init(Host_Panel *panel, uint8 addr)
+{
+    memset(panel, 0, sizeof(*panel));
+    panel->addr = addr;
+    panel->mode = SSD1306_ADDRESSING_PAGE;
+    panel->colEnd = SSD1306_MAX_SEG - 1;
+    panel->pageEnd = SSD1306_MAX_PAGE - 1;
+    panel->next = host_i2cStub.transLen;
+}
+
+void Host_Panel_update(Host_Panel *panel)
+{
+    for (; panel->next < host_i2cStub.transLen; panel->next++) {
+        const Host_I2cTrans *trans = &host_i2cStub.trans[panel->next % HOST_I2CSTUB_TRANS];
+        const uint8 *bytes = &host_i2cStub.bytes[trans->offset];
+        uint32 pos = 0;
+
+        if (trans->addr != panel->addr || trans->dir != Module_I2C_Dir_WRITE) {
+            continue;
+        }
+
+        /* Co = 1: One byte per control byte, Co = 0: The rest of the transaction */
+        while (pos < trans->len) {
+            const uint8 control = bytes[pos++];
+            const boolean bData = (control & 0x40) ? TRUE : FALSE;
+            const uint32 end = (control & 0x80) ? pos + 1 : trans->len;
+
+            for (; pos < end && pos < trans->len; pos++) {
+                if (bData) {
+                    _Data(panel, bytes[pos]);
+                } else {
+                    _Command(panel, bytes[pos]);
+                }
+            }
+        }
+    }
+}
+
+boolean Host_Panel_equals(const Host_Panel *panel, const uint8 buff[SSD1306_MAX_PAGE][SSD1306_MAX_SEG], uint8 pageLen)
+{
+    return (memcmp(panel->gddram, buff, pageLen * SSD1306_MAX_SEG) == 0) ? TRUE : FALSE;
+}
+
+/* Parameter bytes after the command byte (9-1 Command Table) */
+static uint8 _Params(uint8 cmd)
+{
+    switch (cmd) {
+    case 0x26: case 0x27:
+        return 6;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void _Command(Host_Panel *panel, uint8 value)
+{
+    if (panel->cmdLen == 0) {
+        panel->cmdNeed = _Params(value);
+    }
+    panel->cmd[panel->cmdLen++] = value;
+    if (panel->cmdLen > panel->cmdNeed) {
+        _Execute(panel);
+        panel->cmdLen = 0;
+        panel->commands++;
+    }
+}
+
+static void _Execute(Host_Panel *panel)
+{
+    const uint8 *cmd = panel->cmd;
+
+    if (cmd[0] == 0x20) {
+        panel->mode = cmd[1] & 0x03;
+    } else if (cmd[0] == 0x21) {
+        panel->colStart = cmd[1] & 0x7F;
+        panel->colEnd = cmd[2] & 0x7F;
+        panel->col = panel->colStart;
+    } else if (cmd[0] == 0x22) {
+        panel->pageStart = cmd[1] & 0x07;
+        panel->pageEnd = cmd[2] & 0x07;
+        panel->page = panel->pageStart;
+    } else if (cmd[0] >= 0xB0 && cmd[0] <= 0xB7) {
+        panel->page = cmd[0] & 0x07;
+    } else if (cmd[0] <= 0x0F) {
+        panel->col = (panel->col & 0xF0) | cmd[0];
+    } else if (cmd[0] >= 0x10 && cmd[0] <= 0x1F) {
+        panel->col = (panel->col & 0x0F) | ((cmd[0] & 0x07) << 4);
+    } else if (cmd[0] >= 0x40 && cmd[0] <= 0x7F) {
+        panel->startLine = cmd[0] & 0x3F;
+    } else if (cmd[0] == 0xAE || cmd[0] == 0xAF) {
+        panel->bOn = cmd[0] & 0x01;
+    } else if (cmd[0] == 0x26 || cmd[0] == 0x27) {
+        memcpy(panel->scroll, cmd, sizeof(panel->scroll));
+    } else if (cmd[0] == 0x2E || cmd[0] == 0x2F) {
+        panel->bScroll = cmd[0] & 0x01;
+    }
+}
+
+static void _Data(Host_Panel *panel, uint8 value)
+{
+    panel->gddram[panel->page][panel->col] = value;
+    panel->dataBytes++;
+
+    if (panel->mode == SSD1306_ADDRESSING_HORIZONTAL) {
+        if (panel->col++ >= panel->colEnd) {
+            panel->col = panel->colStart;
+            panel->page = (panel->page >= panel->pageEnd) ? panel->pageStart : panel->page + 1;
+        }
+    } else if (panel->mode == SSD1306_ADDRESSING_VERTICAL) {
+        if (panel->page++ >= panel->pageEnd) {
+            panel->page = panel->pageStart;
+            panel->col = (panel->col >= panel->colEnd) ? panel->colStart : panel->col + 1;
+        }
+    } else {
+        panel->col = (panel->col + 1) % SSD1306_MAX_SEG;
+    }
+}
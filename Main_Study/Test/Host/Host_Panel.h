@@ -0,0 +1,44 @@
+#ifndef HOST_PANEL_H
+#define HOST_PANEL_H
+
+#include "Host_I2cStub.h"
+#include "SSD1306.h"
+
+/**
+ * @brief SSD1306 GDDRAM rebuilt from the transactions recorded by Host_I2cStub (Tools/ssd1306_emu.py in C)
+ * Control bytes as in Figure 8-7, horizontal / vertical / page addressing with the 0x21 / 0x22 window.
+ * Scroll commands are only recorded, the GDDRAM does not move.
+ */
+
+typedef struct _Host_Panel {
+    uint8 addr;
+    uint8 gddram[SSD1306_MAX_PAGE][SSD1306_MAX_SEG];
+    uint8 mode;
+    uint8 colStart, colEnd, col;
+    uint8 pageStart, pageEnd, page;
+    uint8 startLine;
+    boolean bOn;
+    boolean bScroll;                                     /* 0x2F until 0x2E */
+    uint8 scroll[7];                                     /* Last 0x26 / 0x27 with its parameters */
+    uint8 cmd[8];                                        /* Command waiting for its parameters */
+    uint8 cmdLen;
+    uint8 cmdNeed;
+    uint32 commands;
+    uint32 dataBytes;
+    uint32 next;                                         /* First transaction of host_i2cStub not decoded yet */
+} Host_Panel;
+
+/**
+ * @brief Power on state of the controller, decoding starts at the next recorded transaction
+ */
+extern void Host_Panel_init(Host_Panel *panel, uint8 addr);
+/**
+ * @brief Decode the transactions recorded since the last call
+ */
+extern void Host_Panel_update(Host_Panel *panel);
+/**
+ * @brief TRUE if the first pageLen pages of the GDDRAM hold buff
+ */
+extern boolean Host_Panel_equals(const Host_Panel *panel, const uint8 buff[SSD1306_MAX_PAGE][SSD1306_MAX_SEG], uint8 pageLen);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef HOST_TYPES_H
+#define HOST_TYPES_H
+
+/* Forced in front of every source (-include): Platform_Types.h of the iLLD with 32 bit uint32 / sint32 on an
+ * LP64 host, where long has 64 bit. Platform_Types.h itself is skipped by its include guard. */
+#define PLATFORM_TYPES_H
+
+#define CPU_TYPE_8      (8u)
+#define CPU_TYPE_16     (16u)
+#define CPU_TYPE_32     (32u)
+#define CPU_TYPE        CPU_TYPE_32
+#define MSB_FIRST       (0u)
+#define LSB_FIRST       (1u)
+#define CPU_BIT_ORDER   LSB_FIRST
+#define HIGH_BYTE_FIRST (0u)
+#define LOW_BYTE_FIRST  (1u)
+#define CPU_BYTE_ORDER  LOW_BYTE_FIRST
+
+#ifndef TRUE
+#define TRUE        (1u)
+#endif
+#ifndef FALSE
+#define FALSE       (0u)
+#endif
+
+typedef unsigned char       boolean;
+typedef unsigned char       uint8;
+typedef unsigned short      uint16;
+typedef unsigned int        uint32;
+typedef unsigned long long  uint64;
+typedef signed char         sint8;
+typedef short               sint16;
+typedef int                 sint32;
+typedef long long           sint64;
+typedef unsigned int        uint8_least;
+typedef unsigned int        uint16_least;
+typedef unsigned int        uint32_least;
+typedef signed int          sint8_least;
+typedef signed int          sint16_least;
+typedef signed int          sint32_least;
+typedef float               float32;
+typedef double              float64;
+
+#endif
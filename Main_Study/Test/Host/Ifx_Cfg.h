@@ -0,0 +1,53 @@
+#ifndef IFX_CFG_H
+#define IFX_CFG_H 1
+
+/* Host build of the ASW and DataHandling sources (Test/Makefile): Takes the place of Configurations/Ifx_Cfg.h.
+ * The iLLD headers are used as they are, only the TriCore intrinsics and the interrupt vector code are replaced. */
+
+#define IFX_CFG_SCU_XTAL_FREQUENCY      (20000000)
+#define IFX_CFG_SCU_PLL_FREQUENCY       (300000000)
+#define IFX_CFG_SCU_PLL1_FREQUENCY      (320000000)
+#define IFX_CFG_SCU_PLL2_FREQUENCY      (200000000)
+
+/* IFX_INTERRUPT is a plain function, the test calls the ISRs */
+#define IFX_USE_SW_MANAGED_INT
+
+/* IfxCpu_IntrinsicsGcc.h is TriCore inline assembly: Skipped, Host_Cpu.c stands in for the core registers */
+#define IFXCPU_INTRINSICSGCC_H
+
+extern unsigned int Host_mfcr(unsigned int reg);
+extern void Host_mtcr(unsigned int reg, unsigned int value);
+extern void Host_disable(void);
+extern void Host_enable(void);
+extern void Host_debug(void);
+extern unsigned int Host_cmpAndSwap(unsigned int volatile *address, unsigned int value, unsigned int condition);
+extern void Host_assert(const char *expr, const char *file, int line);
+
+#define __mfcr(reg)                             Host_mfcr(reg)
+#define __mtcr(reg, value)                      Host_mtcr((reg), (value))
+#define __disable()                             Host_disable()
+#define __enable()                              Host_enable()
+#define __debug()                               Host_debug()
+#define __nop()                                 ((void)0)
+#define __stopPerfCounters()                    ((void)0)
+#define __dsync()                               __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __isync()                               __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __cmpAndSwap(address, value, condition) Host_cmpAndSwap((address), (value), (condition))
+#define __swap(address, value)                  __atomic_exchange_n((address), (value), __ATOMIC_SEQ_CST)
+#define __ldmst(address, mask, value)           (*(volatile unsigned int *)(address) = \
+                                                 (*(volatile unsigned int *)(address) & ~(mask)) | ((mask) & (value)))
+#define __getbit(address, bitoffset)            ((*(address) & (1U << (bitoffset))) != 0)
+#define __min(a, b)                             (((a) < (b)) ? (a) : (b))
+#define __max(a, b)                             (((a) > (b)) ? (a) : (b))
+#define __minu(a, b)                            __min(a, b)
+#define __maxu(a, b)                            __max(a, b)
+#define __abs(a)                                (((a) < 0) ? -(a) : (a))
+#define __clz(a)                                (((a) != 0) ? __builtin_clz(a) : 32)
+#define __extru(a, p, w)                        (((unsigned int)(a) >> (p)) & ((1u << (w)) - 1u))
+#define __insert(a, b, p, w)                    (((unsigned int)(a) & ~(((1u << (w)) - 1u) << (p))) | \
+                                                 (((unsigned int)(b) & ((1u << (w)) - 1u)) << (p)))
+
+/* Ifx_Assert.h: Every IFX_ASSERT of the sources is checked, see Host_expectAssert */
+#define IFX_ASSERT(level, expr)                 ((expr) ? ((void)0) : Host_assert(#expr, __FILE__, __LINE__))
+
+#endif /* IFX_CFG_H */
@@ -0,0 +1,6 @@
+#ifndef HOST_MACHINE_CINT_H
+#define HOST_MACHINE_CINT_H
+
+/* TriCore GCC interrupt helpers, included by Ifx_TypesGcc.h: Nothing of it is used by the host build */
+
+#endif
@@ -0,0 +1,191 @@
+#include "SSD1306.c"            /* Tables and builders are static */
+#include "Host_Panel.h"
+
+/* Constant command tables against the runtime builders, both from the SSD1306_CMD_* macros (user-010),
+ * boot traffic per command against the command lists (user-004) */
+
+static IFX_ALIGN(4) SSD1306_Inst panel;
+
+/* Bytes of the transaction recorded at index */
+static boolean _Equals(uint32 index, const uint8 *table, uint32 size)
+{
+    const Host_I2cTrans *trans = &host_i2cStub.trans[index];
+
+    return (trans->len == size && memcmp(&host_i2cStub.bytes[trans->offset], table, size) == 0) ? TRUE : FALSE;
+}
+
+/* SSD1306_INIT_CMD built at runtime, command by command */
+static void _BuildInit(uint8 mux, uint8 comPins)
+{
+    _BeginCommandList(&panel);
+    SetMemoryAddressingMode(&panel, SSD1306_ADDRESSING_HORIZONTAL);
+    SetMultiplexRatio(&panel, mux);
+    SetDisplayOffset(&panel, 0x00);
+    SetDisplayStartLine(&panel, 0x00);
+    SetSegmentReMap(&panel, 1);
+    SetComOutputScanDirection(&panel, 1);
+    SetComPinsHardwareConfig(&panel, comPins);
+    SetContrastControl(&panel, 0x7F);
+    EntireDisplayOn(&panel, 0);
+    SetNormalInverseDisplay(&panel, 0);
+    SetDisplayClockRatioFreq(&panel, 0x0, 0x8);
+    ChargePumpSetting(&panel, 1);
+    SetDisplayOnOff(&panel, 1);
+    _EndCommandList(&panel);
+}
+
+static void _TestBuilders(void)
+{
+    uint32 first = host_i2cStub.transLen;
+
+    _BuildInit(0x3F, 1);
+    TEST_CHECK(_Equals(first, ssd1306_initCmd, sizeof(ssd1306_initCmd)));
+
+    first = host_i2cStub.transLen;
+    _BuildInit(0x1F, 0);
+    TEST_CHECK(_Equals(first, ssd1306_initCmd32, sizeof(ssd1306_initCmd32)));
+
+    first = host_i2cStub.transLen;
+    _BeginCommandList(&panel);
+    SetComlumnAddress(&panel, 0, SSD1306_MAX_SEG - 1);
+    SetPageAddress(&panel, 0, SSD1306_MAX_PAGE - 1);
+    _EndCommandList(&panel);
+    TEST_CHECK(_Equals(first, ssd1306_fullWindowCmd, sizeof(ssd1306_fullWindowCmd)));
+
+    first = host_i2cStub.transLen;
+    _BeginCommandList(&panel);
+    ChargePumpSetting(&panel, 1);
+    SetDisplayOnOff(&panel, 1);
+    _EndCommandList(&panel);
+    TEST_CHECK(_Equals(first, ssd1306_powerOnCmd, sizeof(ssd1306_powerOnCmd)));
+
+    first = host_i2cStub.transLen;
+    _BeginCommandList(&panel);
+    SetDisplayOnOff(&panel, 0);
+    ChargePumpSetting(&panel, 0);
+    _EndCommandList(&panel);
+    TEST_CHECK(_Equals(first, ssd1306_powerOffCmd, sizeof(ssd1306_powerOffCmd)));
+
+    /* One transaction per builder call outside a list: Same command bytes, one control byte each */
+    first = host_i2cStub.transLen;
+    ChargePumpSetting(&panel, 1);
+    SetDisplayOnOff(&panel, 1);
+    TEST_CHECK(host_i2cStub.transLen - first == 2);
+    TEST_CHECK(_Equals(first, (const uint8[]){SSD1306_CMD_STREAM, SSD1306_CMD_CHARGE_PUMP(1)}, 3));
+    TEST_CHECK(_Equals(first + 1, (const uint8[]){SSD1306_CMD_STREAM, SSD1306_CMD_DISPLAY_ON(1)}, 2));
+}
+
+/* Boot to the first frame as before the command lists: Every builder call is its own transaction */
+static void _BootPerCommand(void)
+{
+    uint8 *txBuff;
+
+    SetMemoryAddressingMode(&panel, SSD1306_ADDRESSING_HORIZONTAL);
+    SetMultiplexRatio(&panel, 0x3F);
+    SetDisplayOffset(&panel, 0x00);
+    SetDisplayStartLine(&panel, 0x00);
+    SetSegmentReMap(&panel, 1);
+    SetComOutputScanDirection(&panel, 1);
+    SetComPinsHardwareConfig(&panel, 1);
+    SetContrastControl(&panel, 0x7F);
+    EntireDisplayOn(&panel, 0);
+    SetNormalInverseDisplay(&panel, 0);
+    SetDisplayClockRatioFreq(&panel, 0x0, 0x8);
+    ChargePumpSetting(&panel, 1);
+    SetDisplayOnOff(&panel, 1);
+    SetComlumnAddress(&panel, 0, SSD1306_MAX_SEG - 1);
+    SetPageAddress(&panel, 0, SSD1306_MAX_PAGE - 1);
+
+    txBuff = _GetTxBuff(&panel);
+    memset(txBuff, 0, SSD1306_STREAM_BUFF_MAX);
+    txBuff[0] = (0x00 | (SSD1306_Packet_DATA << 6));
+    _SendTxBuff(&panel, SSD1306_STREAM_BUFF_MAX);
+}
+
+typedef struct _Boot {
+    uint32 bytes;
+    uint32 transactions;
+    uint32 ticks;
+} Boot;
+
+static Boot _Measure(boolean bPerCommand)
+{
+    const uint8 addr = SSD1306_PanelConfig[0].i2c.addr;
+    const uint32 first = host_i2cStub.transLen;
+    const uint32 start = Host_now();
+    Boot boot;
+
+    if (bPerCommand) {
+        _BootPerCommand();
+    } else {
+        Init_SSD1306(&panel, &SSD1306_PanelConfig[0]);
+    }
+    boot.bytes = Host_I2cStub_wireBytes(first, addr);
+    boot.transactions = host_i2cStub.transLen - first;
+    boot.ticks = Host_now() - start;
+    printf("| %-27s | %5u | %2u | %.2f ms |\n", bPerCommand ? "One transaction per command" : "Command list",
+           boot.bytes, boot.transactions, boot.ticks / (HOST_STM_TICKS_PER_US * 1000.0f));
+
+    return boot;
+}
+
+/* Init_SSD1306 of the 128x64 panel on the host I2C stub at 1 MHz, bus time only */
+static void _TestBoot(void)
+{
+    const uint32 commandBytes = sizeof(ssd1306_initCmd) - 1;
+    Boot perCommand;
+    Boot list;
+
+    printf("| Boot to first frame         | Bytes | Tx | Bus |\n");
+    printf("| - | - | - | - |\n");
+    list = _Measure(FALSE);                                             /* Also back to the 128x64 panel */
+    perCommand = _Measure(TRUE);
+
+    /* Init: Address + control byte per command, then the same window and 4 GDDRAM chunks */
+    TEST_CHECK(perCommand.transactions == 13 + 2 + 4 && list.transactions == 1 + 1 + 4);
+    TEST_CHECK(perCommand.bytes - list.bytes == (13 - 1) * 2 + (2 - 1) * 2);
+    TEST_CHECK(list.bytes == (2 + commandBytes) + (2 + 6) + (4 * (2 + SSD1306_STREAM_CHUNK)));
+    TEST_CHECK(panel.stats.initTicks == list.ticks);
+}
+
+/* The tables reach the bus as they are */
+static void _TestTables(void)
+{
+    SSD1306_Config config32 = SSD1306_PanelConfig[1];
+    uint32 first = host_i2cStub.transLen;
+    Host_Panel gddram;
+
+    Host_Panel_init(&gddram, SSD1306_PanelConfig[0].i2c.addr);
+    Init_SSD1306(&panel, &SSD1306_PanelConfig[0]);
+    TEST_CHECK(_Equals(first, ssd1306_initCmd, sizeof(ssd1306_initCmd)));
+    TEST_CHECK(_Equals(first + 1, ssd1306_fullWindowCmd, sizeof(ssd1306_fullWindowCmd)));
+    Host_Panel_update(&gddram);
+    TEST_CHECK(gddram.bOn && gddram.mode == SSD1306_ADDRESSING_HORIZONTAL);
+
+    first = host_i2cStub.transLen;
+    SSD1306_SetPower(&panel, 0);
+    /* From flash: No copy into the txBuff or the command list */
+    TEST_CHECK(panel.txTrans.data == ssd1306_powerOffCmd && panel.txTrans.bDma == FALSE);
+    SSD1306_SetPower(&panel, 1);
+    TEST_CHECK(_Equals(first, ssd1306_powerOffCmd, sizeof(ssd1306_powerOffCmd)));
+    TEST_CHECK(_Equals(first + 1, ssd1306_powerOnCmd, sizeof(ssd1306_powerOnCmd)));
+    Host_Panel_update(&gddram);
+    TEST_CHECK(gddram.bOn);
+
+    first = host_i2cStub.transLen;
+    Init_SSD1306(&panel, &config32);
+    TEST_CHECK(_Equals(first, ssd1306_initCmd32, sizeof(ssd1306_initCmd32)));
+    TEST_CHECK(panel.pageLen == SSD1306_MAX_PAGE / 2);
+}
+
+int main(void)
+{
+    Host_I2cStub_reset();
+    Init_SSD1306(&panel, &SSD1306_PanelConfig[0]);
+
+    _TestBuilders();
+    _TestTables();
+    _TestBoot();
+
+    return Host_report("Test_CommandTable");
+}
@@ -0,0 +1,133 @@
+#include "SSD1306.c"            /* The older senders are static */
+#include "Host_Panel.h"
+
+/* Bytes and bus time of a full frame per I2C data mode at 1 MHz (user-002, STUDY.md I2C Data Stream) */
+
+#define PANEL_ADDR                      0x3D
+
+static IFX_ALIGN(4) SSD1306_Inst panel;
+static uint8 frame[SSD1306_MAX_PAGE][SSD1306_MAX_SEG];
+static Host_Panel gddram;
+
+typedef struct _Mode {
+    uint32 bytes;
+    uint32 transactions;
+    uint32 ticks;
+} Mode;
+
+static Mode _Begin(void)
+{
+    Mode mode = {Host_I2cStub_wireBytes(0, PANEL_ADDR), host_i2cStub.transLen, Host_now()};
+
+    return mode;
+}
+
+static void _End(Mode *mode, const char *name)
+{
+    mode->bytes = Host_I2cStub_wireBytes(0, PANEL_ADDR) - mode->bytes;
+    mode->transactions = host_i2cStub.transLen - mode->transactions;
+    mode->ticks = Host_now() - mode->ticks;
+    Host_Panel_update(&gddram);
+
+    printf("| %-36s | %5u | %3u | %5.2f ms | %4.0f |\n", name, mode->bytes, mode->transactions,
+           mode->ticks / (HOST_STM_TICKS_PER_US * 1000.0f), (HOST_STM_TICKS_PER_US * 1000000.0f) / mode->ticks);
+}
+
+/* Co = 1 data byte pairs as the driver sent them before the streams (Figure 8-7), the last control byte has Co = 0 */
+static void _MakePairs(uint8 *buffer, const uint8 *data, Ifx_SizeT size)
+{
+    for (Ifx_SizeT i = 0; i < size; i++) {
+        buffer[i * 2] = (uint8)(((i + 1 < size) ? 0x80 : 0x00) | (SSD1306_Packet_DATA << 6));
+        buffer[(i * 2) + 1] = data[i];
+    }
+}
+
+/* Co = 1: Control byte before every data byte, page addressing */
+static Mode _Pairs(void)
+{
+    Mode mode;
+    uint8 buffer[SSD1306_MAX_SEG * 2];
+
+    SetMemoryAddressingMode(&panel, SSD1306_ADDRESSING_PAGE);
+    mode = _Begin();
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        SetPageAndColumnPosition(&panel, page, 0);
+        _MakePairs(buffer, frame[page], SSD1306_MAX_SEG);
+        I2c_write(&panel.i2c, buffer, sizeof(buffer));
+    }
+    _End(&mode, "Co = 1 pairs");
+
+    return mode;
+}
+
+/* Co = 0: One control byte per page, page addressing */
+static Mode _PageStreams(void)
+{
+    Mode mode;
+
+    SetMemoryAddressingMode(&panel, SSD1306_ADDRESSING_PAGE);
+    mode = _Begin();
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        SetPageAndColumnPosition(&panel, page, 0);
+        _SendData(&panel, SSD1306_Packet_DATA, frame[page], SSD1306_MAX_SEG);
+    }
+    _End(&mode, "Co = 0 stream");
+
+    return mode;
+}
+
+/* Co = 0: One window, the whole GDDRAM as one stream (SSD1306_Blit) */
+static Mode _Window(void)
+{
+    Mode mode;
+
+    SetMemoryAddressingMode(&panel, SSD1306_ADDRESSING_HORIZONTAL);
+    mode = _Begin();
+    SSD1306_Blit(&panel, &frame[0][0], SSD1306_MAX_SEG, 0, SSD1306_MAX_PAGE, 0, SSD1306_MAX_SEG);
+    _End(&mode, "Co = 0 stream, Horizontal Addressing");
+
+    return mode;
+}
+
+int main(void)
+{
+    uint32 seed = 1;
+    Mode mode;
+
+    Host_I2cStub_reset();
+    Host_Panel_init(&gddram, PANEL_ADDR);
+    Init_SSD1306(&panel, &SSD1306_PanelConfig[0]);
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        for (int i = 0; i < SSD1306_MAX_SEG; i++) {
+            seed = (seed * 1103515245) + 12345;
+            frame[page][i] = (uint8)(seed >> 16);
+        }
+    }
+
+    printf("| Mode                                 | Bytes | Tx  | Bus      | fps  |\n");
+    printf("|--------------------------------------|-------|-----|----------|------|\n");
+
+    /* Page address (3 x 3) + address byte + 128 pairs */
+    mode = _Pairs();
+    TEST_CHECK(mode.bytes == SSD1306_MAX_PAGE * ((3 * 3) + 1 + (2 * SSD1306_MAX_SEG)));
+    TEST_CHECK(mode.transactions == SSD1306_MAX_PAGE * 4);
+    TEST_CHECK(Host_Panel_equals(&gddram, frame, SSD1306_MAX_PAGE));
+
+    memset(gddram.gddram, 0, sizeof(gddram.gddram));
+    mode = _PageStreams();
+    TEST_CHECK(mode.bytes == SSD1306_MAX_PAGE * ((3 * 3) + 2 + SSD1306_MAX_SEG));
+    TEST_CHECK(mode.transactions == SSD1306_MAX_PAGE * 4);
+    TEST_CHECK(Host_Panel_equals(&gddram, frame, SSD1306_MAX_PAGE));
+
+    /* Window command list + 4 chunks of 256 data bytes, each with address and control byte */
+    memset(gddram.gddram, 0, sizeof(gddram.gddram));
+    mode = _Window();
+    TEST_CHECK(mode.bytes == (1 + 7) + (4 * (2 + SSD1306_STREAM_CHUNK)));
+    TEST_CHECK(mode.transactions == 5);
+    TEST_CHECK(Host_Panel_equals(&gddram, frame, SSD1306_MAX_PAGE));
+
+    /* Bus time is 9 clocks per byte at the panel's baudrate */
+    TEST_CHECK(mode.ticks == mode.bytes * 9 * (HOST_STM_TICKS_PER_US * 1000000.0f / SSD1306_PanelConfig[0].i2c.baudrate));
+
+    return Host_report("Test_DataStream");
+}
@@ -0,0 +1,234 @@
+#include <string.h>
+#include <time.h>
+#include "Host.h"
+#include "Ifx_Fifo.h"
+
+/* Zero copy spans of Ifx_Fifo and Ifx_CircularBuffer against the copying calls (user-024) */
+
+#define BENCH_BYTES                     (64u * 1024u * 1024u)
+
+static IFX_ALIGN(8) uint8 memory[4096 + sizeof(Ifx_Fifo) + 8];
+static uint8 data[256];
+static uint8 out[256];
+
+/* Producer format: Byte n of the stream */
+static void _Format(uint8 *dst, Ifx_SizeT count, uint32 *n)
+{
+    for (Ifx_SizeT i = 0; i < count; i++) {
+        dst[i] = (uint8)((*n)++ * 7);
+    }
+}
+
+/* Consumer checksum, order dependent */
+static void _Sum(const uint8 *src, Ifx_SizeT count, uint32 *sum)
+{
+    for (Ifx_SizeT i = 0; i < count; i++) {
+        *sum = (*sum * 31) + src[i];
+    }
+}
+
+static void _SpanFormat(const Ifx_CircularBuffer_Span *span, uint32 *n)
+{
+    _Format(span->data[0], span->count[0], n);
+    _Format(span->data[1], span->count[1], n);
+}
+
+static void _SpanSum(const Ifx_CircularBuffer_Span *span, uint32 *sum)
+{
+    _Sum(span->data[0], span->count[0], sum);
+    _Sum(span->data[1], span->count[1], sum);
+}
+
+static void _TestCircularBuffer(void)
+{
+    uint8 base[10];
+    Ifx_CircularBuffer buffer = {base, 7, sizeof(base)};
+    Ifx_CircularBuffer_Span span;
+
+    Ifx_CircularBuffer_getSpan(&buffer, 6, &span);
+    TEST_CHECK(span.data[0] == &base[7] && span.count[0] == 3);
+    TEST_CHECK(span.data[1] == base && span.count[1] == 3);
+    TEST_CHECK(buffer.index == 7);
+    Ifx_CircularBuffer_advance(&buffer, 6);
+    TEST_CHECK(buffer.index == 3);
+
+    /* Up to the end: No second region, the index goes back to the base */
+    Ifx_CircularBuffer_getSpan(&buffer, 7, &span);
+    TEST_CHECK(span.count[0] == 7 && span.count[1] == 0);
+    Ifx_CircularBuffer_advance(&buffer, 7);
+    TEST_CHECK(buffer.index == 0);
+
+    /* The whole buffer */
+    Ifx_CircularBuffer_getSpan(&buffer, sizeof(base), &span);
+    TEST_CHECK(span.data[0] == base && span.count[0] == sizeof(base) && span.count[1] == 0);
+}
+
+/* Spans over the end of the buffer, whole elements only, mixed with Ifx_Fifo_write / Ifx_Fifo_read */
+static void _TestFifo(void)
+{
+    Ifx_Fifo *fifo = Ifx_Fifo_init(memory, 64, 4);
+    Ifx_CircularBuffer_Span span;
+    uint32 n = 0;
+
+    for (int i = 0; i < (int)sizeof(data); i++) {
+        data[i] = (uint8)(i * 7);
+    }
+
+    TEST_CHECK(Ifx_Fifo_peek(fifo, 64, &span) == 0);
+    TEST_CHECK(Ifx_Fifo_reserve(fifo, 10, &span) == 8);                 /* Incomplete element left out */
+    TEST_CHECK(Ifx_Fifo_reserve(fifo, 100, &span) == 64);
+    TEST_CHECK(span.data[0] == fifo->buffer && span.count[0] == 64 && span.count[1] == 0);
+
+    /* Indexes at 24 and 40: The free space and then the data wrap */
+    TEST_CHECK(Ifx_Fifo_write(fifo, data, 40, TIME_NULL) == 0);
+    TEST_CHECK(Ifx_Fifo_read(fifo, out, 24, TIME_NULL) == 0);
+    TEST_CHECK(memcmp(out, data, 24) == 0);
+    TEST_CHECK(Ifx_Fifo_reserve(fifo, 100, &span) == 48);
+    TEST_CHECK(span.data[0] == (uint8 *)fifo->buffer + 40 && span.count[0] == 24);
+    TEST_CHECK(span.data[1] == fifo->buffer && span.count[1] == 24);
+    n = 40;
+    _SpanFormat(&span, &n);
+    TEST_CHECK(Ifx_Fifo_readCount(fifo) == 16);                         /* Not published before the commit */
+    Ifx_Fifo_commit(fifo, 48);
+    TEST_CHECK(Ifx_Fifo_readCount(fifo) == 64 && Ifx_Fifo_writeCount(fifo) == 0);
+    TEST_CHECK(fifo->shared.maxcount == 64);
+
+    TEST_CHECK(Ifx_Fifo_peek(fifo, 63, &span) == 60);
+    TEST_CHECK(span.data[0] == (uint8 *)fifo->buffer + 24 && span.count[0] == 40 && span.count[1] == 20);
+    TEST_CHECK(memcmp(span.data[0], &data[24], 40) == 0);
+    TEST_CHECK(memcmp(span.data[1], &data[64], 20) == 0);
+    Ifx_Fifo_release(fifo, 20);
+    TEST_CHECK(Ifx_Fifo_readCount(fifo) == 44);
+
+    /* The rest through the copying read, over the end */
+    TEST_CHECK(Ifx_Fifo_read(fifo, out, 44, TIME_NULL) == 0);
+    TEST_CHECK(memcmp(out, &data[44], 44) == 0);
+    TEST_CHECK(Ifx_Fifo_readCount(fifo) == 0 && fifo->startIndex == fifo->endIndex);
+
+    /* A reserve that is only partly committed */
+    TEST_CHECK(Ifx_Fifo_reserve(fifo, 32, &span) == 32);
+    memcpy(span.data[0], data, span.count[0]);
+    memcpy(span.data[1], &data[span.count[0]], span.count[1]);
+    Ifx_Fifo_commit(fifo, 8);
+    Ifx_Fifo_commit(fifo, 0);
+    TEST_CHECK(Ifx_Fifo_readCount(fifo) == 8);
+    TEST_CHECK(Ifx_Fifo_read(fifo, out, 8, TIME_NULL) == 0);
+    TEST_CHECK(memcmp(out, data, 8) == 0);
+
+    /* Incomplete element or more than available */
+    {
+        const uint32 asserts = host_assertCount;
+
+        if (Host_expectAssert() == 0) {
+            Ifx_Fifo_commit(fifo, 6);
+        }
+        if (Host_expectAssert() == 0) {
+            Ifx_Fifo_release(fifo, 4);
+        }
+        TEST_CHECK(host_assertCount == asserts + 2);
+        TEST_CHECK(Ifx_Fifo_readCount(fifo) == 0);
+    }
+}
+
+static double _Seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+typedef enum {
+    Path_fifoCopy,
+    Path_fifoSpan,
+    Path_bufferCopy,
+    Path_bufferSpan,
+} Path;
+
+/* BENCH_BYTES through one fifo, 1 byte elements: The producer formats a chunk, the consumer checksums it */
+static uint32 _Run(Path path, Ifx_SizeT size, Ifx_SizeT chunk, double *mbs)
+{
+    static uint8 chunkIn[1024];
+    static uint8 chunkOut[1024];
+    Ifx_Fifo *fifo = Ifx_Fifo_init(memory, size, 1);
+    Ifx_CircularBuffer writer = {fifo->buffer, 0, (uint16)size};
+    Ifx_CircularBuffer reader = writer;
+    Ifx_CircularBuffer_Span span;
+    uint32 n = 0;
+    uint32 sum = 0;
+    const double start = _Seconds();
+
+    for (uint32 moved = 0; moved < BENCH_BYTES; moved += chunk) {
+        switch (path) {
+        case Path_fifoCopy:
+            _Format(chunkIn, chunk, &n);
+            Ifx_Fifo_write(fifo, chunkIn, chunk, TIME_NULL);
+            Ifx_Fifo_read(fifo, chunkOut, chunk, TIME_NULL);
+            _Sum(chunkOut, chunk, &sum);
+            break;
+        case Path_fifoSpan:
+            Ifx_Fifo_reserve(fifo, chunk, &span);
+            _SpanFormat(&span, &n);
+            Ifx_Fifo_commit(fifo, chunk);
+            Ifx_Fifo_peek(fifo, chunk, &span);
+            _SpanSum(&span, &sum);
+            Ifx_Fifo_release(fifo, chunk);
+            break;
+        case Path_bufferCopy:
+            _Format(chunkIn, chunk, &n);
+            Ifx_CircularBuffer_write8(&writer, chunkIn, chunk);
+            Ifx_CircularBuffer_read8(&reader, chunkOut, chunk);
+            _Sum(chunkOut, chunk, &sum);
+            break;
+        case Path_bufferSpan:
+            Ifx_CircularBuffer_getSpan(&writer, chunk, &span);
+            _SpanFormat(&span, &n);
+            Ifx_CircularBuffer_advance(&writer, chunk);
+            Ifx_CircularBuffer_getSpan(&reader, chunk, &span);
+            _SpanSum(&span, &sum);
+            Ifx_CircularBuffer_advance(&reader, chunk);
+            break;
+        }
+    }
+
+    *mbs = BENCH_BYTES / (_Seconds() - start) / 1e6;
+    TEST_CHECK(n == BENCH_BYTES);
+    TEST_CHECK(path > Path_fifoSpan || Ifx_Fifo_readCount(fifo) == 0);
+    return sum;
+}
+
+/* Host time only: The ratio between the copying and the zero copy calls, not TriCore cycles */
+static void _Bench(void)
+{
+    static const Ifx_SizeT setups[4][2] = {{1024, 16}, {1024, 256}, {4096, 64}, {4096, 1024}};
+    uint32 expected = 0;
+    uint32 n = 0;
+
+    for (uint32 i = 0; i < BENCH_BYTES; i += sizeof(data)) {
+        _Format(data, sizeof(data), &n);
+        _Sum(data, sizeof(data), &expected);
+    }
+
+    printf("%u MB of 1 byte elements on the host, MB/s:\n", BENCH_BYTES >> 20);
+    printf("| fifo | chunk | write/read | reserve/peek | write8/read8 | getSpan/advance |\n");
+    printf("| - | - | - | - | - | - |\n");
+    for (int i = 0; i < 4; i++) {
+        double mbs[4];
+
+        for (Path path = Path_fifoCopy; path <= Path_bufferSpan; path++) {
+            TEST_CHECK(_Run(path, setups[i][0], setups[i][1], &mbs[path]) == expected);
+        }
+        TEST_CHECK(mbs[Path_fifoSpan] > mbs[Path_fifoCopy]);
+        printf("| %u | %u | %.0f | %.0f | %.0f | %.0f |\n", setups[i][0], setups[i][1],
+               mbs[Path_fifoCopy], mbs[Path_fifoSpan], mbs[Path_bufferCopy], mbs[Path_bufferSpan]);
+    }
+}
+
+int main(void)
+{
+    _TestCircularBuffer();
+    _TestFifo();
+    _Bench();
+
+    return Host_report("Test_FifoSpan");
+}
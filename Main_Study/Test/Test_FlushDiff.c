@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <string.h>
+#include "Host_Panel.h"
+#include "SSD1306_Gfx.h"
+#include "SSD1306_Font.h"
+
+/* SSD1306_FlushDiff: Only the changed runs reach the bus, and a replayed UI sequence (user-015) */
+
+#define PANEL_ADDR                      0x3D
+#define RANDOM_RUNS                     200
+#define UI_TICKS                        100
+
+static IFX_ALIGN(4) SSD1306_Inst panel;
+static IFX_ALIGN(4) SSD1306_FrameBuffer frame;
+static IFX_ALIGN(4) SSD1306_FrameBuffer ui[UI_TICKS];
+static Host_Panel gddram;
+static uint32 seed = 1;
+
+static uint32 _Random(uint32 range)
+{
+    seed = (seed * 1103515245) + 12345;
+    return (seed >> 16) % range;
+}
+
+/* Windows and data bytes the diff has to send: A gap of up to SSD1306_WINDOW_OVERHEAD columns joins two runs */
+static void _Expect(uint32 *windows, uint32 *bytes)
+{
+    *windows = 0;
+    *bytes = 0;
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        int runStart = -1;
+        int runEnd = 0;
+
+        for (int i = 0; i < SSD1306_MAX_SEG; i++) {
+            if (frame.buff[page][i] == panel.shadow[page][i]) {
+                continue;
+            }
+            if (runStart >= 0 && (i - runEnd) > SSD1306_WINDOW_OVERHEAD) {
+                *bytes += runEnd - runStart;
+                runStart = -1;
+            }
+            if (runStart < 0) {
+                runStart = i;
+                (*windows)++;
+            }
+            runEnd = i + 1;
+        }
+        if (runStart >= 0) {
+            *bytes += runEnd - runStart;
+        }
+    }
+}
+
+static void _TestRandom(void)
+{
+    for (int run = 0; run < RANDOM_RUNS; run++) {
+        const uint32 first = host_i2cStub.transLen;
+        const uint32 dataBytes = gddram.dataBytes;
+        const uint32 changes = 1 + _Random(12);
+        uint32 windows;
+        uint32 bytes;
+
+        /* A few runs of changed columns at random places, some close enough to be joined */
+        for (uint32 i = 0; i < changes; i++) {
+            const uint32 page = _Random(SSD1306_MAX_PAGE);
+            const uint32 column = _Random(SSD1306_MAX_SEG);
+            const uint32 len = 1 + _Random((run % 4 == 0) ? 40 : 4);
+
+            for (uint32 c = column; c < column + len && c < SSD1306_MAX_SEG; c++) {
+                frame.buff[page][c] ^= (uint8)(1 + _Random(255));
+            }
+        }
+        _Expect(&windows, &bytes);
+
+        SSD1306_FlushDiff(&panel, &frame);
+        Host_Panel_update(&gddram);
+        TEST_CHECK(Host_Panel_equals(&gddram, frame.buff, SSD1306_MAX_PAGE));
+        TEST_CHECK(memcmp(panel.shadow, frame.buff, sizeof(panel.shadow)) == 0);
+        /* One window command list and one data transaction per run */
+        TEST_CHECK(host_i2cStub.transLen - first == 2 * windows);
+        TEST_CHECK(gddram.dataBytes - dataBytes == bytes);
+    }
+
+    /* Nothing changed: Nothing is sent */
+    {
+        const uint32 first = host_i2cStub.transLen;
+
+        SSD1306_FlushDiff(&panel, &frame);
+        TEST_CHECK(host_i2cStub.transLen == first);
+    }
+}
+
+static void _TestInvalid(void)
+{
+    const uint32 dataBytes = gddram.dataBytes;
+    uint32 first;
+
+    /* After a scroll the GDDRAM is unknown: The whole frame is sent once, then the diff goes on */
+    SSD1306_StartHorizontalScroll(&panel, 0, 0, SSD1306_MAX_PAGE - 1, 0);
+    SSD1306_StopScroll(&panel);
+    first = host_i2cStub.transLen;
+    SSD1306_FlushDiff(&panel, &frame);
+    Host_Panel_update(&gddram);
+    TEST_CHECK(gddram.dataBytes - dataBytes == SSD1306_MAX_PAGE * SSD1306_MAX_SEG);
+    TEST_CHECK(host_i2cStub.transLen - first == 1 + (SSD1306_MAX_PAGE * SSD1306_MAX_SEG / SSD1306_STREAM_CHUNK));
+    TEST_CHECK(Host_Panel_equals(&gddram, frame.buff, SSD1306_MAX_PAGE));
+
+    first = host_i2cStub.transLen;
+    frame.buff[5][77] ^= 0x10;
+    SSD1306_FlushDiff(&panel, &frame);
+    TEST_CHECK(host_i2cStub.transLen - first == 2);
+}
+
+/* Recorded sequence: The whole UI is redrawn from scratch every tick, as a renderer without dirty tracking would */
+static void _RecordUi(void)
+{
+    for (uint32 tick = 0; tick < UI_TICKS; tick++) {
+        SSD1306_FrameBuffer *pFrame = &ui[tick];
+        const uint32 rpm = 800 + ((tick * 37) % 400);
+        char text[16];
+
+        memset(pFrame->buff, 0, sizeof(pFrame->buff));
+        SSD1306_DrawText(pFrame, &SSD1306_Font8, 0, 0, "ENGINE", 0);
+        snprintf(text, sizeof(text), "%4u", rpm);
+        SSD1306_DrawText(pFrame, &SSD1306_Font16, 2, 0, text, 0);
+        SSD1306_DrawText(pFrame, &SSD1306_Font8, 3, 80, "rpm", 0);
+        SSD1306_DrawRect(pFrame, 0, 40, SSD1306_GFX_WIDTH, 10, SSD1306_Color_WHITE);
+        SSD1306_FillRect(pFrame, 2, 42, (sint16)((rpm - 800) * 124 / 400), 6, SSD1306_Color_WHITE);
+        SSD1306_FillRect(pFrame, (sint16)((tick * 4) % 120), 56, 8, 8, SSD1306_Color_WHITE);     /* Heartbeat */
+    }
+}
+
+typedef struct _Replay {
+    uint32 bytes;
+    uint32 transactions;
+    uint32 ticks;
+} Replay;
+
+static Replay _Replay(boolean bDiff)
+{
+    Replay replay;
+    const uint32 first = host_i2cStub.transLen;
+    const uint32 start = Host_now();
+
+    for (uint32 tick = 0; tick < UI_TICKS; tick++) {
+        memcpy(frame.buff, ui[tick].buff, sizeof(frame.buff));
+        if (bDiff) {
+            SSD1306_FlushDiff(&panel, &frame);
+            Host_Panel_update(&gddram);
+            TEST_CHECK(Host_Panel_equals(&gddram, frame.buff, SSD1306_MAX_PAGE));
+        } else {
+            SSD1306_Blit(&panel, &frame.buff[0][0], SSD1306_MAX_SEG, 0, SSD1306_MAX_PAGE, 0, SSD1306_MAX_SEG);
+        }
+    }
+
+    replay.bytes = Host_I2cStub_wireBytes(first, PANEL_ADDR) / UI_TICKS;
+    replay.transactions = (host_i2cStub.transLen - first) / UI_TICKS;
+    replay.ticks = (Host_now() - start) / UI_TICKS;
+    printf("| %-22s | %5u | %2u | %5.2f ms |\n", bDiff ? "SSD1306_FlushDiff" : "Whole frame (Blit)", replay.bytes,
+           replay.transactions, replay.ticks / (HOST_STM_TICKS_PER_US * 1000.0f));
+
+    return replay;
+}
+
+static void _TestReplay(void)
+{
+    Replay diff;
+    Replay whole;
+
+    _RecordUi();
+    memcpy(frame.buff, ui[0].buff, sizeof(frame.buff));
+    SSD1306_FlushDiff(&panel, &frame);
+
+    printf("UI replay, %u ticks redrawn from scratch, per tick at 1 MHz:\n", UI_TICKS);
+    printf("| Flush                  | Bytes | Tx | Bus      |\n");
+    printf("|------------------------|-------|----|----------|\n");
+    diff = _Replay(TRUE);
+    Host_I2cStub_reset();               /* Room in the log for 100 full frames, they are not decoded */
+    whole = _Replay(FALSE);
+    TEST_CHECK(diff.bytes * 4 < whole.bytes);
+}
+
+int main(void)
+{
+    Host_I2cStub_reset();
+    Host_Panel_init(&gddram, PANEL_ADDR);
+    Init_SSD1306(&panel, &SSD1306_PanelConfig[0]);
+    Host_Panel_update(&gddram);
+    memcpy(frame.buff, panel.shadow, sizeof(frame.buff));
+
+    _TestRandom();
+    _TestInvalid();
+    _TestReplay();
+
+    return Host_report("Test_FlushDiff");
+}
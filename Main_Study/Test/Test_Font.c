@@ -0,0 +1,72 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include "SSD1306_Font.c"       /* Glyph caches are static */
+#include "Host.h"
+
+/* Text drawn on two cores at once: The glyph cache of one core never refills a strip the other copies (user-013) */
+
+#define RUNS                            20000                           /* Per core */
+#define TEXTS                           4
+
+/* 4 x 20 different characters against 16 cache entries: Every line evicts (Font16 lines are clipped at 128 columns) */
+static const char *const texts[TEXTS] = {
+    "ABCDEFGHIJKLMNOPQRST",
+    "abcdefghijklmnopqrst",
+    "0123456789!#$%&()*+-",
+    "UVWXYZuvwxyz<=>?@[]^",
+};
+
+static uint8 expect[2][TEXTS][SSD1306_GLYPH_MAX_PAGES][SSD1306_MAX_SEG];
+static uint32 errors[IFXCPU_NUM_MODULES];
+
+static const SSD1306_Font *_Font(uint32 n)
+{
+    return (n & 1) ? &SSD1306_Font16 : &SSD1306_Font8;
+}
+
+static void *_TextThread(void *arg)
+{
+    const IfxCpu_ResourceCpu core = (IfxCpu_ResourceCpu)(uintptr_t)arg;
+    uint8 line[SSD1306_GLYPH_MAX_PAGES][SSD1306_MAX_SEG];
+
+    Host_setCore(core);
+    for (uint32 n = 0; n < RUNS; n++) {
+        const uint32 font = (n + core) & 1;
+        const uint32 text = (n / 2) % TEXTS;
+
+        memset(line, 0, sizeof(line));
+        SSD1306_RenderText(&line[0][0], SSD1306_MAX_SEG, _Font(font), 0, texts[text], 0);
+        if (memcmp(line, expect[font][text], sizeof(line)) != 0) {
+            errors[core]++;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t thread[2];
+    uint32 use;
+
+    /* Reference lines on CPU0 */
+    for (uint32 font = 0; font < 2; font++) {
+        for (uint32 text = 0; text < TEXTS; text++) {
+            SSD1306_RenderText(&expect[font][text][0][0], SSD1306_MAX_SEG, _Font(font), 0, texts[text], 0);
+        }
+    }
+    use = ssd1306_glyphUse[0];
+    TEST_CHECK(use > 0);
+
+    pthread_create(&thread[0], NULL, _TextThread, (void *)(uintptr_t)IfxCpu_ResourceCpu_1);
+    pthread_create(&thread[1], NULL, _TextThread, (void *)(uintptr_t)IfxCpu_ResourceCpu_2);
+    pthread_join(thread[0], NULL);
+    pthread_join(thread[1], NULL);
+
+    TEST_CHECK(errors[1] == 0 && errors[2] == 0);
+    TEST_CHECK(ssd1306_glyphUse[1] == (RUNS / (2 * TEXTS)) * use && ssd1306_glyphUse[2] == (RUNS / (2 * TEXTS)) * use);
+    TEST_CHECK(ssd1306_glyphUse[0] == use);                             /* CPU0 cache untouched */
+
+    return Host_report("Test_Font");
+}
@@ -0,0 +1,134 @@
+#include <string.h>
+#include "Host_Panel.h"
+
+/* SSD1306_FrameBuffer / SSD1306_Flush: Only the dirty spans reach the bus (user-001) */
+
+#define PANEL_ADDR                      0x3D
+
+static IFX_ALIGN(4) SSD1306_Inst panel;
+static SSD1306_FrameBuffer frame;
+static Host_Panel gddram;
+
+static boolean _IsClean(const SSD1306_FrameBuffer *pFrame)
+{
+    for (int i = 0; i < SSD1306_MAX_PAGE; i++) {
+        if (pFrame->dirtyStart[i] < pFrame->dirtyEnd[i]) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/* Flush and check the panel, return the bytes on the wire */
+static uint32 _Flush(const char *pattern)
+{
+    const uint32 first = host_i2cStub.transLen;
+    const uint32 txBytes = panel.stats.txBytes;
+    uint32 wire;
+
+    SSD1306_Flush(&panel, &frame);
+    Host_Panel_update(&gddram);
+    wire = Host_I2cStub_wireBytes(first, PANEL_ADDR);
+
+    TEST_CHECK(_IsClean(&frame));
+    TEST_CHECK(Host_Panel_equals(&gddram, frame.buff, SSD1306_MAX_PAGE));
+    TEST_CHECK(memcmp(panel.shadow, frame.buff, sizeof(frame.buff)) == 0);
+    printf("| %-26s | %5u | %5u | %3u |\n", pattern, wire, panel.stats.txBytes - txBytes, host_i2cStub.transLen - first);
+
+    return wire;
+}
+
+static void _TestSetPixel(void)
+{
+    SSD1306_InitFrame(&frame);
+    for (int i = 0; i < SSD1306_MAX_PAGE; i++) {
+        frame.dirtyStart[i] = SSD1306_MAX_SEG;
+        frame.dirtyEnd[i] = 0;
+    }
+
+    /* Unchanged pixel: Nothing dirty */
+    SSD1306_SetPixel(&frame, 10, 10, 0);
+    TEST_CHECK(_IsClean(&frame));
+
+    SSD1306_SetPixel(&frame, 10, 10, 1);
+    TEST_CHECK(frame.buff[1][10] == 0x04);
+    TEST_CHECK(frame.dirtyStart[1] == 10 && frame.dirtyEnd[1] == 11);
+    SSD1306_SetPixel(&frame, 20, 9, 1);
+    TEST_CHECK(frame.dirtyStart[1] == 10 && frame.dirtyEnd[1] == 21);
+    SSD1306_SetPixel(&frame, 10, 10, 0);
+    TEST_CHECK(frame.buff[1][10] == 0x00);
+    TEST_CHECK(frame.dirtyStart[1] == 10 && frame.dirtyEnd[1] == 21);
+
+    /* Outside the panel */
+    SSD1306_SetPixel(&frame, SSD1306_MAX_SEG, 0, 1);
+    SSD1306_SetPixel(&frame, 0, SSD1306_MAX_PAGE * 8, 1);
+    SSD1306_MarkDirty(&frame, 7, 120, 20);
+    TEST_CHECK(frame.dirtyStart[7] == 120 && frame.dirtyEnd[7] == SSD1306_MAX_SEG);
+    SSD1306_MarkDirty(&frame, SSD1306_MAX_PAGE, 0, 1);
+    SSD1306_MarkDirty(&frame, 0, 0, 0);
+    TEST_CHECK(frame.dirtyStart[0] >= frame.dirtyEnd[0]);
+}
+
+static void _TestFlush(void)
+{
+    printf("| Update                     | Wire  | Stats | Tx  |\n");
+    printf("|----------------------------|-------|-------|-----|\n");
+
+    /* Whole frame: Window + 4 chunks of 256 data bytes with their own address and control byte */
+    SSD1306_InitFrame(&frame);
+    TEST_CHECK(_Flush("Full frame") == (1 + 7) + (4 * (1 + 1 + 256)));
+
+    /* Nothing dirty: Nothing on the bus */
+    TEST_CHECK(_Flush("Nothing dirty") == 0);
+
+    SSD1306_SetPixel(&frame, 64, 32, 1);
+    TEST_CHECK(_Flush("One pixel") == (1 + 7) + (1 + 1 + 1));
+
+    for (int x = 0; x < 8; x++) {
+        for (int y = 0; y < 8; y++) {
+            SSD1306_SetPixel(&frame, 100 + x, 16 + y, (x + y) & 1);
+        }
+    }
+    TEST_CHECK(_Flush("8x8 icon in one page") == (1 + 7) + (1 + 1 + 8));
+
+    for (int x = 0; x < 8; x++) {
+        for (int y = 0; y < 8; y++) {
+            SSD1306_SetPixel(&frame, 40 + x, 4 + y, 1);
+        }
+    }
+    TEST_CHECK(_Flush("8x8 icon over two pages") == (1 + 7) + (1 + 1 + 16));
+
+    for (int x = 0; x < SSD1306_MAX_SEG; x++) {
+        SSD1306_SetPixel(&frame, x, 56, 1);
+    }
+    TEST_CHECK(_Flush("Text line (page 7)") == (1 + 7) + (1 + 1 + SSD1306_MAX_SEG));
+
+    /* Far apart in different pages: Two windows instead of one 128 column window */
+    SSD1306_SetPixel(&frame, 0, 0, 1);
+    SSD1306_SetPixel(&frame, 127, 63, 1);
+    TEST_CHECK(_Flush("Two pixels, corners") == 2 * ((1 + 7) + (1 + 1 + 1)));
+
+    /* Same column in the next page: One window of two pages */
+    SSD1306_SetPixel(&frame, 5, 24, 1);
+    SSD1306_SetPixel(&frame, 5, 32, 1);
+    TEST_CHECK(_Flush("Two pixels, stacked") == (1 + 7) + (1 + 1 + 2));
+}
+
+int main(void)
+{
+    Host_I2cStub_reset();
+    Host_Panel_init(&gddram, PANEL_ADDR);
+    Init_SSD1306(&panel, &SSD1306_PanelConfig[0]);
+    Host_Panel_update(&gddram);
+
+    /* Init: Command table, cleared GDDRAM and then the test image */
+    TEST_CHECK(gddram.bOn == TRUE);
+    TEST_CHECK(gddram.mode == SSD1306_ADDRESSING_HORIZONTAL);
+    TEST_CHECK(Host_Panel_equals(&gddram, panel.shadow, SSD1306_MAX_PAGE));
+
+    _TestSetPixel();
+    _TestFlush();
+
+    return Host_report("Test_FrameBuffer");
+}
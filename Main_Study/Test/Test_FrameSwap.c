@@ -0,0 +1,163 @@
+#include <pthread.h>
+#include <string.h>
+#include "Host_Panel.h"
+
+/* Double buffer handoff: A CPU1 thread renders, the CPU0 thread flushes, no frame is torn (user-014) */
+
+#define PANEL_ADDR                      0x3D
+#define FRAMES                          100                             /* 2 x 100 full frames fit in HOST_I2CSTUB_BYTES */
+
+static IFX_ALIGN(4) SSD1306_Inst panel;
+static Host_Panel gddram;
+static volatile boolean bRenderDone;
+static uint32 posted;
+static uint32 refused;
+
+/* Every byte of frame n is n: A frame mixed from two renders is never uniform */
+static void _Render(uint8 n)
+{
+    SSD1306_FrameBuffer *back = SSD1306_GetBackFrame(&panel);
+
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        memset(back->buff[page], n, SSD1306_MAX_SEG);
+        Host_yield();                   /* Let the flush run in the middle of a render */
+    }
+}
+
+static void *_SwapThread(void *arg)
+{
+    (void)arg;
+    Host_setCore(IfxCpu_ResourceCpu_1);
+    for (uint32 n = 1; n <= FRAMES; n++) {
+        _Render((uint8)n);
+        SSD1306_SwapFrame(&panel);
+    }
+    bRenderDone = TRUE;
+    return NULL;
+}
+
+static void *_PostThread(void *arg)
+{
+    boolean bPosted = FALSE;
+
+    (void)arg;
+    Host_setCore(IfxCpu_ResourceCpu_1);
+    for (uint32 n = 1; n <= FRAMES; n++) {
+        _Render((uint8)n);
+        bPosted = SSD1306_PostFrame(&panel);
+        if (bPosted) {
+            posted++;
+        } else {
+            refused++;
+        }
+    }
+    /* The last frame has to reach the panel */
+    while (bPosted == FALSE) {
+        Host_yield();
+        bPosted = SSD1306_PostFrame(&panel);
+        if (bPosted) {
+            posted++;
+        } else {
+            refused++;
+        }
+    }
+    bRenderDone = TRUE;
+    return NULL;
+}
+
+/* Uniform GDDRAM: The frame shown, 0 if it is torn */
+static uint8 _Shown(void)
+{
+    Host_Panel_update(&gddram);
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        for (int i = 0; i < SSD1306_MAX_SEG; i++) {
+            if (gddram.gddram[page][i] != gddram.gddram[0][0]) {
+                return 0;
+            }
+        }
+    }
+
+    return gddram.gddram[0][0];
+}
+
+/* SSD1306_SwapFrame / SSD1306_FlushFrame: Every frame is shown, in order */
+static void _TestSwap(void)
+{
+    pthread_t render;
+    uint32 frames = 0;
+    uint8 last = 0;
+
+    bRenderDone = FALSE;
+    pthread_create(&render, NULL, _SwapThread, NULL);
+    while (bRenderDone == FALSE || panel.frontState != SSD1306_Front_IDLE) {
+        if (SSD1306_FlushFrame(&panel)) {
+            const uint8 shown = _Shown();
+
+            TEST_CHECK(shown == last + 1);
+            last = shown;
+            frames++;
+        } else {
+            Host_yield();
+        }
+    }
+    pthread_join(render, NULL);
+
+    TEST_CHECK(frames == FRAMES && last == FRAMES);
+    TEST_CHECK(panel.stats.frames == FRAMES && panel.stats.merged == 0);
+    printf("SwapFrame: %u frames rendered, %u flushed\n", FRAMES, frames);
+}
+
+/* SSD1306_PostFrame / SSD1306_FlushStep on the deferred stub: Frames posted while one is on the bus are merged or refused */
+static void _TestPost(void)
+{
+    pthread_t render;
+    uint32 frames = 0;
+    uint8 last = 0;
+    uint8 lastOnBus = 0;
+
+    SSD1306_ResetStats(&panel);
+    posted = 0;
+    refused = 0;
+    host_i2cStub.bDeferred = TRUE;
+    bRenderDone = FALSE;
+    pthread_create(&render, NULL, _PostThread, NULL);
+    while (bRenderDone == FALSE || panel.frontState != SSD1306_Front_IDLE) {
+        SSD1306_StartFrame(&panel);
+        if (SSD1306_FlushStep(&panel)) {
+            const uint8 shown = _Shown();
+
+            TEST_CHECK(shown > last);
+            last = shown;
+            frames++;
+        } else {
+            Host_I2cStub_next();
+            Host_yield();               /* One transaction per turn of the render thread */
+        }
+        if (panel.frontState == SSD1306_Front_FLUSHING) {
+            lastOnBus = panel.frames[panel.backIndex ^ 1].buff[0][0];
+        }
+    }
+    pthread_join(render, NULL);
+    while (Host_I2cStub_next());
+    host_i2cStub.bDeferred = FALSE;
+
+    TEST_CHECK(last == FRAMES && lastOnBus == FRAMES);
+    TEST_CHECK(panel.stats.frames == frames);
+    TEST_CHECK(panel.stats.frames + panel.stats.merged == posted);
+    TEST_CHECK(panel.stats.refused == refused);
+    printf("PostFrame: %u frames rendered, %u posted (%u merged), %u refused while flushing, %u flushed\n",
+           FRAMES, posted, panel.stats.merged, refused, frames);
+}
+
+int main(void)
+{
+    Host_I2cStub_reset();
+    Host_Panel_init(&gddram, PANEL_ADDR);
+    Init_SSD1306(&panel, &SSD1306_PanelConfig[0]);
+    SSD1306_ResetStats(&panel);
+
+    _TestSwap();
+    _TestPost();
+
+    return Host_report("Test_FrameSwap");
+}
@@ -0,0 +1,389 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "SSD1306_Gfx.h"
+#include "Host.h"
+
+/* SSD1306_Gfx primitives against per-pixel references, their dirty marks and their cost (user-012) */
+
+#define W                               SSD1306_GFX_WIDTH
+#define H                               SSD1306_GFX_HEIGHT
+#define RANDOM_RUNS                     400
+#define BENCH_LOOPS                     2000
+
+static SSD1306_FrameBuffer frame;
+static SSD1306_FrameBuffer before;
+static uint8 ref[H][W];                 /* One byte per pixel */
+static uint32 seed = 1;
+
+static sint16 _Random(sint16 min, sint16 max)
+{
+    seed = (seed * 1103515245) + 12345;
+    return (sint16)(min + (sint16)((seed >> 16) % (uint32)(max - min + 1)));
+}
+
+static void _RefPixel(sint16 x, sint16 y, SSD1306_Color color)
+{
+    if (x < 0 || y < 0 || x >= W || y >= H) {
+        return;
+    }
+    ref[y][x] = (color == SSD1306_Color_INVERT) ? (ref[y][x] ^ 1) : (uint8)color;
+}
+
+static void _RefRect(sint16 x0, sint16 y0, sint16 x1, sint16 y1, SSD1306_Color color)
+{
+    for (sint16 y = y0; y <= y1; y++) {
+        for (sint16 x = x0; x <= x1; x++) {
+            _RefPixel(x, y, color);
+        }
+    }
+}
+
+static void _RefLine(sint16 x0, sint16 y0, sint16 x1, sint16 y1, SSD1306_Color color)
+{
+    const int dx = abs(x1 - x0);
+    const int dy = -abs(y1 - y0);
+    int err = dx + dy;
+
+    while (1) {
+        const int e2 = 2 * err;
+
+        _RefPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        if (e2 >= dy) {
+            err += dy;
+            x0 += (x0 < x1) ? 1 : -1;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += (y0 < y1) ? 1 : -1;
+        }
+    }
+}
+
+/* Midpoint circle: Outline pixels, or the column between each pair of them */
+static void _RefCircle(sint16 xc, sint16 yc, sint16 r, SSD1306_Color color, boolean bFill)
+{
+    sint16 x = r;
+    sint16 y = 0;
+    sint16 err = 1 - r;
+
+    while (x >= y) {
+        if (bFill) {
+            _RefRect(xc + y, yc - x, xc + y, yc + x, color);
+            _RefRect(xc - y, yc - x, xc - y, yc + x, color);
+            _RefRect(xc + x, yc - y, xc + x, yc + y, color);
+            _RefRect(xc - x, yc - y, xc - x, yc + y, color);
+        } else {
+            const sint16 pts[8][2] = {{x, y}, {-x, y}, {x, -y}, {-x, -y}, {y, x}, {-y, x}, {y, -x}, {-y, -x}};
+
+            for (int i = 0; i < 8; i++) {
+                _RefPixel(xc + pts[i][0], yc + pts[i][1], color);
+            }
+        }
+        y++;
+        if (err < 0) {
+            err += (2 * y) + 1;
+        } else {
+            x--;
+            err += (2 * (y - x)) + 1;
+        }
+    }
+}
+
+static void _RefSprite(const SSD1306_Sprite *sprite, sint16 x, sint16 y, SSD1306_Color color)
+{
+    for (sint16 r = 0; r < sprite->height; r++) {
+        for (sint16 c = 0; c < sprite->width; c++) {
+            if ((sprite->data[((r / 8) * sprite->width) + c] >> (r % 8)) & 0x01) {
+                _RefPixel(x + c, y + r, color);
+            }
+        }
+    }
+}
+
+/* Random background in both, all pages clean */
+static void _Begin(void)
+{
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            ref[y][x] = (uint8)(_Random(0, 3) == 0);
+        }
+    }
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        for (int x = 0; x < W; x++) {
+            uint8 value = 0;
+
+            for (int bit = 0; bit < 8; bit++) {
+                value |= ref[(page * 8) + bit][x] << bit;
+            }
+            frame.buff[page][x] = value;
+        }
+        frame.dirtyStart[page] = 0;
+        frame.dirtyEnd[page] = 0;
+    }
+    before = frame;
+}
+
+static boolean _Equals(void)
+{
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            if (((frame.buff[y / 8][x] >> (y % 8)) & 0x01) != ref[y][x]) {
+                printf("pixel %d, %d differs\n", x, y);
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+/* Every changed column is in the dirty span of its page, nothing is marked outside of the clipped box */
+static boolean _DirtyCovers(sint16 x0, sint16 y0, sint16 x1, sint16 y1)
+{
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        const boolean bInBox = (page >= y0 / 8 && page <= y1 / 8) ? TRUE : FALSE;
+
+        for (int x = 0; x < W; x++) {
+            if (frame.buff[page][x] != before.buff[page][x] && (x < frame.dirtyStart[page] || x >= frame.dirtyEnd[page])) {
+                return FALSE;
+            }
+        }
+        if (frame.dirtyStart[page] < frame.dirtyEnd[page] &&
+            (!bInBox || frame.dirtyStart[page] < x0 || frame.dirtyEnd[page] > x1 + 1)) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+static sint16 _Clip(sint16 value, sint16 max)
+{
+    return (value < 0) ? 0 : ((value > max) ? max : value);
+}
+
+static void _TestRects(void)
+{
+    for (int run = 0; run < RANDOM_RUNS; run++) {
+        const SSD1306_Color color = (SSD1306_Color)_Random(0, 2);
+        const sint16 x = _Random(-20, W + 4);
+        const sint16 y = _Random(-20, H + 4);
+        const sint16 w = _Random(-2, W);
+        const sint16 h = _Random(-2, H);
+
+        _Begin();
+        SSD1306_FillRect(&frame, x, y, w, h, color);
+        if (w > 0 && h > 0) {
+            _RefRect(x, y, x + w - 1, y + h - 1, color);
+        }
+        TEST_CHECK(_Equals());
+        TEST_CHECK(_DirtyCovers(_Clip(x, W - 1), _Clip(y, H - 1), _Clip(x + w - 1, W - 1), _Clip(y + h - 1, H - 1)));
+
+        /* Exactly the clipped columns of the touched pages */
+        if (w > 0 && h > 0 && x < W && y < H && x + w > 0 && y + h > 0) {
+            TEST_CHECK(frame.dirtyStart[_Clip(y, H - 1) / 8] == _Clip(x, W - 1));
+            TEST_CHECK(frame.dirtyEnd[_Clip(y + h - 1, H - 1) / 8] == _Clip(x + w - 1, W - 1) + 1);
+        }
+
+        _Begin();
+        SSD1306_DrawRect(&frame, x, y, w, h, color);
+        if (w > 0 && h > 0) {
+            _RefRect(x, y, x + w - 1, y, color);
+            if (h > 1) _RefRect(x, y + h - 1, x + w - 1, y + h - 1, color);
+            if (h > 2) _RefRect(x, y + 1, x, y + h - 2, color);
+            if (h > 2 && w > 1) _RefRect(x + w - 1, y + 1, x + w - 1, y + h - 2, color);
+        }
+        TEST_CHECK(_Equals());
+        TEST_CHECK(_DirtyCovers(_Clip(x, W - 1), _Clip(y, H - 1), _Clip(x + w - 1, W - 1), _Clip(y + h - 1, H - 1)));
+    }
+
+    /* Spans: Whole bytes per page */
+    _Begin();
+    SSD1306_DrawHLine(&frame, -5, 9, 40, SSD1306_Color_WHITE);
+    SSD1306_DrawVLine(&frame, 100, 3, 58, SSD1306_Color_INVERT);
+    SSD1306_DrawPixel(&frame, 127, 63, SSD1306_Color_BLACK);
+    SSD1306_DrawPixel(&frame, 128, 10, SSD1306_Color_WHITE);
+    _RefRect(-5, 9, 34, 9, SSD1306_Color_WHITE);
+    _RefRect(100, 3, 100, 60, SSD1306_Color_INVERT);
+    _RefPixel(127, 63, SSD1306_Color_BLACK);
+    TEST_CHECK(_Equals());
+    TEST_CHECK(frame.dirtyStart[1] == 0 && frame.dirtyEnd[1] == 101);
+    TEST_CHECK(frame.dirtyStart[0] == 100 && frame.dirtyEnd[0] == 101);
+}
+
+static void _TestLines(void)
+{
+    for (int run = 0; run < RANDOM_RUNS; run++) {
+        const SSD1306_Color color = (SSD1306_Color)_Random(0, 2);
+        sint16 x0 = _Random(-30, W + 30);
+        sint16 y0 = _Random(-30, H + 30);
+        sint16 x1 = _Random(-30, W + 30);
+        sint16 y1 = _Random(-30, H + 30);
+
+        if (run % 8 == 0) y1 = y0;      /* Horizontal / vertical ones go to the spans */
+        if (run % 8 == 1) x1 = x0;
+
+        _Begin();
+        SSD1306_DrawLine(&frame, x0, y0, x1, y1, color);
+        _RefLine(x0, y0, x1, y1, color);
+        TEST_CHECK(_Equals());
+        TEST_CHECK(_DirtyCovers(_Clip((x0 < x1) ? x0 : x1, W - 1), _Clip((y0 < y1) ? y0 : y1, H - 1),
+                                _Clip((x0 < x1) ? x1 : x0, W - 1), _Clip((y0 < y1) ? y1 : y0, H - 1)));
+    }
+}
+
+/* Ends far outside: dx, dy and 2 * err over the sint16 range */
+static void _TestLongLines(void)
+{
+    static const sint16 lines[6][4] = {
+        {-32768, -32768, 32767, 32767},
+        {32767, -32768, -32768, 32767},
+        {-32768, 10, 32767, 40},
+        {-20000, 63, 300, -5},
+        {5, -32768, 120, 32767},
+        {-32768, -32768, -1, 32767},                                    /* Does not touch the panel */
+    };
+
+    for (int i = 0; i < 6; i++) {
+        const sint16 *l = lines[i];
+
+        _Begin();
+        SSD1306_DrawLine(&frame, l[0], l[1], l[2], l[3], SSD1306_Color_INVERT);
+        _RefLine(l[0], l[1], l[2], l[3], SSD1306_Color_INVERT);
+        TEST_CHECK(_Equals());
+    }
+}
+
+static void _TestCircles(void)
+{
+    for (int run = 0; run < RANDOM_RUNS; run++) {
+        const sint16 xc = _Random(-10, W + 10);
+        const sint16 yc = _Random(-10, H + 10);
+        const sint16 r = _Random(0, 40);
+        const SSD1306_Color color = (SSD1306_Color)_Random(0, 2);
+        const SSD1306_Color fill = (SSD1306_Color)_Random(0, 1);
+        const sint16 x0 = _Clip(xc - r, W - 1);
+        const sint16 y0 = _Clip(yc - r, H - 1);
+        const sint16 x1 = _Clip(xc + r, W - 1);
+        const sint16 y1 = _Clip(yc + r, H - 1);
+
+        _Begin();
+        SSD1306_DrawCircle(&frame, xc, yc, r, color);
+        _RefCircle(xc, yc, r, color, FALSE);
+        TEST_CHECK(_Equals());
+        TEST_CHECK(_DirtyCovers(x0, y0, x1, y1));
+
+        _Begin();
+        SSD1306_FillCircle(&frame, xc, yc, r, fill);
+        _RefCircle(xc, yc, r, fill, TRUE);
+        TEST_CHECK(_Equals());
+        TEST_CHECK(_DirtyCovers(x0, y0, x1, y1));
+    }
+
+    /* The fill covers the outline */
+    memset(&frame, 0, sizeof(frame));
+    SSD1306_DrawCircle(&frame, 64, 32, 20, SSD1306_Color_WHITE);
+    before = frame;
+    SSD1306_FillCircle(&frame, 64, 32, 20, SSD1306_Color_WHITE);
+    for (int page = 0; page < SSD1306_MAX_PAGE; page++) {
+        for (int x = 0; x < W; x++) {
+            TEST_CHECK((before.buff[page][x] & ~frame.buff[page][x]) == 0);
+        }
+    }
+}
+
+static void _TestSprites(void)
+{
+    static uint8 data[3 * 24];
+    SSD1306_Sprite sprite = {.data = data};
+
+    for (int run = 0; run < RANDOM_RUNS; run++) {
+        const SSD1306_Color color = (SSD1306_Color)_Random(0, 2);
+        sint16 x;
+        sint16 y;
+
+        sprite.width = (uint8)_Random(1, 24);
+        sprite.height = (uint8)_Random(1, 24);
+        for (uint32 i = 0; i < sizeof(data); i++) {
+            data[i] = (uint8)_Random(0, 255);
+        }
+        x = _Random(-sprite.width - 2, W + 2);
+        y = _Random(-sprite.height - 2, H + 2);
+
+        _Begin();
+        SSD1306_BlitSprite(&frame, &sprite, x, y, color);
+        _RefSprite(&sprite, x, y, color);
+        TEST_CHECK(_Equals());
+        TEST_CHECK(_DirtyCovers(_Clip(x, W - 1), _Clip(y, H - 1), _Clip(x + sprite.width - 1, W - 1),
+                                _Clip(y + sprite.height - 1, H - 1)));
+    }
+}
+
+static double _Seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+/* Host time only: Each primitive against the same pixels drawn with SSD1306_SetPixel */
+static void _Bench(void)
+{
+    double start;
+    double gfx;
+    double pixel;
+
+    printf("| Primitive (host)       | Gfx        | SetPixel loop | x    |\n");
+    printf("|------------------------|------------|---------------|------|\n");
+
+    for (int shape = 0; shape < 3; shape++) {
+        static const char *const names[3] = {"FillRect 128 x 64", "FillRect 100 x 20", "HLine 128 x 64 rows"};
+
+        start = _Seconds();
+        for (int i = 0; i < BENCH_LOOPS; i++) {
+            const SSD1306_Color color = (SSD1306_Color)(i & 1);
+
+            if (shape == 0) {
+                SSD1306_FillRect(&frame, 0, 0, W, H, color);
+            } else if (shape == 1) {
+                SSD1306_FillRect(&frame, 14, 13, 100, 20, color);
+            } else {
+                for (int y = 0; y < H; y++) SSD1306_DrawHLine(&frame, 0, y, W, color);
+            }
+        }
+        gfx = (_Seconds() - start) / BENCH_LOOPS;
+
+        start = _Seconds();
+        for (int i = 0; i < BENCH_LOOPS; i++) {
+            const sint16 x0 = (shape == 1) ? 14 : 0;
+            const sint16 y0 = (shape == 1) ? 13 : 0;
+            const sint16 w = (shape == 1) ? 100 : W;
+            const sint16 h = (shape == 1) ? 20 : H;
+
+            for (sint16 y = y0; y < y0 + h; y++) {
+                for (sint16 x = x0; x < x0 + w; x++) SSD1306_SetPixel(&frame, (uint8)x, (uint8)y, (uint8)(i & 1));
+            }
+        }
+        pixel = (_Seconds() - start) / BENCH_LOOPS;
+
+        TEST_CHECK(gfx < pixel);
+        printf("| %-22s | %7.2f us | %10.2f us | %4.0f |\n", names[shape], gfx * 1e6, pixel * 1e6, pixel / gfx);
+    }
+}
+
+int main(void)
+{
+    _TestRects();
+    _TestLines();
+    _TestLongLines();
+    _TestCircles();
+    _TestSprites();
+    _Bench();
+
+    return Host_report("Test_Gfx");
+}
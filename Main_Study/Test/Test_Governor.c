@@ -0,0 +1,232 @@
+#include <string.h>
+#include "SSD1306_Governor.c"   /* ssd1306_governor is static: One governor per simulation */
+#include "Host_Panel.h"
+
+/* Frame governor: Posts merged into one frame per period, refused and dropped counts, the STM0 setup (user-020) */
+
+#define SIM_MS                          2000
+
+static IFX_ALIGN(4) SSD1306_Inst panels[2];            /* 128x64, 128x32 */
+static Host_Panel gddram[2];
+static SSD1306_Governor gov;
+static uint32 seed = 1;
+
+static uint32 _Random(uint32 range)
+{
+    seed = (seed * 1103515245) + 12345;
+    return (seed >> 16) % range;
+}
+
+static void _FrameIsr(void)
+{
+    const uint32 ccpn = Host_setPriority(ISR_PRIORITY_SSD1306_FRAME);
+
+    SSD1306_FrameIsr();
+    Host_setPriority(ccpn);
+}
+
+/* The panel shows what was posted last */
+static boolean _Shown(int i)
+{
+    Host_Panel_update(&gddram[i]);
+    return Host_Panel_equals(&gddram[i], panels[i].frames[panels[i].backIndex ^ 1].buff, panels[i].pageLen);
+}
+
+static void _Draw(int i, uint8 value)
+{
+    SSD1306_FrameBuffer *back = SSD1306_GetBackFrame(&panels[i]);
+
+    back->buff[_Random(panels[i].pageLen)][_Random(SSD1306_MAX_SEG)] = value;
+}
+
+/* Run the flush loop until the bus is idle, no period tick in between */
+static void _Drain(void)
+{
+    do {
+        SSD1306_RunGovernor(&gov);
+    } while (Host_I2cStub_next());
+    SSD1306_RunGovernor(&gov);
+}
+
+static void _Init(uint32 periodUs)
+{
+    Host_I2cStub_reset();
+    for (int i = 0; i < 2; i++) {
+        Host_Panel_init(&gddram[i], SSD1306_PanelConfig[i].i2c.addr);
+        Init_SSD1306(&panels[i], &SSD1306_PanelConfig[i]);
+    }
+    host_i2cStub.bDeferred = TRUE;
+    ssd1306_governor = NULL_PTR;
+    Init_SSD1306_Governor(&gov, panels, 2, periodUs);
+}
+
+/* Comparator 1 of the I2C retry keeps its setup, comparator 0 ticks every period */
+static void _TestStm(void)
+{
+    const uint32 asserts = host_assertCount;
+    SSD1306_Governor second;
+
+    TEST_CHECK(MODULE_STM0.ICR.B.CMP0EN == 1 && MODULE_STM0.ICR.B.CMP0OS == 0);
+    TEST_CHECK(MODULE_STM0.ICR.B.CMP1EN == 1 && MODULE_STM0.ICR.B.CMP1OS == 1);
+    TEST_CHECK(Host_interruptsEnabled());
+    TEST_CHECK(gov.periodTicks == SSD1306_FRAME_PERIOD_US * HOST_STM_TICKS_PER_US);
+    TEST_CHECK(Host_stmRemain(IfxStm_Comparator_0) == gov.periodTicks);
+
+    Host_advance(gov.periodTicks);
+    TEST_CHECK(Host_stmDue(IfxStm_Comparator_0));
+    _FrameIsr();
+    TEST_CHECK(gov.period == 1 && Host_stmRemain(IfxStm_Comparator_0) == gov.periodTicks);
+
+    if (Host_expectAssert() == 0) {
+        Init_SSD1306_Governor(&second, panels, 2, SSD1306_FRAME_PERIOD_US);
+    }
+    TEST_CHECK(host_assertCount == asserts + 1);
+}
+
+/* Posts between two ticks are one frame, a post into the flushing frame is refused, a busy panel drops the tick */
+static void _TestCounting(void)
+{
+    SSD1306_GovernorStats stats;
+
+    SSD1306_RunGovernor(&gov);                                              /* Tick of _TestStm, nothing posted */
+    SSD1306_ResetGovernorStats(&gov);
+
+    /* 3 posts before the tick: 2 merged, only the last one is flushed */
+    for (int n = 0; n < 3; n++) {
+        _Draw(0, 0x11);
+        TEST_CHECK(SSD1306_PostFrame(&panels[0]));
+    }
+    _Drain();
+    TEST_CHECK(panels[0].frontState == SSD1306_Front_POSTED && panels[0].stats.frames == 0);
+    _FrameIsr();
+    TEST_CHECK(SSD1306_RunGovernor(&gov) == FALSE);
+    TEST_CHECK(panels[0].frontState == SSD1306_Front_FLUSHING);
+    TEST_CHECK(panels[1].frontState == SSD1306_Front_IDLE);                 /* Nothing posted */
+
+    /* Flushing: Refused, the draw stays in the back frame */
+    _Draw(0, 0x22);
+    TEST_CHECK(SSD1306_PostFrame(&panels[0]) == FALSE);
+
+    /* Tick while the frame is still on the bus: Dropped */
+    _FrameIsr();
+    SSD1306_RunGovernor(&gov);
+    TEST_CHECK(panels[0].stats.dropped == 1);
+    _Drain();
+    TEST_CHECK(panels[0].frontState == SSD1306_Front_IDLE && panels[0].stats.frames == 1);
+    TEST_CHECK(_Shown(0));
+
+    /* The refused draw goes with the next post, both panels in the same period */
+    TEST_CHECK(SSD1306_PostFrame(&panels[0]));
+    _Draw(1, 0x33);
+    TEST_CHECK(SSD1306_PostFrame(&panels[1]));
+    _FrameIsr();
+    _Drain();
+    TEST_CHECK(_Shown(0) && _Shown(1));
+
+    /* Missed ticks are not made up: 3 periods, one frame */
+    _Draw(1, 0x44);
+    TEST_CHECK(SSD1306_PostFrame(&panels[1]));
+    _FrameIsr();
+    _FrameIsr();
+    _FrameIsr();
+    _Drain();
+    TEST_CHECK(_Shown(1));
+
+    SSD1306_GetGovernorStats(&gov, &stats);
+    TEST_CHECK(stats.frames == 4 && stats.merged == 2 && stats.refused == 1 && stats.dropped == 1);
+    TEST_CHECK(panels[1].stats.frames == 2);
+}
+
+typedef struct _Result {
+    uint32 posts;
+    uint32 frames;
+    uint32 merged;
+    uint32 refused;
+    uint32 dropped;
+    uint32 busyTicks;
+} Result;
+
+/* Draw on both panels every drawUs and post, ticks every periodUs, the bus at 1 MHz: Event by event for SIM_MS */
+static Result _Simulate(uint32 drawUs, uint32 periodUs)
+{
+    const uint32 drawTicks = drawUs * HOST_STM_TICKS_PER_US;
+    const uint32 end = Host_now() + (SIM_MS * 1000 * HOST_STM_TICKS_PER_US);
+    uint32 nextDraw = Host_now() + drawTicks;
+    uint32 busyStart;
+    Result result = {0};
+
+    _Init(periodUs);
+    busyStart = host_i2cStub.busyTicks;
+    while ((sint32)(Host_now() - end) < 0) {
+        uint32 next = nextDraw;
+
+        if ((sint32)(Host_now() + Host_stmRemain(IfxStm_Comparator_0) - next) < 0) {
+            next = Host_now() + Host_stmRemain(IfxStm_Comparator_0);
+        }
+        if (host_i2cStub.queueLen > 0 && (sint32)(host_i2cStub.queue[host_i2cStub.queueHead].endTick - next) < 0) {
+            next = host_i2cStub.queue[host_i2cStub.queueHead].endTick;
+        }
+        if ((sint32)(next - Host_now()) > 0) {
+            Host_advance(next - Host_now());
+        }
+        Host_I2cStub_run();
+
+        if (Host_stmDue(IfxStm_Comparator_0)) {
+            _FrameIsr();
+        }
+        if ((sint32)(Host_now() - nextDraw) >= 0) {
+            for (int i = 0; i < 2; i++) {
+                for (int n = 0; n < 4; n++) {
+                    _Draw(i, (uint8)_Random(256));
+                }
+                SSD1306_PostFrame(&panels[i]);
+            }
+            result.posts += 2;
+            nextDraw += drawTicks;
+        }
+        SSD1306_RunGovernor(&gov);
+    }
+
+    for (int i = 0; i < 2; i++) {
+        result.frames += panels[i].stats.frames;
+        result.merged += panels[i].stats.merged;
+        result.refused += panels[i].stats.refused;
+        result.dropped += panels[i].stats.dropped;
+    }
+    result.busyTicks = host_i2cStub.busyTicks - busyStart;
+    return result;
+}
+
+/* Bus time only: The CPU time of the diff and the loop is not in the host numbers */
+static void _TestRates(void)
+{
+    static const uint32 setups[3][2] = {{5000, 20000}, {100, 20000}, {20, 5000}};
+
+    printf("| Draw interval | Period | Posts | fps (both panels) | Merged + refused | Dropped | Bus |\n");
+    printf("| - | - | - | - | - | - | - |\n");
+    for (int i = 0; i < 3; i++) {
+        const Result r = _Simulate(setups[i][0], setups[i][1]);
+        const uint32 periods = (SIM_MS * 1000) / setups[i][1];
+
+        /* At most one frame per panel per period, every post is a frame, merged or refused */
+        TEST_CHECK(r.frames <= 2 * periods);
+        TEST_CHECK(r.frames + r.merged + r.refused <= r.posts && r.frames + r.merged + r.refused + 2 >= r.posts);
+        printf("| %u us | %u ms | %u | %.1f | %u | %u | %.0f%% |\n", setups[i][0], setups[i][1] / 1000, r.posts,
+               r.frames * 1000.0f / SIM_MS, r.merged + r.refused, r.dropped,
+               r.busyTicks * 100.0f / (SIM_MS * 1000.0f * HOST_STM_TICKS_PER_US));
+    }
+}
+
+int main(void)
+{
+    /* Comparator 1 as the I2C retry backoff leaves it, before the governor is set up */
+    MODULE_STM0.ICR.B.CMP1OS = 1;
+    MODULE_STM0.ICR.B.CMP1EN = 1;
+    _Init(SSD1306_FRAME_PERIOD_US);
+
+    _TestStm();
+    _TestCounting();
+    _TestRates();
+
+    return Host_report("Test_Governor");
+}
@@ -0,0 +1,139 @@
+#include <string.h>
+#include "Host_I2cPoll.h"
+
+/* High-speed session: Master code once, repeated STARTs with MCE set, one STOP, F/S setup again afterwards (user-022) */
+
+#define SENSOR_ADDR                     0x48
+#define READ_LEN                        40                      /* More than the 32 bytes IfxI2c_I2c_read locks for */
+
+static const Module_I2C_Config sensorConfig = {
+    .p_i2c = &MODULE_I2C0,
+    .MCP_PINS = {
+        .scl = &IfxI2c0_SCL_P13_1_INOUT,
+        .sda = &IfxI2c0_SDA_P13_2_INOUT,
+        .padDriver = IfxPort_PadDriver_ttlSpeed1
+    },
+    .baudrate = 400000,
+    .hsBaudrate = 3400000,
+    .addr = SENSOR_ADDR,
+    .retry = {.maxAttempts = 1},
+    .priority = Module_I2C_Priority_NORMAL
+};
+static Module_I2C_Inst sensor;
+static uint8 regWrite[3] = {0x10, 0x55, 0x66};
+static uint8 block[READ_LEN + 1];                               /* Register 0x20 + 40 bytes */
+static uint8 rx[2][READ_LEN];
+
+/* F/S setup of Init_I2C */
+static struct {
+    uint32 addrcfg;
+    uint32 fdivcfg;
+    uint32 timcfg;
+} fs;
+
+static void _Start(void)
+{
+    Host_I2cPoll_start(sensorConfig.baudrate);
+    for (uint32 i = 0; i < sizeof(host_i2cPoll.readData); i++) {
+        host_i2cPoll.readData[i] = (uint8)((i * 13) + 1);
+    }
+}
+
+static boolean _FastMode(void)
+{
+    return (MODULE_I2C0.ADDRCFG.U == fs.addrcfg && MODULE_I2C0.ADDRCFG.B.MCE == 0 &&
+            MODULE_I2C0.FDIVCFG.U == fs.fdivcfg && MODULE_I2C0.TIMCFG.U == fs.timcfg) ? TRUE : FALSE;
+}
+
+/* Bytes on the bus from *pos on: Address byte, then len bytes */
+static boolean _Packet(uint32 *pos, uint8 addrByte, const uint8 *data, uint32 len)
+{
+    const uint8 *bus = &host_i2cPoll.bytes[*pos];
+    const boolean bOk = (*pos + 1 + len <= host_i2cPoll.bytesLen && bus[0] == addrByte &&
+                         memcmp(&bus[1], data, len) == 0) ? TRUE : FALSE;
+
+    *pos += 1 + len;
+    return bOk;
+}
+
+static void _TestSession(void)
+{
+    const Module_I2C_Transaction trans[4] = {
+        {.dir = Module_I2C_Dir_WRITE, .data = regWrite, .size = sizeof(regWrite)},
+        {.dir = Module_I2C_Dir_READ, .data = rx[0], .size = 6},
+        {.dir = Module_I2C_Dir_WRITE, .data = block, .size = sizeof(block)},
+        {.dir = Module_I2C_Dir_READ, .data = rx[1], .size = READ_LEN},
+    };
+    /* One FIFO word per section: Master code, address + data per write, address + data per read */
+    const uint32 words = 1 + 1 + (1 + 2) + 11 + (1 + 10);
+    uint32 pos = 1;
+
+    for (uint32 i = 0; i < sizeof(block); i++) {
+        block[i] = (uint8)(0x20 + (i * 3));
+    }
+    _Start();
+    TEST_CHECK(I2c_runHighSpeed(&sensor, trans, 4) == IfxI2c_I2c_Status_ok);
+    Host_I2cPoll_stop();
+
+    TEST_CHECK(host_i2cPoll.masterCodes == 1 && host_i2cPoll.bytes[0] == IFXI2C_HIGHSPEED_MASTER_CODE);
+    TEST_CHECK(host_i2cPoll.packets == 5 && host_i2cPoll.hsPackets == 5);
+    TEST_CHECK(host_i2cPoll.stops == 1 && MODULE_I2C0.BUSSTAT.B.BS == IfxI2c_BusStatus_idle);
+
+    /* Bytes in order, the reads get what the slave sent */
+    TEST_CHECK(_Packet(&pos, SENSOR_ADDR << 1, regWrite, sizeof(regWrite)));
+    TEST_CHECK(_Packet(&pos, (SENSOR_ADDR << 1) | 1, rx[0], 6));
+    TEST_CHECK(_Packet(&pos, SENSOR_ADDR << 1, block, sizeof(block)));
+    TEST_CHECK(_Packet(&pos, (SENSOR_ADDR << 1) | 1, rx[1], READ_LEN));
+    TEST_CHECK(pos == host_i2cPoll.bytesLen);
+    TEST_CHECK(memcmp(rx[0], host_i2cPoll.readData, 6) == 0 && memcmp(rx[1], &host_i2cPoll.readData[6], READ_LEN) == 0);
+
+    TEST_CHECK(host_i2cPoll.words == words && host_i2cPoll.lockSections == words);
+    TEST_CHECK(host_i2cPoll.maxLockWords == 1 && Host_interruptsEnabled());
+    TEST_CHECK(_FastMode() && sensor.bus->state == Module_I2C_State_IDLE);
+    TEST_CHECK(sensor.counters.failures == 0);
+}
+
+/* After the STOP: The next transfer has no master code and MCE clear */
+static void _TestFastAfter(void)
+{
+    _Start();
+    TEST_CHECK(I2c_write(&sensor, regWrite, sizeof(regWrite)) == IfxI2c_I2c_Status_ok);
+    while (MODULE_I2C0.BUSSTAT.B.BS != IfxI2c_BusStatus_idle);                 /* STOP on the bus, no retries */
+    TEST_CHECK(I2c_read(&sensor, rx[0], READ_LEN) == IfxI2c_I2c_Status_ok);
+    Host_I2cPoll_stop();
+
+    TEST_CHECK(host_i2cPoll.packets == 2 && host_i2cPoll.hsPackets == 0 && host_i2cPoll.masterCodes == 0);
+    TEST_CHECK(host_i2cPoll.stops == 2 && host_i2cPoll.bytes[0] == (SENSOR_ADDR << 1));
+    TEST_CHECK(memcmp(rx[0], host_i2cPoll.readData, READ_LEN) == 0);
+    TEST_CHECK(host_i2cPoll.maxLockWords == 1);                                 /* Blocking read polled as well */
+}
+
+/* Another master on the bus: No master code, no STOP into its transfer */
+static void _TestBusNotFree(void)
+{
+    const Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_WRITE, .data = regWrite, .size = sizeof(regWrite)};
+
+    _Start();
+    MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_remoteSlave;
+    TEST_CHECK(I2c_runHighSpeed(&sensor, &trans, 1) == IfxI2c_I2c_Status_busNotFree);
+    Host_I2cPoll_stop();
+
+    TEST_CHECK(host_i2cPoll.words == 0 && host_i2cPoll.masterCodes == 0);
+    TEST_CHECK(host_i2cPoll.stops == 0 && MODULE_I2C0.BUSSTAT.B.BS == IfxI2c_BusStatus_remoteSlave);
+    TEST_CHECK(_FastMode() && sensor.counters.failures == 1);
+}
+
+int main(void)
+{
+    Init_I2C(&sensor, &sensorConfig);
+    fs.addrcfg = MODULE_I2C0.ADDRCFG.U;
+    fs.fdivcfg = MODULE_I2C0.FDIVCFG.U;
+    fs.timcfg = MODULE_I2C0.TIMCFG.U;
+    TEST_CHECK(sensor.bus->bHighSpeed);
+
+    _TestSession();
+    _TestFastAfter();
+    _TestBusNotFree();
+
+    return Host_report("Test_HighSpeed");
+}
@@ -0,0 +1,206 @@
+#include <stdint.h>
+#include <string.h>
+#include "Host_I2cModel.h"
+#include "ASW/ASW_CONFIG.h"
+
+/* DMA writes: TXD fed by the linked list, the borrowed bytes in front of the payload put back, CPU work per KB (user-006) */
+
+#define PANEL_ADDR                      0x3C
+#define GUARD                           0xA5                                            /* data[0] of the caller */
+#define FRAME_LEN                       (MODULE_I2C_DMA_HEADROOM + MODULE_I2C_DMA_MAX_SIZE)
+
+static const Module_I2C_Config panelConfig = {
+    .p_i2c = &MODULE_I2C0,
+    .MCP_PINS = {
+        .scl = &IfxI2c0_SCL_P13_1_INOUT,
+        .sda = &IfxI2c0_SDA_P13_2_INOUT,
+        .padDriver = IfxPort_PadDriver_ttlSpeed1
+    },
+    .baudrate = 1000000,
+    .addr = PANEL_ADDR,
+    .retry = {.maxAttempts = 1},
+    .priority = Module_I2C_Priority_NORMAL
+};
+static Module_I2C_Inst panel;
+static Host_I2cSlave *slave;
+static IFX_ALIGN(4) uint8 frame[FRAME_LEN];
+static uint8 copy[FRAME_LEN];
+
+static struct {
+    IfxI2c_I2c_Status status;
+    uint32 count;
+} done;
+
+static void _Done(IfxI2c_I2c_Status status, void *arg)
+{
+    (void)arg;
+    done.status = status;
+    done.count++;
+}
+
+/* Fresh bus and counters for each write, the bytes of every test fit into host_i2cModel.bytes */
+static void _Reset(void)
+{
+    Host_I2cModel_init(panelConfig.baudrate);
+    slave = Host_I2cModel_addSlave(PANEL_ADDR);
+    done.count = 0;
+    for (uint32 i = 0; i < FRAME_LEN; i++) {
+        frame[i] = (uint8)((i * 29) + 7);
+    }
+    frame[0] = GUARD;
+    memcpy(copy, frame, FRAME_LEN);
+}
+
+static IfxI2c_I2c_Status _Write(volatile uint8 *data, Ifx_SizeT size, boolean bDma, Ifx_SizeT chunkSize)
+{
+    const Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_WRITE, .data = data, .size = size, .callback = _Done,
+                                          .bDma = bDma, .chunkSize = chunkSize};
+
+    TEST_CHECK(I2c_submit(&panel, &trans));
+    Host_I2cModel_run();
+    TEST_CHECK(done.count == 1 && I2c_isBusBusy(&panel) == FALSE);
+
+    return done.status;
+}
+
+/* Packet n carries len bytes, from the caller's data */
+static boolean _OnBus(uint32 n, const uint8 *data, uint32 len)
+{
+    const Host_I2cPacket *packet = &host_i2cModel.packet[n];
+
+    return (n < host_i2cModel.packetLen && packet->addr == PANEL_ADDR && packet->bRead == FALSE && packet->len == len &&
+            memcmp(&host_i2cModel.bytes[packet->offset], data, len) == 0) ? TRUE : FALSE;
+}
+
+/* Interrupt routing back to the CPU, the caller's buffer as it was */
+static boolean _Restored(void)
+{
+    const volatile Ifx_SRC_SRCR *src = IfxI2c_getDtrSrcPointer(&MODULE_I2C0);
+
+    return (panel.bus->bDmaActive == FALSE && panel.bus->borrowed == NULL_PTR && src->B.TOS == panel.bus->tos &&
+            src->B.SRPN == ISR_PRIORITY_I2C0_DTR && memcmp(frame, copy, FRAME_LEN) == 0) ? TRUE : FALSE;
+}
+
+/* Entry i moves MODULE_I2C_DMA_CHUNK_WORDS words from the next KB of the buffer, the last one ends the list */
+static boolean _Chain(uint32 words)
+{
+    const Ifx_DMA_CH *list = panel.bus->dma.list;
+    const uint32 entries = (words + MODULE_I2C_DMA_CHUNK_WORDS - 1) / MODULE_I2C_DMA_CHUNK_WORDS;
+    boolean bOk = TRUE;
+
+    for (uint32 i = 0; i < entries; i++) {
+        const uint32 trel = (i + 1 < entries) ? MODULE_I2C_DMA_CHUNK_WORDS : words - (i * MODULE_I2C_DMA_CHUNK_WORDS);
+        const boolean bLast = (i + 1 == entries) ? TRUE : FALSE;
+
+        bOk &= (list[i].CHCFGR.B.TREL == trel && list[i].DADR.U == (uint32)(uintptr_t)&MODULE_I2C0.TXD.U);
+        bOk &= (list[i].SADR.U == (uint32)(uintptr_t)&frame[i * MODULE_I2C_DMA_CHUNK_WORDS * 4]);
+        bOk &= (list[i].ADICR.B.SHCT == (bLast ? IfxDma_ChannelShadow_none : IfxDma_ChannelShadow_linkedList));
+        bOk &= (bLast || list[i].SHADR.U == panel.bus->dma.listAddress + ((i + 1) * sizeof(Ifx_DMA_CH)));
+    }
+
+    return bOk;
+}
+
+/* Address byte in frame[0] for the DMA: Up to one entry, just over one, the whole list */
+static void _TestChain(void)
+{
+    static const uint32 sizes[4] = {16, 1023, 1024, MODULE_I2C_DMA_MAX_SIZE - 1};
+
+    for (int i = 0; i < 4; i++) {
+        const uint32 words = (sizes[i] + 1 + 3) / 4;
+
+        _Reset();
+        TEST_CHECK(_Write(frame, sizes[i], TRUE, 0) == IfxI2c_I2c_Status_ok);
+        TEST_CHECK(host_i2cModel.packetLen == 1 && _OnBus(0, &copy[1], sizes[i]));
+        TEST_CHECK(_Restored());
+        TEST_CHECK(_Chain(words));
+
+        /* No word from the CPU: TX_END of the packet and of the STOP only */
+        TEST_CHECK(host_i2cModel.dmaMoves == words && host_i2cModel.dtrIsrs == 0);
+        TEST_CHECK(host_i2cModel.dmaLoads == (words - 1) / MODULE_I2C_DMA_CHUNK_WORDS);
+        TEST_CHECK(host_i2cModel.protocolIsrs == 2);
+    }
+}
+
+/* SSD1306 frame data: Header frame[1] in front of every chunk, the two bytes in front of each chunk are borrowed */
+static void _TestChunks(void)
+{
+    const uint32 size = 1 + 1024;
+
+    _Reset();
+    frame[1] = 0x40;
+    copy[1] = 0x40;
+    TEST_CHECK(_Write(frame, size, TRUE, 256) == IfxI2c_I2c_Status_ok);
+    TEST_CHECK(host_i2cModel.packetLen == 4);
+    for (uint32 n = 0; n < 4; n++) {
+        uint8 chunk[1 + 256];
+
+        chunk[0] = 0x40;
+        memcpy(&chunk[1], &copy[2 + (n * 256)], 256);
+        TEST_CHECK(_OnBus(n, chunk, sizeof(chunk)));
+    }
+    TEST_CHECK(_Restored());
+    TEST_CHECK(host_i2cModel.dtrIsrs == 0 && host_i2cModel.dmaMoves == 4 * ((2 + 256 + 3) / 4));
+}
+
+/* Longer than the list: DTR interrupt, frame[0] is not touched */
+static void _TestOversize(void)
+{
+    const uint32 size = MODULE_I2C_DMA_MAX_SIZE;
+
+    _Reset();
+    TEST_CHECK(_Write(frame, size, TRUE, 0) == IfxI2c_I2c_Status_ok);
+    TEST_CHECK(_OnBus(0, &copy[1], size));
+    TEST_CHECK(_Restored());
+    TEST_CHECK(host_i2cModel.dmaMoves == 0 && host_i2cModel.dtrIsrs == (size + 1 + 3) / 4);
+}
+
+/* NAK on the address byte: The borrowed byte is put back before the callback, the channel is reset for the next write */
+static void _TestNak(void)
+{
+    _Reset();
+    slave->nakCount = 1;
+    TEST_CHECK(_Write(frame, 64, TRUE, 0) == IfxI2c_I2c_Status_nak);
+    TEST_CHECK(host_i2cModel.packetLen == 1 && host_i2cModel.packet[0].bNak);
+    TEST_CHECK(_Restored());
+    TEST_CHECK(host_i2cModel.dmaMoves == 1 && host_i2cModel.dtrIsrs == 0 && host_i2cModel.dmaResets == 1);
+
+    done.count = 0;
+    TEST_CHECK(_Write(frame, 2000, TRUE, 0) == IfxI2c_I2c_Status_ok);
+    TEST_CHECK(_OnBus(1, &copy[1], 2000) && _Restored());
+    TEST_CHECK(host_i2cModel.dmaMoves == 1 + ((2000 + 1 + 3) / 4) && host_i2cModel.dmaResets == 1);
+}
+
+/* 1 KB: Every FIFO word is an interrupt on the CPU, or a move of the DMA */
+static void _TestCpuCost(void)
+{
+    printf("| TXD feed (1 KB) | DTR interrupts | Protocol interrupts | DMA moves | Linked list entries |\n");
+    printf("| - | - | - | - | - |\n");
+    for (int i = 0; i < 2; i++) {
+        const boolean bDma = (i == 1) ? TRUE : FALSE;
+
+        _Reset();
+        TEST_CHECK(_Write(bDma ? frame : &frame[1], 1024, bDma, 0) == IfxI2c_I2c_Status_ok);
+        TEST_CHECK(_OnBus(0, &copy[1], 1024));
+        TEST_CHECK(host_i2cModel.dtrIsrs + host_i2cModel.dmaMoves == (1024 + 1 + 3) / 4);
+        printf("| %s | %u | %u | %u | %u |\n", bDma ? "DMA linked list" : "DTR interrupt", host_i2cModel.dtrIsrs,
+               host_i2cModel.protocolIsrs, host_i2cModel.dmaMoves, bDma ? host_i2cModel.dmaLoads + 1 : 0);
+    }
+}
+
+int main(void)
+{
+    Host_I2cModel_init(panelConfig.baudrate);
+    Init_I2C(&panel, &panelConfig);
+    Init_I2C_Async(&panel);
+    Init_I2C_Dma(&panel, DMA_CHANNEL_I2C0_TX);
+    TEST_CHECK(panel.bus->dma.bEnabled);
+
+    _TestChain();
+    _TestChunks();
+    _TestOversize();
+    _TestNak();
+    _TestCpuCost();
+
+    return Host_report("Test_I2cDma");
+}
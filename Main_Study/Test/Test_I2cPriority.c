@@ -0,0 +1,180 @@
+#include <stdint.h>
+#include <string.h>
+#include "Host_I2cModel.h"
+
+/* Priority queues, starvation limit and chunked writes on a shared I2C0 (user-008) */
+
+#define SENSOR_ADDR                     0x48
+#define PANEL_ADDR                      0x3C
+#define FRAME_SIZE                      1024
+
+#define TEST_I2C_CONFIG(address, prio) {                                                \
+    .p_i2c = &MODULE_I2C0,                                                              \
+    .MCP_PINS = {                                                                       \
+        .scl = &IfxI2c0_SCL_P13_1_INOUT,                                                \
+        .sda = &IfxI2c0_SDA_P13_2_INOUT,                                                \
+        .padDriver = IfxPort_PadDriver_ttlSpeed1                                        \
+    },                                                                                  \
+    .baudrate = 1000000,                                                                \
+    .addr = (address),                                                                  \
+    .retry = {.maxAttempts = 1},                                                        \
+    .priority = (prio)                                                                  \
+}
+
+static const Module_I2C_Config sensorConfig = TEST_I2C_CONFIG(SENSOR_ADDR, Module_I2C_Priority_HIGH);
+static const Module_I2C_Config panelConfig = TEST_I2C_CONFIG(PANEL_ADDR, Module_I2C_Priority_LOW);
+static Module_I2C_Inst sensor;
+static Module_I2C_Inst panel;
+static uint8 frame[1 + FRAME_SIZE];
+
+/* Callback order, arg = 'H' / 'L' * 256 + number */
+static struct {
+    uintptr_t arg[32];
+    uint32 tick[32];
+    uint32 len;
+} done;
+
+static void _Done(IfxI2c_I2c_Status status, void *arg)
+{
+    TEST_CHECK(status == IfxI2c_I2c_Status_ok);
+    if (done.len < 32) {
+        done.arg[done.len] = (uintptr_t)arg;
+        done.tick[done.len] = Host_now();
+    }
+    done.len++;
+}
+
+static void _Submit(Module_I2C_Inst *inst, char tag, uint32 n)
+{
+    static uint8 data[2] = {0x00, 0x00};
+    Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_WRITE, .data = data, .size = 2, .callback = _Done,
+                                    .arg = (void *)(uintptr_t)((tag << 8) | n)};
+
+    TEST_CHECK(I2c_submit(inst, &trans));
+}
+
+static boolean _Order(const char *expect)
+{
+    for (uint32 i = 0; expect[i * 2] != '\0'; i++) {
+        if (i >= done.len || done.arg[i] != (uintptr_t)((expect[i * 2] << 8) | (expect[(i * 2) + 1] - '0'))) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+static void _TestPriority(void)
+{
+    /* L0 is on the bus already, the HIGH ones go before L1 */
+    done.len = 0;
+    _Submit(&panel, 'L', 0);
+    _Submit(&panel, 'L', 1);
+    _Submit(&sensor, 'H', 0);
+    _Submit(&sensor, 'H', 1);
+    Host_I2cModel_run();
+    TEST_CHECK(done.len == 4);
+    TEST_CHECK(_Order("L0H0H1L1"));
+}
+
+static void _TestStarvation(void)
+{
+    /* H0 starts alone, then a waiting LOW gets the bus after MODULE_I2C_STARVE_LIMIT HIGH ones */
+    done.len = 0;
+    _Submit(&sensor, 'H', 0);
+    _Submit(&panel, 'L', 0);
+    _Submit(&panel, 'L', 1);
+    for (int i = 1; i < MODULE_I2C_QUEUE_LEN; i++) {
+        _Submit(&sensor, 'H', i);
+    }
+    Host_I2cModel_run();
+    TEST_CHECK(done.len == MODULE_I2C_QUEUE_LEN + 2);
+    TEST_CHECK(MODULE_I2C_STARVE_LIMIT == 4);
+    TEST_CHECK(_Order("H0H1H2H3H4L0H5H6H7L1"));
+}
+
+/* A sensor read submitted right after a 1 KB frame write started, return its latency in ticks */
+static uint32 _ReadDuringFrame(Ifx_SizeT chunkSize)
+{
+    static uint8 reg[1] = {0x00};
+    static uint8 rx[2];
+    Module_I2C_Transaction write = {.dir = Module_I2C_Dir_WRITE, .data = frame, .size = sizeof(frame), .callback = _Done,
+                                    .arg = (void *)(uintptr_t)('L' << 8), .chunkSize = chunkSize};
+    Module_I2C_Transaction read = {.dir = Module_I2C_Dir_WRITE_READ, .data = reg, .size = 1, .rxData = rx, .rxSize = 2,
+                                   .callback = _Done, .arg = (void *)(uintptr_t)('H' << 8)};
+    const uint32 packets = host_i2cModel.packetLen;
+    uint32 start;
+
+    done.len = 0;
+    TEST_CHECK(I2c_submit(&panel, &write));
+    start = Host_now();
+    TEST_CHECK(I2c_submit(&sensor, &read));
+    Host_I2cModel_run();
+    TEST_CHECK(done.len == 2);
+    TEST_CHECK(_Order((chunkSize > 0) ? "H0L0" : "L0H0"));
+
+    if (chunkSize > 0) {
+        /* First chunk, the sensor (write + read), then the other chunks: Each chunk has the header in front */
+        TEST_CHECK(host_i2cModel.packetLen - packets == 2 + (FRAME_SIZE / chunkSize));
+        TEST_CHECK(host_i2cModel.packet[packets].addr == PANEL_ADDR && host_i2cModel.packet[packets].len == 1 + chunkSize);
+        TEST_CHECK(host_i2cModel.packet[packets + 1].addr == SENSOR_ADDR && host_i2cModel.packet[packets + 2].bRead);
+        for (uint32 i = packets + 3; i < host_i2cModel.packetLen; i++) {
+            TEST_CHECK(host_i2cModel.packet[i].addr == PANEL_ADDR && host_i2cModel.packet[i].len == 1 + chunkSize);
+            TEST_CHECK(host_i2cModel.bytes[host_i2cModel.packet[i].offset] == frame[0]);
+        }
+    } else {
+        TEST_CHECK(host_i2cModel.packetLen - packets == 3);
+        TEST_CHECK(host_i2cModel.packet[packets].len == sizeof(frame));
+    }
+
+    return done.tick[(chunkSize > 0) ? 0 : 1] - start;
+}
+
+static void _TestChunks(void)
+{
+    Module_I2C_Latency latency;
+    uint32 chunked;
+    uint32 whole;
+    uint32 edge;
+    int bin;
+
+    frame[0] = 0x40;
+    for (int i = 1; i < (int)sizeof(frame); i++) {
+        frame[i] = (uint8)i;
+    }
+
+    I2c_resetLatency(&sensor);
+    chunked = _ReadDuringFrame(256);
+    I2c_getLatency(&sensor, &latency);
+
+    /* Bin i holds latencies below base * 2^i */
+    edge = MODULE_I2C_LATENCY_BASE_US * HOST_STM_TICKS_PER_US;
+    for (bin = 0; bin < MODULE_I2C_LATENCY_BINS - 1 && chunked >= edge; bin++) {
+        edge <<= 1;
+    }
+    TEST_CHECK(latency.bins[bin] == 1);
+    TEST_CHECK(latency.maxTicks == chunked);
+
+    whole = _ReadDuringFrame(0);
+    TEST_CHECK(chunked < whole / 3);
+
+    printf("Sensor read behind a 1 KB frame at 1 MHz: %.2f ms with 256 B chunks (bin %d), %.2f ms in one transaction\n",
+           chunked / (HOST_STM_TICKS_PER_US * 1000.0f), bin, whole / (HOST_STM_TICKS_PER_US * 1000.0f));
+}
+
+int main(void)
+{
+    Host_I2cModel_init(sensorConfig.baudrate);
+    Host_I2cModel_addSlave(SENSOR_ADDR);
+    Host_I2cModel_addSlave(PANEL_ADDR);
+
+    Init_I2C(&sensor, &sensorConfig);
+    Init_I2C(&panel, &panelConfig);
+    Init_I2C_Async(&panel);
+
+    _TestPriority();
+    _TestStarvation();
+    _TestChunks();
+
+    return Host_report("Test_I2cPriority");
+}
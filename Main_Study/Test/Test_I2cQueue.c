@@ -0,0 +1,286 @@
+#include <stdint.h>
+#include <string.h>
+#include "Host_I2cModel.h"
+#include "ASW/ASW_CONFIG.h"
+
+/* Module_I2C transaction queue on the I2C0 register model (user-005) */
+
+#define SENSOR_ADDR                     0x48
+#define ABSENT_ADDR                     0x50
+
+#define TEST_I2C_CONFIG(address) {                                                      \
+    .p_i2c = &MODULE_I2C0,                                                              \
+    .MCP_PINS = {                                                                       \
+        .scl = &IfxI2c0_SCL_P13_1_INOUT,                                                \
+        .sda = &IfxI2c0_SDA_P13_2_INOUT,                                                \
+        .padDriver = IfxPort_PadDriver_ttlSpeed1                                        \
+    },                                                                                  \
+    .baudrate = 400000,                                                                 \
+    .addr = (address),                                                                  \
+    .retry = {.maxAttempts = 1},                                                        \
+    .priority = Module_I2C_Priority_NORMAL                                              \
+}
+
+static const Module_I2C_Config sensorConfig = TEST_I2C_CONFIG(SENSOR_ADDR);
+static const Module_I2C_Config absentConfig = TEST_I2C_CONFIG(ABSENT_ADDR);
+static Module_I2C_Inst sensor;
+static Module_I2C_Inst absent;
+static Host_I2cSlave *slave;
+
+/* Callbacks in the order they ran */
+static struct {
+    uintptr_t arg[64];
+    IfxI2c_I2c_Status status[64];
+    uint32 len;
+} done;
+
+static void _Done(IfxI2c_I2c_Status status, void *arg)
+{
+    if (done.len < 64) {
+        done.arg[done.len] = (uintptr_t)arg;
+        done.status[done.len] = status;
+    }
+    done.len++;
+}
+
+static Module_I2C_Transaction _Write(volatile uint8 *data, Ifx_SizeT size, uintptr_t arg)
+{
+    Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_WRITE, .data = data, .size = size, .callback = _Done, .arg = (void *)arg};
+
+    return trans;
+}
+
+static void _TestSubmit(void)
+{
+    uint8 a[3] = {0x10, 0xA1, 0xA2};
+    uint8 b[9] = {0x20, 1, 2, 3, 4, 5, 6, 7, 8};
+    uint8 c[1] = {0x30};
+    Module_I2C_Transaction trans;
+    const uint32 start = Host_now();
+    const uint32 packets = host_i2cModel.packetLen;
+
+    done.len = 0;
+    trans = _Write(a, sizeof(a), 1);
+    TEST_CHECK(I2c_submit(&sensor, &trans));
+    trans = _Write(b, sizeof(b), 2);
+    TEST_CHECK(I2c_submit(&sensor, &trans));
+    trans = _Write(c, sizeof(c), 3);
+    TEST_CHECK(I2c_submit(&sensor, &trans));
+
+    /* Returned without waiting for the bus */
+    TEST_CHECK(Host_now() == start);
+    TEST_CHECK(done.len == 0);
+    TEST_CHECK(I2c_isBusBusy(&sensor));
+    TEST_CHECK(I2c_isBusBusy(&absent));
+
+    Host_I2cModel_run();
+    TEST_CHECK(I2c_isBusBusy(&sensor) == FALSE);
+    TEST_CHECK(done.len == 3);
+    TEST_CHECK(done.arg[0] == 1 && done.arg[1] == 2 && done.arg[2] == 3);
+    TEST_CHECK(done.status[0] == IfxI2c_I2c_Status_ok && done.status[1] == IfxI2c_I2c_Status_ok && done.status[2] == IfxI2c_I2c_Status_ok);
+
+    /* One packet per transaction in submit order, each ended by a STOP */
+    TEST_CHECK(host_i2cModel.packetLen - packets == 3);
+    TEST_CHECK(host_i2cModel.packet[packets].len == sizeof(a) && host_i2cModel.packet[packets + 1].len == sizeof(b));
+    TEST_CHECK(host_i2cModel.packet[packets + 1].startTick ==
+               host_i2cModel.packet[packets].startTick + ((1 + sizeof(a)) * host_i2cModel.byteTicks) + (host_i2cModel.byteTicks / 9));
+    TEST_CHECK(slave->regs[0x10] == 0xA1 && slave->regs[0x11] == 0xA2);
+    TEST_CHECK(memcmp(&slave->regs[0x20], &b[1], 8) == 0);
+    TEST_CHECK(slave->reg == 0x30);
+    TEST_CHECK(Host_now() - start == ((3 + sizeof(a) + sizeof(b) + sizeof(c)) * host_i2cModel.byteTicks) + (3 * (host_i2cModel.byteTicks / 9)));
+}
+
+static void _TestQueueFull(void)
+{
+    static uint8 data[MODULE_I2C_QUEUE_LEN + 1][2];
+    Module_I2C_Transaction trans;
+
+    done.len = 0;
+    for (int i = 0; i < MODULE_I2C_QUEUE_LEN; i++) {
+        data[i][0] = 0x40 + i;
+        data[i][1] = i;
+        trans = _Write(data[i], 2, i);
+        TEST_CHECK(I2c_submit(&sensor, &trans));
+    }
+
+    /* The active entry holds its slot until it is finished */
+    trans = _Write(data[MODULE_I2C_QUEUE_LEN], 2, MODULE_I2C_QUEUE_LEN);
+    TEST_CHECK(I2c_submit(&sensor, &trans) == FALSE);
+    TEST_CHECK(Host_I2cModel_step());
+    TEST_CHECK(Host_I2cModel_step());
+    TEST_CHECK(done.len == 1);
+    TEST_CHECK(I2c_submit(&sensor, &trans));
+
+    Host_I2cModel_run();
+    TEST_CHECK(done.len == MODULE_I2C_QUEUE_LEN + 1);
+    for (uint32 i = 0; i < done.len; i++) {
+        TEST_CHECK(done.arg[i] == i);
+    }
+}
+
+static void _TestRead(void)
+{
+    uint8 reg[1] = {0x80};
+    uint8 rx[7] = {0};
+    Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_READ, .data = rx, .size = 5, .callback = _Done, .arg = (void *)1};
+    uint32 packets;
+
+    for (int i = 0; i < 16; i++) {
+        slave->regs[0x80 + i] = 0xC0 + i;
+    }
+
+    /* Register pointer set by a write, then read: Two transactions with a STOP in between */
+    done.len = 0;
+    TEST_CHECK(I2c_submit(&sensor, &(Module_I2C_Transaction){.dir = Module_I2C_Dir_WRITE, .data = reg, .size = 1}));
+    TEST_CHECK(I2c_submit(&sensor, &trans));
+    Host_I2cModel_run();
+    TEST_CHECK(done.len == 1 && done.status[0] == IfxI2c_I2c_Status_ok);
+    TEST_CHECK(rx[0] == 0xC0 && rx[4] == 0xC4 && rx[5] == 0);
+
+    /* Repeated START: The read packet starts where the write packet ends */
+    packets = host_i2cModel.packetLen;
+    memset(rx, 0, sizeof(rx));
+    reg[0] = 0x83;
+    trans.dir = Module_I2C_Dir_WRITE_READ;
+    trans.data = reg;
+    trans.size = 1;
+    trans.rxData = rx;
+    trans.rxSize = 7;
+    trans.arg = (void *)2;
+    TEST_CHECK(I2c_submit(&sensor, &trans));
+    Host_I2cModel_run();
+    TEST_CHECK(done.len == 2 && done.arg[1] == 2 && done.status[1] == IfxI2c_I2c_Status_ok);
+    TEST_CHECK(host_i2cModel.packetLen - packets == 2);
+    TEST_CHECK(host_i2cModel.packet[packets].bRead == FALSE && host_i2cModel.packet[packets + 1].bRead == TRUE);
+    TEST_CHECK(host_i2cModel.packet[packets + 1].startTick == host_i2cModel.packet[packets].startTick + (2 * host_i2cModel.byteTicks));
+    for (int i = 0; i < 7; i++) {
+        TEST_CHECK(rx[i] == 0xC3 + i);
+    }
+}
+
+/* Next transaction submitted from the callback of the last one */
+static uint8 chain[4][2];
+static uint32 chainCcpn;
+
+static void _Chain(IfxI2c_I2c_Status status, void *arg)
+{
+    const uintptr_t n = (uintptr_t)arg;
+
+    chainCcpn = __mfcr(CPU_ICR) & 0xFFu;
+    _Done(status, arg);
+    if (n + 1 < 4) {
+        Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_WRITE, .data = chain[n + 1], .size = 2, .callback = _Chain, .arg = (void *)(n + 1)};
+
+        TEST_CHECK(I2c_submit(&sensor, &trans));
+    }
+}
+
+static void _TestChain(void)
+{
+    Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_WRITE, .data = chain[0], .size = 2, .callback = _Chain, .arg = (void *)0};
+
+    for (int i = 0; i < 4; i++) {
+        chain[i][0] = 0x60 + i;
+        chain[i][1] = 0x70 + i;
+    }
+
+    done.len = 0;
+    TEST_CHECK(I2c_submit(&sensor, &trans));
+    Host_I2cModel_run();
+    TEST_CHECK(done.len == 4);
+    TEST_CHECK(done.arg[3] == 3);
+    TEST_CHECK(slave->regs[0x60] == 0x70 && slave->regs[0x63] == 0x73);
+    TEST_CHECK(I2c_isBusBusy(&sensor) == FALSE);
+    TEST_CHECK(chainCcpn == ISR_PRIORITY_I2C0_P);                       /* Callbacks run in the protocol ISR */
+}
+
+static void _TestBlockingInIsr(void)
+{
+    uint8 data[2] = {0x00, 0x55};
+    const uint32 asserts = host_assertCount;
+    const uint32 packets = host_i2cModel.packetLen;
+    IfxI2c_I2c_Status status = IfxI2c_I2c_Status_ok;
+
+    /* As from a callback: The protocol interrupt that would end the wait can not come */
+    Host_setPriority(ISR_PRIORITY_I2C0_P);
+    if (Host_expectAssert() == 0) {
+        status = I2c_write(&sensor, data, sizeof(data));
+    }
+    Host_setPriority(0);
+    TEST_CHECK(host_assertCount == asserts + 1);
+    TEST_CHECK(status == IfxI2c_I2c_Status_ok);                         /* Left by the assert */
+    TEST_CHECK(I2c_isBusBusy(&sensor) == FALSE);
+    TEST_CHECK(Host_I2cModel_run() == 0 && host_i2cModel.packetLen == packets);
+}
+
+static void _TestNak(void)
+{
+    uint8 data[2] = {0x00, 0x55};
+    Module_I2C_Transaction trans = _Write(data, 2, 1);
+    Module_I2C_Counters counters;
+
+    /* maxAttempts = 1: The NAK ends the transaction, the next one goes on */
+    done.len = 0;
+    TEST_CHECK(I2c_submit(&absent, &trans));
+    trans.arg = (void *)2;
+    TEST_CHECK(I2c_submit(&sensor, &trans));
+    Host_I2cModel_run();
+    TEST_CHECK(done.len == 2);
+    TEST_CHECK(done.status[0] == IfxI2c_I2c_Status_nak && done.status[1] == IfxI2c_I2c_Status_ok);
+    I2c_getCounters(&absent, &counters);
+    TEST_CHECK(counters.naks == 1 && counters.failures == 1 && counters.retries == 0);
+}
+
+static void _TestCore(void)
+{
+    uint8 data[2] = {0x00, 0x55};
+    Module_I2C_Transaction trans = _Write(data, 2, 1);
+    const uint32 asserts = host_assertCount;
+
+    /* The queues are only locked against the interrupts of the bus core */
+    Host_setCore(IfxCpu_ResourceCpu_1);
+    if (Host_expectAssert() == 0) {
+        I2c_submit(&sensor, &trans);
+    }
+    Host_setCore(IfxCpu_ResourceCpu_0);
+    TEST_CHECK(host_assertCount == asserts + 1);
+    TEST_CHECK(I2c_isBusBusy(&sensor) == FALSE);
+    TEST_CHECK(Host_interruptsEnabled());
+}
+
+static void _TestLatency(void)
+{
+    Module_I2C_Latency latency;
+    uint32 count = 0;
+
+    I2c_getLatency(&sensor, &latency);
+    for (int i = 0; i < MODULE_I2C_LATENCY_BINS; i++) {
+        count += latency.bins[i];
+    }
+    TEST_CHECK(count == 3 + (MODULE_I2C_QUEUE_LEN + 1) + 3 + 4 + 1);
+    TEST_CHECK(latency.maxTicks > 0);
+}
+
+int main(void)
+{
+    Host_I2cModel_init(sensorConfig.baudrate);
+    slave = Host_I2cModel_addSlave(SENSOR_ADDR);
+
+    Init_I2C(&sensor, &sensorConfig);
+    Init_I2C(&absent, &absentConfig);
+    Init_I2C_Async(&sensor);
+    Init_I2C_Async(&absent);
+    TEST_CHECK(sensor.bus == absent.bus);
+    TEST_CHECK(I2c_isBusBusy(&sensor) == FALSE);
+
+    _TestSubmit();
+    _TestQueueFull();
+    _TestRead();
+    _TestChain();
+    _TestBlockingInIsr();
+    _TestNak();
+    _TestCore();
+    _TestLatency();
+
+    return Host_report("Test_I2cQueue");
+}
@@ -0,0 +1,166 @@
+#include <string.h>
+#include "Host_I2cModel.h"
+
+/* Retry policy, STM backoff and bus recovery of the queue on the I2C0 register model (user-007) */
+
+#define SENSOR_ADDR                     0x48
+#define ABSENT_ADDR                     0x50
+#define PANEL_ADDR                      0x3C
+
+#define TEST_I2C_CONFIG(address, attempts, backoff, maxBackoff, recover) {              \
+    .p_i2c = &MODULE_I2C0,                                                              \
+    .MCP_PINS = {                                                                       \
+        .scl = &IfxI2c0_SCL_P13_1_INOUT,                                                \
+        .sda = &IfxI2c0_SDA_P13_2_INOUT,                                                \
+        .padDriver = IfxPort_PadDriver_ttlSpeed1                                        \
+    },                                                                                  \
+    .baudrate = 400000,                                                                 \
+    .addr = (address),                                                                  \
+    .retry = {                                                                          \
+        .maxAttempts = (attempts),                                                      \
+        .backoffUs = (backoff),                                                         \
+        .maxBackoffUs = (maxBackoff),                                                   \
+        .recoverAfter = (recover)                                                       \
+    },                                                                                  \
+    .priority = Module_I2C_Priority_NORMAL                                              \
+}
+
+static const Module_I2C_Config sensorConfig = TEST_I2C_CONFIG(SENSOR_ADDR, 0, 100, 400, 0);
+static const Module_I2C_Config absentConfig = TEST_I2C_CONFIG(ABSENT_ADDR, 3, 100, 400, 0);
+static const Module_I2C_Config panelConfig = TEST_I2C_CONFIG(PANEL_ADDR, 8, 50, 2000, 2);
+static const Module_I2C_Config badConfig = TEST_I2C_CONFIG(PANEL_ADDR, 8, 50, 0, 2);
+static Module_I2C_Inst sensor;
+static Module_I2C_Inst absent;
+static Module_I2C_Inst panel;
+static Host_I2cSlave *sensorSlave;
+static Host_I2cSlave *panelSlave;
+
+static struct {
+    IfxI2c_I2c_Status status;
+    uint32 count;
+} done;
+
+static void _Done(IfxI2c_I2c_Status status, void *arg)
+{
+    (void)arg;
+    done.status = status;
+    done.count++;
+}
+
+static void _Submit(Module_I2C_Inst *inst, volatile uint8 *data, Ifx_SizeT size)
+{
+    Module_I2C_Transaction trans = {.dir = Module_I2C_Dir_WRITE, .data = data, .size = size, .callback = _Done};
+
+    done.count = 0;
+    host_i2cModel.backoffLen = 0;
+    TEST_CHECK(I2c_submit(inst, &trans));
+    Host_I2cModel_run();
+    TEST_CHECK(done.count == 1);
+}
+
+static uint32 _Ticks(uint32 us)
+{
+    return us * HOST_STM_TICKS_PER_US;
+}
+
+/* NAKs are retried after backoffUs, doubled per retry up to maxBackoffUs */
+static void _TestBackoff(void)
+{
+    uint8 data[2] = {0x01, 0x5A};
+    Module_I2C_Counters counters;
+
+    sensorSlave->nakCount = 4;
+    _Submit(&sensor, data, sizeof(data));
+    TEST_CHECK(done.status == IfxI2c_I2c_Status_ok);
+    TEST_CHECK(sensorSlave->regs[0x01] == 0x5A);
+    TEST_CHECK(host_i2cModel.backoffLen == 4);
+    TEST_CHECK(host_i2cModel.backoffTicks[0] == _Ticks(100));
+    TEST_CHECK(host_i2cModel.backoffTicks[1] == _Ticks(200));
+    TEST_CHECK(host_i2cModel.backoffTicks[2] == _Ticks(400));
+    TEST_CHECK(host_i2cModel.backoffTicks[3] == _Ticks(400));
+    I2c_getCounters(&sensor, &counters);
+    TEST_CHECK(counters.naks == 4 && counters.retries == 4 && counters.failures == 0 && counters.recoveries == 0);
+    printf("NAK x4, backoff 100 us / max 400 us: %u %u %u %u us\n", host_i2cModel.backoffTicks[0] / HOST_STM_TICKS_PER_US,
+           host_i2cModel.backoffTicks[1] / HOST_STM_TICKS_PER_US, host_i2cModel.backoffTicks[2] / HOST_STM_TICKS_PER_US,
+           host_i2cModel.backoffTicks[3] / HOST_STM_TICKS_PER_US);
+}
+
+/* Absent slave: Given up after maxAttempts, the queue goes on */
+static void _TestGiveUp(void)
+{
+    uint8 data[2] = {0x02, 0xA5};
+    Module_I2C_Counters counters;
+
+    _Submit(&absent, data, sizeof(data));
+    TEST_CHECK(done.status == IfxI2c_I2c_Status_nak);
+    TEST_CHECK(host_i2cModel.backoffLen == 2);
+    I2c_getCounters(&absent, &counters);
+    TEST_CHECK(counters.naks == 3 && counters.retries == 2 && counters.failures == 1);
+    TEST_CHECK(I2c_isBusBusy(&absent) == FALSE);
+
+    _Submit(&sensor, data, sizeof(data));
+    TEST_CHECK(done.status == IfxI2c_I2c_Status_ok);
+}
+
+/* SDA held by a slave: Bus not free twice, then SCL pulses until SDA is released, a STOP and the retry */
+static void _TestRecovery(void)
+{
+    uint8 data[3] = {0x10, 0x11, 0x12};
+    Module_I2C_Counters counters;
+    uint32 steps = 0;
+
+    Host_I2cModel_holdSda(3);
+    _Submit(&panel, data, sizeof(data));
+    TEST_CHECK(done.status == IfxI2c_I2c_Status_ok);
+    TEST_CHECK(panelSlave->regs[0x10] == 0x11 && panelSlave->regs[0x11] == 0x12);
+    TEST_CHECK(host_i2cModel.sclPulses == 3 + 1);        /* 3 until SDA is released + the one of the STOP */
+    TEST_CHECK(host_i2cModel.stops == 1);
+    TEST_CHECK(host_i2cModel.bSdaHeld == FALSE);
+    TEST_CHECK(IfxPort_getPinState(&MODULE_P13, HOST_I2CMODEL_SDA_PIN));
+
+    /* Two backoffs (50, 100 us), the second compare begins the recovery: One compare per half period of 100 kHz */
+    TEST_CHECK(host_i2cModel.backoffTicks[0] == _Ticks(50));
+    TEST_CHECK(host_i2cModel.backoffTicks[1] == _Ticks(100));
+    for (uint32 i = 2; i < host_i2cModel.backoffLen; i++) {
+        TEST_CHECK(host_i2cModel.backoffTicks[i] == _Ticks(MODULE_I2C_RECOVERY_HALF_US));
+        steps++;
+    }
+    /* 3 clocks (6 half periods), SDA released: SCL low, the STOP (3) and the pins back to I2C */
+    TEST_CHECK(steps == 6 + 1 + 3 + 1);
+
+    I2c_getCounters(&panel, &counters);
+    TEST_CHECK(counters.recoveries == 1 && counters.retries == 2 && counters.failures == 0 && counters.naks == 0);
+    printf("Recovery: %u SCL pulses, %u STOP, %u compares of %u us\n", host_i2cModel.sclPulses, host_i2cModel.stops, steps,
+           MODULE_I2C_RECOVERY_HALF_US);
+}
+
+/* maxBackoffUs = 0 used to turn the backoff off without a word */
+static void _TestPolicyAssert(void)
+{
+    Module_I2C_Inst bad;
+    const uint32 asserts = host_assertCount;
+
+    if (Host_expectAssert() == 0) {
+        Init_I2C(&bad, &badConfig);
+    }
+    TEST_CHECK(host_assertCount == asserts + 1);
+}
+
+int main(void)
+{
+    Host_I2cModel_init(sensorConfig.baudrate);
+    sensorSlave = Host_I2cModel_addSlave(SENSOR_ADDR);
+    panelSlave = Host_I2cModel_addSlave(PANEL_ADDR);
+
+    Init_I2C(&sensor, &sensorConfig);
+    Init_I2C(&absent, &absentConfig);
+    Init_I2C(&panel, &panelConfig);
+    Init_I2C_Async(&sensor);
+
+    _TestBackoff();
+    _TestGiveUp();
+    _TestRecovery();
+    _TestPolicyAssert();
+
+    return Host_report("Test_I2cRetry");
+}
@@ -0,0 +1,118 @@
+#include <string.h>
+#include <time.h>
+#include "Host_Panel.h"
+
+/* SSD1306_ImportImage against a per-pixel reference for every flag combination, and its cost (user-011) */
+
+#define IMAGE_SIZE                      (SSD1306_IMAGE_STRIDE * SSD1306_MAX_PAGE * 8)
+#define BENCH_LOOPS                     2000
+
+static uint8 image[IMAGE_SIZE];
+static uint8 buff[SSD1306_MAX_PAGE * SSD1306_MAX_SEG];
+static uint8 expect[SSD1306_MAX_PAGE * SSD1306_MAX_SEG];
+static SSD1306_FrameBuffer frame;
+
+/* One pixel at a time, straight from the flag descriptions in SSD1306.h */
+static void _Reference(uint8 *dst, const uint8 *src, uint8 flags)
+{
+    memset(dst, 0, SSD1306_MAX_PAGE * SSD1306_MAX_SEG);
+    for (int y = 0; y < SSD1306_MAX_PAGE * 8; y++) {
+        for (int x = 0; x < SSD1306_MAX_SEG; x++) {
+            const int bit = (flags & SSD1306_IMAGE_LSB_FIRST) ? (x & 7) : (7 - (x & 7));
+            uint8 value = (src[(y * SSD1306_IMAGE_STRIDE) + (x / 8)] >> bit) & 0x01;
+            const int column = (flags & SSD1306_IMAGE_MIRROR) ? (SSD1306_MAX_SEG - 1 - x) : x;
+
+            value ^= (flags & SSD1306_IMAGE_INVERT) ? 0x01 : 0x00;
+            dst[((y / 8) * SSD1306_MAX_SEG) + column] |= value << (y % 8);
+        }
+    }
+}
+
+static void _Fill(uint32 seed)
+{
+    for (int i = 0; i < IMAGE_SIZE; i++) {
+        seed = (seed * 1103515245) + 12345;
+        image[i] = (uint8)(seed >> 16);
+    }
+}
+
+static void _TestFlags(void)
+{
+    for (uint32 pattern = 0; pattern < 4; pattern++) {
+        if (pattern < 2) {
+            memset(image, (pattern == 0) ? 0x00 : 0x80, sizeof(image));     /* Blank, then the left column of every block */
+        } else {
+            _Fill(pattern);
+        }
+
+        for (uint8 flags = 0; flags < 8; flags++) {
+            _Reference(expect, image, flags);
+            memset(buff, 0x5A, sizeof(buff));
+            SSD1306_ImportImage(buff, image, flags);
+            TEST_CHECK(memcmp(buff, expect, sizeof(buff)) == 0);
+        }
+    }
+
+    /* One pixel: x = 9, y = 13 lands in page 1, column 9 (118 mirrored), bit 5 */
+    memset(image, 0, sizeof(image));
+    image[(13 * SSD1306_IMAGE_STRIDE) + 1] = 0x40;
+    SSD1306_ImportImage(buff, image, 0);
+    TEST_CHECK(buff[SSD1306_MAX_SEG + 9] == 0x20);
+    SSD1306_ImportImage(buff, image, SSD1306_IMAGE_MIRROR);
+    TEST_CHECK(buff[SSD1306_MAX_SEG + 118] == 0x20);
+}
+
+static double _Seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+/* Host time only: A ratio against the per-pixel loop that ImportImage replaced, not TriCore cycles */
+static void _Bench(void)
+{
+    volatile uint8 sink = 0;
+    double start;
+    double import;
+    double perPixel;
+
+    _Fill(7);
+    start = _Seconds();
+    for (int i = 0; i < BENCH_LOOPS; i++) {
+        image[0] = (uint8)i;
+        SSD1306_ImportImage(buff, image, SSD1306_IMAGE_MIRROR);
+        sink ^= buff[i & 0x3FF];
+    }
+    import = (_Seconds() - start) / BENCH_LOOPS;
+
+    start = _Seconds();
+    for (int i = 0; i < BENCH_LOOPS; i++) {
+        image[0] = (uint8)i;
+        for (int y = 0; y < SSD1306_MAX_PAGE * 8; y++) {
+            for (int x = 0; x < SSD1306_MAX_SEG; x++) {
+                SSD1306_SetPixel(&frame, (uint8)(SSD1306_MAX_SEG - 1 - x), (uint8)y,
+                                 image[(y * SSD1306_IMAGE_STRIDE) + (x / 8)] >> (7 - (x & 7)));
+            }
+        }
+        sink ^= frame.buff[0][i & 0x7F];
+    }
+    perPixel = (_Seconds() - start) / BENCH_LOOPS;
+
+    TEST_CHECK(memcmp(buff, frame.buff, sizeof(buff)) == 0);
+    TEST_CHECK(import < perPixel);
+    printf("128x64 image on the host: ImportImage %.2f us, SSD1306_SetPixel loop %.2f us (x%.0f)\n",
+           import * 1e6, perPixel * 1e6, perPixel / import);
+    (void)sink;
+}
+
+int main(void)
+{
+    SSD1306_InitFrame(&frame);
+
+    _TestFlags();
+    _Bench();
+
+    return Host_report("Test_ImportImage");
+}
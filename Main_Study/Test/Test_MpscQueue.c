@@ -0,0 +1,180 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Host.h"
+#include "Ifx_MpscQueue.h"
+
+/* Ifx_MpscQueue with 1 to 8 writer threads and the CPU0 reader, per writer order and write latency (user-025) */
+
+#define SLOTS                           256
+#define RECORDS                         200000                          /* Per writer */
+#define WRITERS_MAX                     8
+
+typedef struct _Record {
+    uint32 writer;
+    uint32 n;
+    uint32 check;
+    uint32 pad;
+} Record;
+
+static uint8 memory[IFX_MPSCQUEUE_MEMORY_SIZE(SLOTS, sizeof(Record))];
+static Ifx_MpscQueue *queue;
+static uint32 latency[WRITERS_MAX][RECORDS];                            /* ns of each successful write */
+static uint32 full[WRITERS_MAX];                                        /* Writes refused, the queue was full */
+
+static uint32 _Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32)((ts.tv_sec * 1000000000ull) + ts.tv_nsec);
+}
+
+/* Sequence number of the slot of position pos, as Ifx_MpscQueue.c addresses it */
+static volatile uint32 *_Sequence(uint32 pos)
+{
+    return (volatile uint32 *)&queue->slots[(pos & queue->mask) * queue->slotSize];
+}
+
+static uint32 _Check(uint32 writer, uint32 n)
+{
+    return (writer * 2654435761u) ^ (n * 40503u);
+}
+
+static void *_Writer(void *arg)
+{
+    const uint32 writer = (uint32)(uintptr_t)arg;
+    Record record = {writer, 0, 0, 0};
+
+    Host_setCore((writer & 1) ? IfxCpu_ResourceCpu_2 : IfxCpu_ResourceCpu_1);
+    while (record.n < RECORDS) {
+        uint32 start;
+        boolean bWritten;
+
+        record.check = _Check(writer, record.n);
+        start = _Now();
+        bWritten = Ifx_MpscQueue_write(queue, &record);
+        if (bWritten) {
+            latency[writer][record.n] = _Now() - start;
+            record.n++;
+        } else {
+            full[writer]++;
+            Host_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static int _Compare(const void *a, const void *b)
+{
+    const uint32 x = *(const uint32 *)a;
+    const uint32 y = *(const uint32 *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Host time only: The host schedules the writers on its own cores, this is not TriCore contention */
+static void _Stress(uint32 writers)
+{
+    static uint32 sorted[WRITERS_MAX * RECORDS];
+    pthread_t thread[WRITERS_MAX];
+    uint32 next[WRITERS_MAX] = {0};
+    uint32 orderErrors = 0;
+    uint32 dataErrors = 0;
+    uint32 fullTotal = 0;
+    const uint32 total = writers * RECORDS;
+    Record record;
+
+    queue = Ifx_MpscQueue_init(memory, SLOTS, sizeof(Record));
+    for (uint32 w = 0; w < writers; w++) {
+        full[w] = 0;
+        pthread_create(&thread[w], NULL, _Writer, (void *)(uintptr_t)w);
+    }
+    for (uint32 read = 0; read < total; ) {
+        if (Ifx_MpscQueue_read(queue, &record) == FALSE) {
+            Host_yield();
+            continue;
+        }
+        if (record.writer >= writers || record.check != _Check(record.writer, record.n)) {
+            dataErrors++;
+        } else if (record.n != next[record.writer]++) {
+            orderErrors++;
+        }
+        read++;
+    }
+    for (uint32 w = 0; w < writers; w++) {
+        pthread_join(thread[w], NULL);
+        memcpy(&sorted[w * RECORDS], latency[w], sizeof(latency[w]));
+        fullTotal += full[w];
+    }
+
+    TEST_CHECK(dataErrors == 0 && orderErrors == 0);
+    TEST_CHECK(Ifx_MpscQueue_read(queue, &record) == FALSE);
+    TEST_CHECK(queue->tail.value == total && queue->head.value == total);
+
+    qsort(sorted, total, sizeof(sorted[0]), _Compare);
+    printf("| %u | %u | %u | %u | %u | %u |\n", writers, sorted[total / 2], sorted[(uint32)(total * 0.99)],
+           sorted[(uint32)(total * 0.999)], sorted[total - 1], fullTotal);
+}
+
+/* One thread: Full, empty, and the positions over the 32 bit wrap */
+static void _TestLimits(void)
+{
+    Record record;
+    Record out;
+
+    queue = Ifx_MpscQueue_init(memory, 4, sizeof(Record));
+    TEST_CHECK(((uintptr_t)queue % IFX_ALIGN_256) == 0);
+    TEST_CHECK((uint8 *)&queue->head - (uint8 *)&queue->tail == IFX_ALIGN_256);
+    TEST_CHECK(queue->slotSize == 20);
+    TEST_CHECK((uint8 *)queue->slots + (4 * queue->slotSize) <= &memory[sizeof(memory)]);
+
+    /* Start 6 positions before the wrap: Each slot holds the sequence of its position in the first round */
+    queue->tail.value = queue->head.value = 0u - 6;
+    for (uint32 pos = 0u - 6; pos != 0u - 2; pos++) {
+        *_Sequence(pos) = pos;
+    }
+
+    TEST_CHECK(Ifx_MpscQueue_read(queue, &out) == FALSE);
+    for (uint32 round = 0; round < 3; round++) {
+        for (uint32 i = 0; i < 4; i++) {
+            record = (Record){0, (round * 4) + i, 0, 0};
+            TEST_CHECK(Ifx_MpscQueue_write(queue, &record));
+        }
+        TEST_CHECK(Ifx_MpscQueue_write(queue, &record) == FALSE);
+        for (uint32 i = 0; i < 4; i++) {
+            TEST_CHECK(Ifx_MpscQueue_read(queue, &out) && out.n == (round * 4) + i);
+        }
+        TEST_CHECK(Ifx_MpscQueue_read(queue, &out) == FALSE);
+    }
+    TEST_CHECK(queue->head.value == 6);
+
+    /* A claimed slot not published yet holds back the records behind it */
+    record.n = 100;
+    queue->tail.value++;
+    TEST_CHECK(Ifx_MpscQueue_write(queue, &record));
+    TEST_CHECK(Ifx_MpscQueue_read(queue, &out) == FALSE);
+    *_Sequence(6) = 7;
+    TEST_CHECK(Ifx_MpscQueue_read(queue, &out));
+    TEST_CHECK(Ifx_MpscQueue_read(queue, &out) && out.n == 100);
+}
+
+int main(void)
+{
+    static const uint32 writers[4] = {1, 2, 4, 8};
+
+    _TestLimits();
+
+    printf("%u B records, %u slots, %u records per writer, write latency in ns (host time only):\n",
+           (uint32)sizeof(Record), SLOTS, RECORDS);
+    printf("| writers | p50 | p99 | p99.9 | max | full |\n");
+    printf("| - | - | - | - | - | - |\n");
+    for (int i = 0; i < 4; i++) {
+        _Stress(writers[i]);
+    }
+
+    return Host_report("Test_MpscQueue");
+}
@@ -0,0 +1,175 @@
+#include <string.h>
+#include "SSD1306.c"            /* _UnpackBits is static */
+#include "Host_Panel.h"
+
+/* PackBits decoder against the output of Tools/ssd1306_image.py, and the malformed streams (user-016) */
+
+#define IMAGE_PBM                       "Test_PackBits.pbm"
+
+/* build/Test_PackBits.inc: Tools/ssd1306_image.py Test_PackBits.pbm test_image (Makefile) */
+#include "Test_PackBits.inc"
+
+static IFX_ALIGN(4) SSD1306_Inst panel;
+static uint8 pages[SSD1306_MAX_PAGE][SSD1306_MAX_SEG];
+static uint8 out[SSD1306_MAX_PAGE * SSD1306_MAX_SEG + 8];
+
+/* P1 PBM into the GDDRAM layout of to_pages (1 = lit, top row in bit 0), returns the columns */
+static uint32 _ReadPbm(const char *path, uint32 *pageLen)
+{
+    FILE *f = fopen(path, "r");
+    uint32 width = 0;
+    uint32 height = 0;
+    uint32 n = 0;
+    int c;
+
+    if (f == NULL) {
+        return 0;
+    }
+    memset(pages, 0, sizeof(pages));
+    while ((c = fgetc(f)) != EOF && c != '\n');                         /* P1 */
+    while ((c = fgetc(f)) == '#') {
+        while ((c = fgetc(f)) != EOF && c != '\n');
+    }
+    ungetc(c, f);
+    if (fscanf(f, "%u %u", &width, &height) != 2 || width > SSD1306_MAX_SEG || height > SSD1306_MAX_PAGE * 8) {
+        fclose(f);
+        return 0;
+    }
+    while (n < width * height && (c = fgetc(f)) != EOF) {
+        if (c == '0' || c == '1') {
+            pages[(n / width) / 8][n % width] |= (uint8)((c - '0') << ((n / width) % 8));
+            n++;
+        }
+    }
+    fclose(f);
+
+    *pageLen = (height + 7) / 8;
+    return (n == width * height) ? width : 0;
+}
+
+static void _TestEncoder(void)
+{
+    uint32 pageLen = 0;
+    const uint32 width = _ReadPbm(IMAGE_PBM, &pageLen);
+    uint32 i = 0;
+
+    TEST_CHECK(width == test_image.columnLen && pageLen == test_image.pageLen);
+
+    /* The image has a repeat and a literal run of the full 128 bytes (0x81, 0x7F) and runs of 2 */
+    TEST_CHECK(test_imageData[0] == 0x81 && test_imageData[2] == 0x7F);
+    while (i < test_image.size) {
+        const sint8 header = (sint8)test_imageData[i];
+
+        TEST_CHECK(header != -128);                                     /* Not emitted by the encoder */
+        i += (header >= 0) ? (uint32)header + 2 : 2;
+    }
+    TEST_CHECK(i == test_image.size);
+
+    memset(out, 0xAA, sizeof(out));
+    TEST_CHECK(_UnpackBits(out, pageLen * width, test_image.data, test_image.size) == pageLen * width);
+    for (uint32 page = 0; page < pageLen; page++) {
+        TEST_CHECK(memcmp(&out[page * width], pages[page], width) == 0);
+    }
+    TEST_CHECK(out[pageLen * width] == 0xAA);
+}
+
+static void _TestRuns(void)
+{
+    static const uint8 literal[] = {0x02, 0x11, 0x22, 0x33};
+    static const uint8 repeat[] = {0xFD, 0x44};                         /* -3: 4 times */
+    static const uint8 noop[] = {0x80, 0x00, 0x55, 0x80};               /* -128 is skipped, also as the last byte */
+    static const uint8 mixed[] = {0x00, 0x01, 0xFF, 0x02, 0x80, 0x01, 0x03, 0x04, 0x81, 0x05};
+
+    memset(out, 0, sizeof(out));
+    TEST_CHECK(_UnpackBits(out, sizeof(out), literal, sizeof(literal)) == 3);
+    TEST_CHECK(out[0] == 0x11 && out[2] == 0x33 && out[3] == 0);
+
+    memset(out, 0, sizeof(out));
+    TEST_CHECK(_UnpackBits(out, sizeof(out), repeat, sizeof(repeat)) == 4);
+    TEST_CHECK(out[0] == 0x44 && out[3] == 0x44 && out[4] == 0);
+
+    TEST_CHECK(_UnpackBits(out, sizeof(out), noop, sizeof(noop)) == 1);
+    TEST_CHECK(out[0] == 0x55);
+
+    /* 1 literal, 2 x 0x02, no-op, 2 literals, 128 x 0x05 */
+    memset(out, 0, sizeof(out));
+    TEST_CHECK(_UnpackBits(out, sizeof(out), mixed, sizeof(mixed)) == 1 + 2 + 2 + 128);
+    TEST_CHECK(out[0] == 0x01 && out[1] == 0x02 && out[2] == 0x02 && out[3] == 0x03 && out[4] == 0x04);
+    TEST_CHECK(out[5] == 0x05 && out[132] == 0x05 && out[133] == 0);
+}
+
+/* Cut streams end at the last whole byte, nothing is read past src + size */
+static void _TestTruncated(void)
+{
+    static const uint8 literal[] = {0x04, 0x11, 0x22, 0x33, 0x44, 0x55};
+    static const uint8 repeat[] = {0x00, 0x66, 0xFE, 0x77};
+
+    memset(out, 0, sizeof(out));
+    TEST_CHECK(_UnpackBits(out, sizeof(out), literal, 3) == 2);         /* 5 literals announced, 2 there */
+    TEST_CHECK(out[0] == 0x11 && out[1] == 0x22 && out[2] == 0);
+
+    TEST_CHECK(_UnpackBits(out, sizeof(out), repeat, 3) == 1);          /* Repeat header without its byte */
+    TEST_CHECK(out[0] == 0x66 && out[1] == 0x22);
+
+    /* The encoder output cut anywhere: A prefix of the whole image */
+    for (Ifx_SizeT size = 0; size < test_image.size; size += 7) {
+        const Ifx_SizeT len = test_image.pageLen * test_image.columnLen;
+        Ifx_SizeT n;
+
+        memset(out, 0xAA, sizeof(out));
+        n = _UnpackBits(out, len, test_image.data, size);
+        TEST_CHECK(n < len);
+        TEST_CHECK(memcmp(out, &pages[0][0], n) == 0 && out[n] == 0xAA);
+    }
+}
+
+/* dst ends first: Runs are cut at len, no byte after it is written */
+static void _TestOverrun(void)
+{
+    static const uint8 repeat[] = {0x81, 0x99};                         /* 128 x 0x99 */
+    static const uint8 literal[] = {0x03, 0x01, 0x02, 0x03, 0x04, 0x00, 0x05};
+
+    memset(out, 0, sizeof(out));
+    TEST_CHECK(_UnpackBits(out, 10, repeat, sizeof(repeat)) == 10);
+    TEST_CHECK(out[9] == 0x99 && out[10] == 0);
+
+    memset(out, 0, sizeof(out));
+    TEST_CHECK(_UnpackBits(out, 3, literal, sizeof(literal)) == 3);
+    TEST_CHECK(out[2] == 0x03 && out[3] == 0);
+
+    TEST_CHECK(_UnpackBits(out, 0, literal, sizeof(literal)) == 0);
+    TEST_CHECK(out[0] == 0x01);
+}
+
+/* Through SSD1306_DrawImage: Short streams are blank to the end of the window */
+static void _TestDrawImage(void)
+{
+    const SSD1306_Image cut = {test_imageData, 2, test_image.pageLen, test_image.columnLen};
+    uint8 expect[SSD1306_MAX_PAGE][SSD1306_MAX_SEG] = {{0}};
+    Host_Panel gddram;
+
+    Host_I2cStub_reset();
+    Host_Panel_init(&gddram, SSD1306_PanelConfig[0].i2c.addr);
+    Init_SSD1306(&panel, &SSD1306_PanelConfig[0]);
+
+    SSD1306_DrawImage(&panel, &test_image, 0, 0);
+    Host_Panel_update(&gddram);
+    TEST_CHECK(Host_Panel_equals(&gddram, pages, SSD1306_MAX_PAGE));
+    TEST_CHECK(memcmp(panel.shadow, pages, sizeof(pages)) == 0);
+
+    /* Only the 128 blank bytes of page 0: The noise of pages 1 and 2 is cleared */
+    SSD1306_DrawImage(&panel, &cut, 0, 0);
+    Host_Panel_update(&gddram);
+    TEST_CHECK(Host_Panel_equals(&gddram, expect, SSD1306_MAX_PAGE));
+}
+
+int main(void)
+{
+    _TestEncoder();
+    _TestRuns();
+    _TestTruncated();
+    _TestOverrun();
+    _TestDrawImage();
+
+    return Host_report("Test_PackBits");
+}
@@ -0,0 +1,181 @@
+#include <string.h>
+#include "Host_Panel.h"
+
+/* Two panels on one bus: SSD1306_FlushPanels against two SSD1306_FlushFrame, and refused transactions (user-018) */
+
+#define PAIRS                           20
+#define SMALL_PAGE                      1
+#define SMALL_COLUMN                    60
+#define SMALL_LEN                       8              /* Columns changed on the 128x32 panel per frame */
+
+static IFX_ALIGN(4) SSD1306_Inst panels[2];            /* 128x64, 128x32 */
+static Host_Panel gddram[2];
+
+/* Changed bytes of a frame pair: Runs of up to 40 columns on the 128x64 pages, 8 columns on the 128x32 */
+static void _Render(uint32 bigBytes)
+{
+    SSD1306_FrameBuffer *big = SSD1306_GetBackFrame(&panels[0]);
+    SSD1306_FrameBuffer *small = SSD1306_GetBackFrame(&panels[1]);
+
+    for (uint32 page = 0; bigBytes > 0; page++) {
+        const uint32 len = (bigBytes > 40) ? 40 : bigBytes;
+
+        for (uint32 i = 0; i < len; i++) {
+            big->buff[page][10 + i] ^= 0xFF;
+        }
+        bigBytes -= len;
+    }
+    for (uint32 i = 0; i < SMALL_LEN; i++) {
+        small->buff[SMALL_PAGE][SMALL_COLUMN + i] ^= 0xFF;
+    }
+
+    TEST_CHECK(SSD1306_PostFrame(&panels[0]));
+    TEST_CHECK(SSD1306_PostFrame(&panels[1]));
+}
+
+/* The panels show the last posted frames */
+static boolean _Shown(void)
+{
+    boolean bEqual = TRUE;
+
+    for (int i = 0; i < 2; i++) {
+        Host_Panel_update(&gddram[i]);
+        bEqual &= Host_Panel_equals(&gddram[i], panels[i].frames[panels[i].backIndex ^ 1].buff, panels[i].pageLen);
+    }
+
+    return bEqual;
+}
+
+typedef struct _Result {
+    uint32 ticks;                       /* Per frame pair */
+    uint32 bytes;
+    uint32 smallDone;                   /* 128x32 frame finished after */
+} Result;
+
+/* Blocking flush of one panel after the other, immediate stub */
+static Result _FlushFrames(uint32 bigBytes)
+{
+    Result result = {0};
+    const uint32 first = host_i2cStub.transLen;
+    const uint32 start = Host_now();
+
+    for (uint32 pair = 0; pair < PAIRS; pair++) {
+        const uint32 pairStart = Host_now();
+
+        _Render(bigBytes);
+        TEST_CHECK(SSD1306_FlushFrame(&panels[0]));
+        TEST_CHECK(SSD1306_FlushFrame(&panels[1]));
+        result.smallDone += Host_now() - pairStart;
+        TEST_CHECK(_Shown());
+    }
+
+    result.ticks = (Host_now() - start) / PAIRS;
+    result.bytes = Host_I2cStub_wireBytes(first, 0) / PAIRS;
+    result.smallDone /= PAIRS;
+    return result;
+}
+
+/* SSD1306_FlushPanels on the deferred stub: The bus finishes one transaction between the calls */
+static Result _FlushPanels(uint32 bigBytes)
+{
+    Result result = {0};
+    const uint32 first = host_i2cStub.transLen;
+    const uint32 start = Host_now();
+
+    host_i2cStub.bDeferred = TRUE;
+    for (uint32 pair = 0; pair < PAIRS; pair++) {
+        const uint32 pairStart = Host_now();
+        boolean bSmallDone = FALSE;
+
+        _Render(bigBytes);
+        while (panels[0].frontState != SSD1306_Front_IDLE || panels[1].frontState != SSD1306_Front_IDLE) {
+            SSD1306_FlushPanels(panels, 2);
+            if (bSmallDone == FALSE && panels[1].frontState == SSD1306_Front_IDLE) {
+                result.smallDone += Host_now() - pairStart;
+                bSmallDone = TRUE;
+            }
+            Host_I2cStub_next();
+        }
+        while (Host_I2cStub_next());
+        TEST_CHECK(_Shown());
+    }
+    host_i2cStub.bDeferred = FALSE;
+
+    result.ticks = (Host_now() - start) / PAIRS;
+    result.bytes = Host_I2cStub_wireBytes(first, 0) / PAIRS;
+    result.smallDone /= PAIRS;
+    return result;
+}
+
+static float _Ms(uint32 ticks)
+{
+    return ticks / (HOST_STM_TICKS_PER_US * 1000.0f);
+}
+
+static void _TestThroughput(void)
+{
+    static const uint32 bigBytes[3] = {10, 40, 200};
+
+    printf("| Changed bytes on 128x64 | Frame pairs / s | Bus | 128x32 frame done after (FlushFrame x2) | (FlushPanels) |\n");
+    printf("| - | - | - | - | - |\n");
+    for (int i = 0; i < 3; i++) {
+        const Result frames = _FlushFrames(bigBytes[i]);
+        const Result flushPanels = _FlushPanels(bigBytes[i]);
+
+        /* Same bytes, same bus time: Only the order of the runs differs */
+        TEST_CHECK(frames.bytes == flushPanels.bytes);
+        TEST_CHECK(frames.ticks == flushPanels.ticks);
+        /* One run on the 128x64 goes first either way, with several the 128x32 run gets in after the first */
+        TEST_CHECK(flushPanels.smallDone <= frames.smallDone);
+        TEST_CHECK(bigBytes[i] <= 40 || flushPanels.smallDone < frames.smallDone);
+        printf("| %u | %.0f | %.0f KB/s | %.2f ms | %.2f ms |\n", bigBytes[i], 1000.0f / _Ms(flushPanels.ticks),
+               flushPanels.bytes / _Ms(flushPanels.ticks), _Ms(frames.smallDone), _Ms(flushPanels.smallDone));
+    }
+}
+
+/* Full queue: The refused runs wait on the pending list, nothing is lost or reordered */
+static void _TestRefused(void)
+{
+    const uint32 refused = host_i2cStub.refused;
+
+    host_i2cStub.bDeferred = TRUE;
+    host_i2cStub.queueMax = 1;
+    for (uint32 pair = 0; pair < PAIRS; pair++) {
+        _Render(200);
+        host_i2cStub.refuseNext = pair % 3;
+        while (panels[0].frontState != SSD1306_Front_IDLE || panels[1].frontState != SSD1306_Front_IDLE) {
+            SSD1306_FlushPanels(panels, 2);
+            TEST_CHECK(panels[0].pendingLen <= 2 && panels[1].pendingLen <= 2);
+            Host_I2cStub_next();
+        }
+        while (Host_I2cStub_next());
+        TEST_CHECK(_Shown());
+    }
+    host_i2cStub.queueMax = HOST_I2CSTUB_QUEUE;
+    host_i2cStub.bDeferred = FALSE;
+
+    TEST_CHECK(host_i2cStub.refused > refused);
+    TEST_CHECK(panels[0].bShadowValid && panels[1].bShadowValid);
+    printf("Queue of 1: %u submits refused and retried, both panels match\n", host_i2cStub.refused - refused);
+}
+
+int main(void)
+{
+    Host_I2cStub_reset();
+    for (int i = 0; i < 2; i++) {
+        Host_Panel_init(&gddram[i], SSD1306_PanelConfig[i].i2c.addr);
+        Init_SSD1306(&panels[i], &SSD1306_PanelConfig[i]);
+    }
+    TEST_CHECK(panels[0].pageLen == SSD1306_MAX_PAGE && panels[1].pageLen == SSD1306_MAX_PAGE / 2);
+    TEST_CHECK(host_i2cStub.dmaChannel == SSD1306_PanelConfig[1].dmaChannel);
+
+    /* First diff against the init image, from here on only the rendered changes are sent */
+    _Render(0);
+    TEST_CHECK(SSD1306_FlushFrame(&panels[0]) && SSD1306_FlushFrame(&panels[1]));
+    TEST_CHECK(_Shown());
+
+    _TestThroughput();
+    _TestRefused();
+
+    return Host_report("Test_Panels");
+}
@@ -0,0 +1,105 @@
+#include <string.h>
+#include "Host_I2cPoll.h"
+
+/* Blocking I2c_write on the I2C0 FIFO: Interrupts are off for one TXD word at a time, not for the packet (user-021) */
+
+#define SENSOR_ADDR                     0x3C
+#define PAYLOADS                        4
+
+static const Module_I2C_Config sensorConfig = {
+    .p_i2c = &MODULE_I2C0,
+    .MCP_PINS = {
+        .scl = &IfxI2c0_SCL_P13_1_INOUT,
+        .sda = &IfxI2c0_SDA_P13_2_INOUT,
+        .padDriver = IfxPort_PadDriver_ttlSpeed1
+    },
+    .baudrate = 400000,
+    .addr = SENSOR_ADDR,
+    .retry = {.maxAttempts = 1},
+    .priority = Module_I2C_Priority_NORMAL
+};
+static Module_I2C_Inst sensor;
+static uint8 data[1024];
+
+/* Neighbouring bytes differ: No word of 4 x 0xFF (HOST_I2CPOLL_TXD_EMPTY) */
+static void _Fill(uint32 size)
+{
+    for (uint32 i = 0; i < size; i++) {
+        data[i] = (uint8)((i * 37) + 11);
+    }
+}
+
+static boolean _OnBus(uint32 size)
+{
+    return (host_i2cPoll.bytesLen == size + 1 && host_i2cPoll.bytes[0] == (SENSOR_ADDR << 1) &&
+            memcmp(&host_i2cPoll.bytes[1], data, size) == 0) ? TRUE : FALSE;
+}
+
+static void _TestPayloads(void)
+{
+    static const uint32 sizes[PAYLOADS] = {32, 128, 512, 1024};
+
+    printf("| Payload | TXD words | Interrupts-off sections | Most words in one section | Bus time |\n");
+    printf("| - | - | - | - | - |\n");
+    for (int i = 0; i < PAYLOADS; i++) {
+        const uint32 words = (sizes[i] + 1 + 3) / 4;
+        uint32 start;
+        IfxI2c_I2c_Status status;
+
+        _Fill(sizes[i]);
+        Host_I2cPoll_start(sensorConfig.baudrate);
+        start = Host_now();
+        status = I2c_write(&sensor, data, sizes[i]);
+        Host_I2cPoll_stop();
+
+        TEST_CHECK(status == IfxI2c_I2c_Status_ok);
+        TEST_CHECK(_OnBus(sizes[i]) && host_i2cPoll.packets == 1);
+        TEST_CHECK(host_i2cPoll.words == words);
+        TEST_CHECK(host_i2cPoll.lockSections == words && host_i2cPoll.maxLockWords == 1);
+        TEST_CHECK(Host_interruptsEnabled());
+        TEST_CHECK(MODULE_I2C0.BUSSTAT.B.BS == IfxI2c_BusStatus_idle);              /* STOP */
+        TEST_CHECK(Host_now() - start == (sizes[i] + 1) * host_i2cPoll.byteTicks);
+        printf("| %u B | %u | %u | %u | %u us |\n", sizes[i], host_i2cPoll.words, host_i2cPoll.lockSections,
+               host_i2cPoll.maxLockWords, (Host_now() - start) / HOST_STM_TICKS_PER_US);
+    }
+}
+
+/* Repeated START: The bus is kept for the next packet */
+static void _TestRepeatedStart(void)
+{
+    _Fill(16);
+    Host_I2cPoll_start(sensorConfig.baudrate);
+    sensor.dev.enableRepeatedStart = TRUE;
+    TEST_CHECK(I2c_write(&sensor, data, 16) == IfxI2c_I2c_Status_ok);
+    TEST_CHECK(MODULE_I2C0.BUSSTAT.B.BS == IfxI2c_BusStatus_busyMaster);
+    TEST_CHECK(I2c_write(&sensor, data, 16) == IfxI2c_I2c_Status_ok);         /* No bus free check */
+    sensor.dev.enableRepeatedStart = FALSE;
+    Host_I2cPoll_stop();
+
+    TEST_CHECK(host_i2cPoll.packets == 2 && host_i2cPoll.bytesLen == 2 * 17);
+    TEST_CHECK(host_i2cPoll.lockSections == 2 * 5 && host_i2cPoll.maxLockWords == 1);
+    TEST_CHECK(MODULE_I2C0.BUSSTAT.B.BS == IfxI2c_BusStatus_busyMaster);
+}
+
+/* Another master on the bus: Nothing is written to TXD */
+static void _TestBusNotFree(void)
+{
+    Host_I2cPoll_start(sensorConfig.baudrate);
+    MODULE_I2C0.BUSSTAT.B.BS = IfxI2c_BusStatus_remoteSlave;
+    TEST_CHECK(I2c_write(&sensor, data, 16) == IfxI2c_I2c_Status_busNotFree);
+    Host_I2cPoll_stop();
+
+    TEST_CHECK(host_i2cPoll.words == 0 && host_i2cPoll.lockSections == 0);
+    TEST_CHECK(sensor.counters.failures == 1);
+}
+
+int main(void)
+{
+    Init_I2C(&sensor, &sensorConfig);
+
+    _TestPayloads();
+    _TestRepeatedStart();
+    _TestBusNotFree();
+
+    return Host_report("Test_PollingWrite");
+}
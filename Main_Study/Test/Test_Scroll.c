@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <string.h>
+#include "Host_Panel.h"
+#include "SSD1306_Scroll.h"
+
+/* Log view on the GDDRAM ring and the ticker, on both panel geometries (user-017) */
+
+#define LOG_LINES                       20
+
+static IFX_ALIGN(4) SSD1306_Inst panel;
+static Host_Panel gddram;
+static uint8 expect[SSD1306_MAX_PAGE][SSD1306_MAX_SEG];
+
+static void _Init(uint8 index)
+{
+    Host_I2cStub_reset();
+    Host_Panel_init(&gddram, SSD1306_PanelConfig[index].i2c.addr);
+    Init_SSD1306(&panel, &SSD1306_PanelConfig[index]);
+}
+
+/* Rows of the panel in the order they are shown, from the start line on */
+static boolean _Shown(void)
+{
+    const uint8 top = gddram.startLine / SSD1306_SEG_LEN;
+
+    for (uint8 row = 0; row < panel.pageLen; row++) {
+        if (memcmp(gddram.gddram[(top + row) % SSD1306_MAX_PAGE], expect[row], SSD1306_MAX_SEG) != 0) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/* Lines n - shown + 1 ~ n from the top row on, the rest blank */
+static void _ExpectLog(const SSD1306_LogView *log, uint32 n)
+{
+    const uint32 shown = (n + 1 < log->lineLen) ? n + 1 : log->lineLen;
+    char text[16];
+
+    memset(expect, 0, sizeof(expect));
+    for (uint32 i = 0; i < shown; i++) {
+        snprintf(text, sizeof(text), "Line %u", (n + 1 - shown) + i);
+        SSD1306_RenderText(expect[i * log->linePages], SSD1306_MAX_SEG, log->font, 0, text, SSD1306_MAX_SEG);
+    }
+}
+
+static void _TestLog(uint8 index, const SSD1306_Font *font)
+{
+    SSD1306_LogView log;
+    char text[16];
+    uint32 errors = 0;
+
+    _Init(index);
+    SSD1306_InitLog(&log, &panel, font);
+    TEST_CHECK(log.lineLen == panel.pageLen / (font->pages * font->scale));
+
+    for (uint32 n = 0; n < LOG_LINES; n++) {
+        const uint32 first = host_i2cStub.transLen;
+        const boolean bScroll = (n >= log.lineLen) ? TRUE : FALSE;
+
+        snprintf(text, sizeof(text), "Line %u", n);
+        SSD1306_PushLog(&log, text);
+        Host_Panel_update(&gddram);
+        _ExpectLog(&log, n);
+        if (_Shown() == FALSE) {
+            errors++;
+        }
+
+        /* Window list + one line of data, and the start line once the panel is full */
+        if (Host_I2cStub_wireBytes(first, gddram.addr) !=
+            (1 + 7) + (2 + (log.linePages * SSD1306_MAX_SEG)) + (bScroll ? (2 + 1) : 0)) {
+            errors++;
+        }
+    }
+    TEST_CHECK(errors == 0);
+    TEST_CHECK(log.count == log.lineLen);
+    TEST_CHECK(gddram.startLine == (((LOG_LINES - log.lineLen) * log.linePages) % SSD1306_MAX_PAGE) * SSD1306_SEG_LEN);
+
+    SSD1306_CloseLog(&log);
+    Host_Panel_update(&gddram);
+    memset(expect, 0, sizeof(expect));
+    TEST_CHECK(gddram.startLine == 0 && _Shown());
+    TEST_CHECK(Host_Panel_equals(&gddram, expect, SSD1306_MAX_PAGE));
+}
+
+/* A line of 3 pages would wrap from page 7 to page 0 */
+static void _TestLogLineHeight(void)
+{
+    SSD1306_Font font3 = SSD1306_Font8;
+    SSD1306_LogView log;
+    const uint32 asserts = host_assertCount;
+
+    font3.scale = 3;
+    _Init(0);
+    if (Host_expectAssert() == 0) {
+        SSD1306_InitLog(&log, &panel, &font3);
+    }
+    TEST_CHECK(host_assertCount == asserts + 1);
+}
+
+static void _TestTicker(uint8 index, const SSD1306_Font *font, uint8 startPage)
+{
+    const uint8 linePages = font->pages * font->scale;
+    const uint8 scroll[7] = {SSD1306_CMD_H_SCROLL(1, startPage, 7, startPage + linePages - 1)};
+
+    _Init(index);
+    SSD1306_StartTicker(&panel, font, startPage, "Ticker", 1, 7);
+    Host_Panel_update(&gddram);
+
+    memset(expect, 0, sizeof(expect));
+    SSD1306_RenderText(expect[startPage], SSD1306_MAX_SEG, font, 0, "Ticker", SSD1306_MAX_SEG);
+    TEST_CHECK(Host_Panel_equals(&gddram, expect, SSD1306_MAX_PAGE));
+    TEST_CHECK(gddram.bScroll && memcmp(gddram.scroll, scroll, sizeof(scroll)) == 0);
+    TEST_CHECK(panel.bShadowValid == FALSE);
+
+    /* Stopped before a new text is drawn */
+    SSD1306_StartTicker(&panel, font, startPage, "Next", 0, 0);
+    Host_Panel_update(&gddram);
+    TEST_CHECK(gddram.bScroll && gddram.scroll[0] == 0x26);
+
+    SSD1306_StopTicker(&panel);
+    Host_Panel_update(&gddram);
+    TEST_CHECK(gddram.bScroll == FALSE);
+}
+
+/* Line below the panel: Nothing is sent */
+static void _TestTickerOutside(void)
+{
+    uint32 first;
+
+    _Init(1);
+    first = host_i2cStub.transLen;
+    SSD1306_StartTicker(&panel, &SSD1306_Font16, (SSD1306_MAX_PAGE / 2) - 1, "Ticker", 1, 7);
+    TEST_CHECK(host_i2cStub.transLen == first);
+}
+
+int main(void)
+{
+    _TestLog(0, &SSD1306_Font8);
+    _TestLog(0, &SSD1306_Font16);
+    _TestLog(1, &SSD1306_Font8);                                        /* 4 hidden pages below the panel */
+    _TestLog(1, &SSD1306_Font16);
+    _TestLogLineHeight();
+
+    _TestTicker(0, &SSD1306_Font8, 7);
+    _TestTicker(0, &SSD1306_Font16, 2);
+    _TestTicker(1, &SSD1306_Font16, 2);
+    _TestTickerOutside();
+
+    return Host_report("Test_Scroll");
+}
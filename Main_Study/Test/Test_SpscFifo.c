@@ -0,0 +1,132 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include "Host.h"
+#include "Ifx_SpscFifo.h"
+
+/* Ifx_SpscFifo between a CPU1 writer thread and the CPU0 reader, the totals wrap during the run (user-023) */
+
+#define RECORDS                         1000000
+
+typedef struct _Setup {
+    Ifx_SizeT size;
+    Ifx_SizeT elementSize;
+} Setup;
+
+static const Setup setups[3] = {{64, 4}, {96, 12}, {4096, 16}};
+static uint8 memory[4096 + sizeof(Ifx_SpscFifo) + IFX_SPSCFIFO_LINE_SIZE];
+static Ifx_SpscFifo *fifo;
+static Ifx_SizeT elementSize;
+static uint32 writeErrors;                  /* Counted by the writer thread, checked after the join */
+
+/* Record n: n in the first word, the rest derived from it */
+static void _Make(uint32 *record, uint32 n)
+{
+    record[0] = n;
+    for (uint32 i = 1; i < elementSize / 4; i++) {
+        record[i] = (n * 2654435761u) ^ i;
+    }
+}
+
+/* Batches of 1 to 3 records and an incomplete one: Only whole elements go in */
+static void *_Writer(void *arg)
+{
+    uint32 batch[4 * 4];
+    uint32 n = 0;
+
+    (void)arg;
+    Host_setCore(IfxCpu_ResourceCpu_1);
+    while (n < RECORDS) {
+        const uint32 records = __min(1 + (n % 3), RECORDS - n);
+        Ifx_SizeT left;
+
+        for (uint32 i = 0; i < records; i++) {
+            _Make(&batch[i * (elementSize / 4)], n + i);
+        }
+        left = Ifx_SpscFifo_write(fifo, batch, (records * elementSize) + (elementSize / 2), TIME_NULL);
+        if (left % elementSize != elementSize / 2) {
+            writeErrors++;
+        }
+        n += records - (left / elementSize);
+        if (left >= elementSize) {
+            Host_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void _Stress(const Setup *setup)
+{
+    pthread_t writer;
+    uint32 record[4];
+    uint32 expect[4];
+    uint32 n = 0;
+    uint32 errors = 0;
+    uint32 yields = 0;
+
+    elementSize = setup->elementSize;
+    writeErrors = 0;
+    fifo = Ifx_SpscFifo_init(memory, setup->size, setup->elementSize);
+    TEST_CHECK(((uintptr_t)fifo % IFX_SPSCFIFO_LINE_SIZE) == 0);
+    TEST_CHECK((uint8 *)&fifo->reader - (uint8 *)&fifo->writer == IFX_SPSCFIFO_LINE_SIZE);
+
+    /* Both totals halfway before the 32 bit wrap: The count is their difference across it */
+    fifo->writer.B.total = 0u - ((RECORDS / 2) * setup->elementSize);
+    fifo->reader.B.total = fifo->writer.B.total;
+
+    pthread_create(&writer, NULL, _Writer, NULL);
+    while (n < RECORDS) {
+        if (Ifx_SpscFifo_read(fifo, record, elementSize, TIME_NULL) != 0) {
+            yields++;
+            Host_yield();
+            continue;
+        }
+        _Make(expect, n);
+        if (memcmp(record, expect, elementSize) != 0) {
+            errors++;
+        }
+        n++;
+    }
+    pthread_join(writer, NULL);
+
+    TEST_CHECK(errors == 0 && writeErrors == 0);
+    TEST_CHECK(Ifx_SpscFifo_isEmpty(fifo));
+    TEST_CHECK(fifo->writer.B.total == (RECORDS / 2) * setup->elementSize);
+    TEST_CHECK(fifo->writer.B.maxcount <= setup->size);
+    printf("%2u B records in %4u B: %u records over the wrap, %u wrong, max fill %u B, reader waited %u times\n",
+           setup->elementSize, setup->size, RECORDS, errors, fifo->writer.B.maxcount, yields);
+}
+
+/* One thread: Full, empty and incomplete elements */
+static void _TestLimits(void)
+{
+    uint8 data[128];
+    uint8 out[128];
+
+    for (int i = 0; i < (int)sizeof(data); i++) {
+        data[i] = (uint8)i;
+    }
+
+    fifo = Ifx_SpscFifo_init(memory, 64, 8);
+    TEST_CHECK(Ifx_SpscFifo_read(fifo, out, 8, TIME_NULL) == 8);
+    TEST_CHECK(Ifx_SpscFifo_write(fifo, data, 7, TIME_NULL) == 7);          /* Less than one element */
+    TEST_CHECK(Ifx_SpscFifo_write(fifo, data, 70, TIME_NULL) == 70 - 64);   /* Full after 8 elements */
+    TEST_CHECK(Ifx_SpscFifo_writeCount(fifo) == 0 && Ifx_SpscFifo_readCount(fifo) == 64);
+    TEST_CHECK(Ifx_SpscFifo_read(fifo, out, 20, TIME_NULL) == 4);
+    TEST_CHECK(memcmp(out, data, 16) == 0);
+    TEST_CHECK(Ifx_SpscFifo_write(fifo, &data[64], 16, TIME_NULL) == 0);    /* Over the end of the buffer */
+    TEST_CHECK(Ifx_SpscFifo_read(fifo, out, 64, TIME_NULL) == 0);
+    TEST_CHECK(memcmp(out, &data[16], 64) == 0);
+    TEST_CHECK(Ifx_SpscFifo_isEmpty(fifo));
+}
+
+int main(void)
+{
+    _TestLimits();
+    for (int i = 0; i < 3; i++) {
+        _Stress(&setups[i]);
+    }
+
+    return Host_report("Test_SpscFifo");
+}
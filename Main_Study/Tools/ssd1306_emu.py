@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+"""Replay a captured I2C write stream on an SSD1306 controller model and write the panel as PBM.
+
+    python3 ssd1306_emu.py capture.txt --out frames
+    python3 ssd1306_emu.py capture.txt --expect logo.pbm
+
+Capture: one transaction per line, hex bytes, 7 bit slave address first:
+    3D 00 21 00 7F 22 00 07
+    3D 40 FF 81 81 FF ...
+or the annotations of sigrok-cli -P i2c (Start / Address write: 3D / Data write: 00 / Stop).
+Markers between transactions:
+    # frame      write the panel of every device (--out)
+    # tick N     N scroll steps of an active scroll
+Control bytes (Co, D/C#), the three addressing modes, scroll, start line, offset and remap are modelled.
+"""
+import argparse
+import os
+import re
+import sys
+
+from ssd1306_image import read_pbm
+
+PAGES = 8
+COLUMNS = 128
+
+# Parameter bytes after the command byte
+PARAMS = {
+    0x20: 1, 0x21: 2, 0x22: 2, 0x26: 6, 0x27: 6, 0x29: 5, 0x2A: 5, 0x81: 1, 0x8D: 1,
+    0xA3: 2, 0xA8: 1, 0xD3: 1, 0xD5: 1, 0xD9: 1, 0xDA: 1, 0xDB: 1,
+}
+
+
+class Ssd1306:
+    def __init__(self):
+        self.ram = [[0] * COLUMNS for _ in range(PAGES)]
+        self.mode = 2                       # Page addressing after reset
+        self.col_start, self.col_end = 0, COLUMNS - 1
+        self.page_start, self.page_end = 0, PAGES - 1
+        self.col, self.page = 0, 0
+        self.start_line = 0
+        self.offset = 0
+        self.mux = 63
+        self.seg_remap = False
+        self.com_remap = False
+        self.inverse = False
+        self.entire_on = False
+        self.display_on = False
+        self.scroll = None                  # (command, parameters) of the last scroll setup
+        self.scroll_active = False
+        self.v_area = (0, 64)
+        self.cmd = []
+        self.stats = {'transactions': 0, 'bytes': 0, 'command': 0, 'data': 0}
+
+    # I2C transaction after the slave address (Figure 8-7)
+    def write(self, payload):
+        self.stats['transactions'] += 1
+        self.stats['bytes'] += len(payload) + 1
+        i = 0
+        while i < len(payload):
+            control = payload[i]
+            i += 1
+            is_data = bool(control & 0x40)
+            if control & 0x80:              # Co = 1: one byte, then the next control byte
+                if i < len(payload):
+                    self._byte(payload[i], is_data)
+                    i += 1
+                continue
+            for b in payload[i:]:           # Co = 0: the rest is a stream
+                self._byte(b, is_data)
+            break
+
+    def _byte(self, b, is_data):
+        if is_data:
+            self.stats['data'] += 1
+            self._data(b)
+            return
+        self.stats['command'] += 1
+        self.cmd.append(b)
+        if len(self.cmd) > PARAMS.get(self.cmd[0], 0):
+            self._command(self.cmd[0], self.cmd[1:])
+            self.cmd = []
+
+    def _data(self, b):
+        self.ram[self.page][self.col] = b
+        if self.mode == 0:
+            self.col += 1
+            if self.col > self.col_end:
+                self.col = self.col_start
+                self.page = self.page + 1 if self.page < self.page_end else self.page_start
+        elif self.mode == 1:
+            self.page += 1
+            if self.page > self.page_end:
+                self.page = self.page_start
+                self.col = self.col + 1 if self.col < self.col_end else self.col_start
+        else:
+            self.col = (self.col + 1) % COLUMNS
+
+    def _command(self, c, p):
+        if c <= 0x0F:
+            self.col = (self.col & 0xF0) | c
+        elif c <= 0x1F:
+            self.col = (self.col & 0x0F) | ((c & 0x07) << 4)
+        elif c == 0x20:
+            self.mode = p[0] & 0x03
+        elif c == 0x21:
+            self.col_start, self.col_end = p[0] & 0x7F, p[1] & 0x7F
+            self.col = self.col_start
+        elif c == 0x22:
+            self.page_start, self.page_end = p[0] & 0x07, p[1] & 0x07
+            self.page = self.page_start
+        elif c in (0x26, 0x27, 0x29, 0x2A):
+            self.scroll = (c, p)
+        elif c == 0x2E:
+            self.scroll_active = False
+        elif c == 0x2F:
+            self.scroll_active = self.scroll is not None
+        elif 0x40 <= c <= 0x7F:
+            self.start_line = c & 0x3F
+        elif c in (0xA0, 0xA1):
+            self.seg_remap = c == 0xA1
+        elif c == 0xA3:
+            self.v_area = (p[0] & 0x3F, p[1] & 0x7F)
+        elif c in (0xA4, 0xA5):
+            self.entire_on = c == 0xA5
+        elif c in (0xA6, 0xA7):
+            self.inverse = c == 0xA7
+        elif c == 0xA8:
+            self.mux = max(p[0] & 0x3F, 15)
+        elif c in (0xAE, 0xAF):
+            self.display_on = c == 0xAF
+        elif 0xB0 <= c <= 0xB7:
+            self.page = c & 0x07
+        elif c in (0xC0, 0xC8):
+            self.com_remap = c == 0xC8
+        elif c == 0xD3:
+            self.offset = p[0] & 0x3F
+
+    def tick(self, steps):
+        """Scroll steps as the controller does them: GDDRAM columns rotate, vertical offset moves the start line"""
+        if not self.scroll_active:
+            return
+        c, p = self.scroll
+        start, end = p[1] & 0x07, p[3] & 0x07
+        left = c in (0x27, 0x2A)
+        for _ in range(steps):
+            for page in range(start, end + 1):
+                row = self.ram[page]
+                self.ram[page] = row[1:] + row[:1] if left else row[-1:] + row[:-1]
+            if c in (0x29, 0x2A):
+                fixed, rows = self.v_area
+                self.start_line = fixed + (self.start_line - fixed + (p[4] & 0x3F)) % max(rows, 1)
+
+    def pixel(self, x, y):
+        """Pixel x, y of the panel as it is mounted for the A1 / C8 init"""
+        if not self.display_on:
+            return 0
+        if self.entire_on:
+            return 1
+        com = y if self.com_remap else self.mux - y
+        row = (com + self.start_line + self.offset) % 64
+        col = x if self.seg_remap else COLUMNS - 1 - x
+        value = (self.ram[row // 8][col] >> (row % 8)) & 1
+        return value ^ self.inverse
+
+    def image(self):
+        return [[self.pixel(x, y) for x in range(COLUMNS)] for y in range(self.mux + 1)]
+
+
+def write_pbm(path, pixels):
+    height, width = len(pixels), len(pixels[0])
+    with open(path, 'wb') as f:
+        f.write(b'P4\n%d %d\n' % (width, height))
+        for row in pixels:
+            packed = bytearray((width + 7) // 8)
+            for x, value in enumerate(row):
+                if value:
+                    packed[x // 8] |= 0x80 >> (x % 8)
+            f.write(packed)
+
+
+def read_capture(path):
+    """Transactions (address, payload) and markers ('frame' / 'tick', n) in the order of the capture"""
+    events = []
+    current = None
+    sigrok = re.compile(r'(Start|Stop|Address write|Data write)(?::\s*([0-9A-Fa-f]{2}))?')
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith('#'):
+                words = line[1:].split()
+                if words and words[0] == 'frame':
+                    events.append(('frame', 0))
+                elif words and words[0] == 'tick':
+                    events.append(('tick', int(words[1]) if len(words) > 1 else 1))
+                continue
+            m = sigrok.search(line)
+            if m:
+                kind, value = m.group(1), m.group(2)
+                if kind == 'Start' and current:
+                    events.append(('write', current))  # Repeated start
+                if kind in ('Start', 'Stop'):
+                    if kind == 'Stop' and current:
+                        events.append(('write', current))
+                    current = None
+                elif kind == 'Address write':
+                    current = [int(value, 16)]
+                elif current is not None:
+                    current.append(int(value, 16))
+                continue
+            data = [int(b, 16) for b in line.replace(',', ' ').split()]
+            if data:
+                events.append(('write', data))
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('capture')
+    parser.add_argument('--out', help='Directory for the PBM frames (<address>_<n>.pbm)')
+    parser.add_argument('--expect', help='PBM the last frame of the device must match bit for bit')
+    parser.add_argument('--addr', type=lambda s: int(s, 16), help='Device for --expect, default: the only one')
+    args = parser.parse_args()
+
+    devices = {}
+    frames = 0
+
+    def dump():
+        if args.out:
+            os.makedirs(args.out, exist_ok=True)
+            for addr, dev in devices.items():
+                write_pbm(os.path.join(args.out, '%02X_%04d.pbm' % (addr, frames)), dev.image())
+
+    for kind, value in read_capture(args.capture):
+        if kind == 'write':
+            devices.setdefault(value[0], Ssd1306()).write(value[1:])
+        elif kind == 'tick':
+            for dev in devices.values():
+                dev.tick(value)
+        else:
+            dump()
+            frames += 1
+    dump()
+    frames += 1
+
+    for addr, dev in sorted(devices.items()):
+        s = dev.stats
+        print('0x%02X: %d transactions, %d bytes (%d command, %d data), %.2f ms at 1 MHz'
+              % (addr, s['transactions'], s['bytes'], s['command'], s['data'], s['bytes'] * 9 / 1000.0))
+
+    if args.expect:
+        if args.addr is None and len(devices) != 1:
+            sys.exit('--addr is needed with %d devices' % len(devices))
+        dev = devices.get(args.addr if args.addr is not None else next(iter(devices)))
+        width, height, pixels = read_pbm(args.expect)
+        got = dev.image() if dev else []
+        if (width, height) != (COLUMNS, len(got)) or pixels != got:
+            diff = sum(a != b for r1, r2 in zip(pixels, got) for a, b in zip(r1, r2))
+            sys.exit('%s: %d pixels differ' % (args.expect, diff))
+        print('%s: bit exact' % args.expect)
+
+
+if __name__ == '__main__':
+    main()
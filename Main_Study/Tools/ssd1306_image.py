@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""Convert a 1bpp PBM image into a PackBits compressed SSD1306_Image (GDDRAM layout).
+
+    python3 ssd1306_image.py logo.pbm logo > logo.inc
+
+Columns are split into pages of 8 rows, top row in bit 0, page after page.
+PBM: 1 = black. By default black pixels are lit, --invert lights the white ones.
+"""
+import argparse
+import sys
+
+
+def read_pbm(path):
+    with open(path, 'rb') as f:
+        raw = f.read()
+
+    # Header: magic, width, height, comments start with '#'
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        while raw[pos:pos + 1].isspace():
+            pos += 1
+        if raw[pos:pos + 1] == b'#':
+            while raw[pos:pos + 1] not in (b'\n', b''):
+                pos += 1
+            continue
+        start = pos
+        while not raw[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(raw[start:pos].decode())
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+
+    if magic == 'P4':
+        pos += 1
+        stride = (width + 7) // 8
+        pixels = [[(raw[pos + y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)] for y in range(height)]
+    elif magic == 'P1':
+        bits = [c for c in raw[pos:].decode().split('#')[0] if c in '01']
+        pixels = [[int(bits[y * width + x]) for x in range(width)] for y in range(height)]
+    else:
+        sys.exit('%s: only PBM (P1 / P4) is supported' % path)
+
+    return width, height, pixels
+
+
+def to_pages(width, height, pixels, invert):
+    pages = (height + 7) // 8
+    out = []
+    for page in range(pages):
+        for x in range(width):
+            value = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and (pixels[y][x] ^ invert):
+                    value |= 1 << bit
+            out.append(value)
+    return pages, out
+
+
+def packbits(data):
+    """Header n: 0 ~ 127 -> n + 1 literal bytes, -1 ~ -127 -> next byte 1 - n times"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            out += bytes([(257 - run) & 0xFF, data[i]])
+            i += run
+            continue
+
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 1 < len(data) and data[i + 1] == data[i]:
+                break
+            i += 1
+        out.append(i - start - 1)
+        out += bytes(data[start:i])
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('pbm')
+    parser.add_argument('name', help='C identifier of the image')
+    parser.add_argument('--invert', action='store_true')
+    args = parser.parse_args()
+
+    width, height, pixels = read_pbm(args.pbm)
+    if width > 128 or height > 64:
+        sys.exit('%s: %dx%d is larger than the panel' % (args.pbm, width, height))
+
+    pages, raw = to_pages(width, height, pixels, 1 if args.invert else 0)
+    packed = packbits(raw)
+
+    print('/* %s: %dx%d, %d -> %d bytes */' % (args.pbm, width, height, len(raw), len(packed)))
+    print('static const uint8 %sData[] = {' % args.name)
+    for i in range(0, len(packed), 16):
+        print('    ' + ', '.join('0x%02X' % b for b in packed[i:i + 16]) + ',')
+    print('};')
+    print('static const SSD1306_Image %s = {' % args.name)
+    print('    .data = %sData,' % args.name)
+    print('    .size = sizeof(%sData),' % args.name)
+    print('    .pageLen = %d,' % pages)
+    print('    .columnLen = %d' % width)
+    print('};')
+
+
+if __name__ == '__main__':
+    main()